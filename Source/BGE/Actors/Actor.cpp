@@ -1,46 +1,104 @@
 #include "Engine/EngineStd.hpp"
 #include "Actors/Actor.hpp"
 #include "Actors/ActorComponent.hpp"
+#include "Actors/ActorQuery.hpp"
 
 BGE::Actor::Actor(ActorID aID)
+	: m_ID(aID),
+	  m_type("Unknown"),
+	  m_resourceFilename(),
+	  m_pArchetype(nullptr),
+	  m_pQueries(nullptr)
 {
 }
 
 BGE::Actor::~Actor(void)
 {
+	if (m_pQueries)
+		m_pQueries->RemoveActor(*this);
 }
 
 bool BGE::Actor::Init(tinyxml2::XMLElement *pData)
 {
-	return false;
+	if (!pData)
+		return false;
+	// Optional attributes describing the actor
+	const char *pType = pData->Attribute("type");
+	const char *pResource = pData->Attribute("resource");
+	if (pType) m_type = pType;
+	if (pResource) m_resourceFilename = pResource;
+	return true;
 }
 
 void BGE::Actor::PostInit(void)
 {
-	for (auto &[key, value] : m_components)
+	for (const auto &pComponent : m_components.GetValues())
 	{
-
+		pComponent->VPostInit();
 	}
 }
 
 void BGE::Actor::Destroy(void)
 {
+	if (m_pQueries)
+		m_pQueries->RemoveActor(*this);
 	m_components.clear();
 }
 
 void BGE::Actor::Update(float deltaTime)
 {
-	for (auto &[key, value] : m_components)
+	for (const auto &pComponent : m_components.GetValues())
 	{
+		// Pooled components are updated in bulk by their ComponentStore
+		if (!pComponent->IsPooled())
+			pComponent->VUpdate(deltaTime);
+	}
+}
 
+void BGE::Actor::DispatchChanges(void)
+{
+	for (const auto &pComponent : m_components.GetValues())
+	{
+		if (!pComponent->IsPooled())
+			pComponent->DispatchChange();
 	}
 }
 
 std::string BGE::Actor::ToXML(void)
 {
-	return std::string();
+	tinyxml2::XMLDocument doc;
+	tinyxml2::XMLElement *pActorElem = doc.NewElement("Actor");
+	pActorElem->SetAttribute("type", m_type.c_str());
+	pActorElem->SetAttribute("resource", m_resourceFilename.c_str());
+	doc.InsertEndChild(pActorElem);
+	for (const auto &pComponent : m_components.GetValues())
+	{
+		if (tinyxml2::XMLElement *pComponentElem = pComponent->VGenerateXML(doc))
+			pActorElem->InsertEndChild(pComponentElem);
+	}
+
+	tinyxml2::XMLPrinter printer;
+	doc.Accept(&printer);
+	return std::string(printer.CStr());
 }
 
 void BGE::Actor::AddComponent(StrongActorComponentPtr pComponent)
 {
+	// Only one component of each type is allowed per actor
+	const auto [kIter, kInserted] = m_components.emplace(pComponent->VGetID(), std::move(pComponent));
+	BGE_ASSERT(kInserted);
+	if (m_pQueries)
+		m_pQueries->OnComponentsChanged(*this);
+}
+
+void BGE::Actor::RemoveComponent(ActorComponentID cID)
+{
+	StrongActorComponentPtr *ppComponent = m_components.FindValue(cID);
+	if (!ppComponent)
+		return;
+	// Break the component's reference back to this actor before dropping it
+	(*ppComponent)->m_pOwner.reset();
+	m_components.erase(cID);
+	if (m_pQueries)
+		m_pQueries->OnComponentsChanged(*this);
 }
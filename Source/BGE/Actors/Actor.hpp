@@ -1,21 +1,31 @@
 #ifndef _BGE_ACTOR_HPP_
 #define _BGE_ACTOR_HPP_
 
+#include "Actors/ActorComponent.hpp"
+
+#include <unordered_map>
+
 namespace BGE
 {
+	class ActorArchetype;
+	class ActorQueryRegistry;
 	/**
 	 *
 	 */
 	class Actor
 	{
 		friend class ActorFactory;
+		friend class ActorQueryRegistry;
 	public:
-		using ActorComponentMap = std::map<ActorComponentID, StrongActorComponentPtr>;
+		// Most actors have a handful of components; those stay inline in the actor.
+		using ActorComponentMap = FlatMap<ActorComponentID, StrongActorComponentPtr, 8>;
 	private:
 		ActorID m_ID; // Unique ID for this actor
 		ActorComponentMap m_components; // All components of this actor
 		ActorType m_type; // Name of this actor
 		std::string m_resourceFilename; // name of XML init file
+		const ActorArchetype *m_pArchetype; // Set when cloned by an ActorFactory, which may recycle it
+		ActorQueryRegistry *m_pQueries; // Set while tracked by a registry's queries
 	public:
 		explicit Actor(ActorID aID);
 		~Actor(void);
@@ -24,49 +34,56 @@ namespace BGE
 		void PostInit(void);
 		void Destroy(void);
 		void Update(float deltaTime);
+		// Run VOnChanged() on unpooled components with a pending change; ComponentStore
+		// dispatches pooled ones.
+		void DispatchChanges(void);
 		// Editor methods:
 		std::string ToXML(void);
 		// Accessors:
 		ActorID GetID(void) const noexcept { return m_ID; }
 		ActorType GetType(void) const noexcept { return m_type; }
+		const std::string &GetResourceFilename(void) const noexcept { return m_resourceFilename; }
+		const ActorArchetype *GetArchetype(void) const noexcept { return m_pArchetype; }
 		// Template methods for accessing components:
 		template <typename ActorComponentType>
 		std::weak_ptr<ActorComponentType> GetComponentPtr(ActorComponentID cID)
 		{
-			auto findIter = m_components.find(cID);
-			if (findIter != m_components.end())
-			{
-				StrongActorComponentPtr pBase(findIter->second);
-				// Cast to subclass version of the pointer
-				std::shared_ptr<ActorComponentType> pSub(std::static_pointer_cast<ActorComponentType>(pBase));
-				// Convert strong pointer to weak pointer
-				std::weak_ptr<ActorComponentType> pWeakSub(pSub);
-				return pWeakSub; // Return the weak pointer
-			}
-			else
+			const StrongActorComponentPtr *ppComponent = m_components.FindValue(cID);
+			if (!ppComponent)
 				return std::weak_ptr<ActorComponentType>(); // No component found
+			// Cast to subclass version of the pointer
+			return std::static_pointer_cast<ActorComponentType>(*ppComponent);
+		}
+		// Resolved with the component's compile time ID; no string work.
+		template <IdentifiedComponent ActorComponentType>
+		std::weak_ptr<ActorComponentType> GetComponent(void)
+		{
+			return GetComponentPtr<ActorComponentType>(ActorComponentType::kID);
 		}
-		
+		// Non-owning lookup for hot loops; skips the weak_ptr reference count traffic.
+		template <IdentifiedComponent ActorComponentType>
+		ActorComponentType *FindComponent(void) const
+		{
+			const StrongActorComponentPtr *ppComponent = m_components.FindValue(ActorComponentType::kID);
+			return ppComponent ? static_cast<ActorComponentType *>(ppComponent->get()) : nullptr;
+		}
+		// Hashes COMPONENTNAME on every call; prefer GetComponent<T>() where the type is known.
 		template <typename ActorComponentType>
 		std::weak_ptr<ActorComponentType> GetComponent(std::string_view componentName)
 		{
-			ActorComponentID aID = ActorComponent::GetIDFromName(componentName);
-			auto findIter = m_components.find(aID);
-			if (findIter != m_components.end())
-			{
-				StrongActorComponentPtr pBase(findIter->second);
-				// Cast to subclass version of the pointer
-				std::shared_ptr<ActorComponentType> pSub(std::static_pointer_cast<ActorComponentType>(pBase));
-				// Convert strong pointer to weak pointer
-				std::weak_ptr<ActorComponentType> pWeakSub(pSub);
-				return pWeakSub; // Return the weak pointer
-			}
-			else
-				return std::weak_ptr<ActorComponentType>(); // No component found
+			const ActorComponentID kID = ActorComponent::GetIDFromName(componentName);
+#if BGE_COMPONENT_ID_REGISTRY_ENABLED
+			RegisterComponentID(kID, componentName);
+#endif
+			return GetComponentPtr<ActorComponentType>(kID);
 		}
 		const ActorComponentMap &GetComponents(void) const { return m_components; }
+		// Adding or removing components updates the queries tracking this actor.
 		void AddComponent(StrongActorComponentPtr pComponent);
+		void RemoveComponent(ActorComponentID cID);
 	};
+	// Live actors by ID
+	using ActorMap = std::unordered_map<ActorID, StrongActorPtr>;
 } // End namespace (BGE)
 
 #endif /* !_BGE_ACTOR_HPP_ */
@@ -0,0 +1,163 @@
+/*=============================================================================*
+ * ActorArchetype.cpp - Compiled binary actor definitions.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "ActorArchetype.hpp"
+#include "Actors/Actor.hpp"
+
+void BGE::BlobWriter::WriteBytes(const void *pData, std::size_t size)
+{
+	const auto *pBytes = static_cast<const std::byte *>(pData);
+	m_buffer.insert(m_buffer.end(), pBytes, pBytes + size);
+}
+
+void BGE::BlobWriter::WriteString(std::string_view str)
+{
+	Write(static_cast<std::uint32_t>(str.size()));
+	WriteBytes(str.data(), str.size());
+}
+
+bool BGE::BlobReader::ReadBytes(void *pData, std::size_t size)
+{
+	if (size > GetRemaining())
+		return false;
+
+	std::memcpy(pData, m_data.data() + m_offset, size);
+	m_offset += size;
+	return true;
+}
+
+bool BGE::BlobReader::Skip(std::size_t size)
+{
+	if (size > GetRemaining())
+		return false;
+
+	m_offset += size;
+	return true;
+}
+
+bool BGE::BlobReader::ReadString(std::string &str)
+{
+	std::uint32_t length = 0;
+	if (!Read(length) || length > GetRemaining())
+		return false;
+
+	str.assign(reinterpret_cast<const char *>(m_data.data() + m_offset), length);
+	m_offset += length;
+	return true;
+}
+
+bool BGE::BlobReader::ReadSpan(std::size_t size, std::span<const std::byte> &span)
+{
+	if (size > GetRemaining())
+		return false;
+
+	span = m_data.subspan(m_offset, size);
+	m_offset += size;
+	return true;
+}
+
+bool BGE::BlobReader::ReadStringView(std::string_view &str)
+{
+	std::uint32_t length = 0;
+	std::span<const std::byte> chars;
+	if (!Read(length) || !ReadSpan(length, chars))
+		return false;
+
+	str = std::string_view(reinterpret_cast<const char *>(chars.data()), chars.size());
+	return true;
+}
+
+bool BGE::ActorArchetype::Compile(const Actor &prototype)
+{
+	std::vector<std::byte> blob;
+	BlobWriter writer(blob);
+	const auto &kComponents = prototype.GetComponents();
+	writer.Write(kMAGIC);
+	writer.Write(kVERSION);
+	writer.Write(static_cast<std::uint16_t>(kComponents.size()));
+	writer.WriteString(prototype.GetType());
+	writer.WriteString(prototype.GetResourceFilename());
+
+	for (const auto &[kID, pComponent] : kComponents)
+	{
+		writer.Write(kID);
+		// Reserve the size field and patch it once the component has written itself
+		const std::size_t kSizeOffset = writer.GetSize();
+		writer.Write(std::uint32_t(0));
+		if (!pComponent->VWriteBlob(writer))
+		{
+			BGE_WARNING("Component %s of actor %s has no blob support", pComponent->VGetName().c_str(),
+						prototype.GetType().c_str());
+			return false;
+		}
+
+		writer.WriteAt(kSizeOffset, static_cast<std::uint32_t>(writer.GetSize() - kSizeOffset - sizeof(std::uint32_t)));
+	}
+	return Load(blob);
+}
+
+bool BGE::ActorArchetype::Load(std::span<const std::byte> blob)
+{
+	Reset();
+	BlobReader reader(blob);
+	std::uint32_t magic = 0;
+	std::uint16_t version = 0;
+	std::uint16_t numComponents = 0;
+	if (!reader.Read(magic) || magic != kMAGIC || !reader.Read(version) || version != kVERSION)
+		return false;
+	if (!reader.Read(numComponents) || !reader.ReadString(m_type) || !reader.ReadString(m_resourceFilename))
+	{
+		Reset();
+		return false;
+	}
+
+	m_components.reserve(numComponents);
+	for (std::uint16_t index = 0; index < numComponents; ++index)
+	{
+		ComponentRecord record{};
+		if (!reader.Read(record.cID) || !reader.Read(record.size) || record.size > reader.GetRemaining())
+		{
+			Reset();
+			return false;
+		}
+
+		record.offset = static_cast<std::uint32_t>(blob.size() - reader.GetRemaining());
+		reader.Skip(record.size);
+		m_components.push_back(record);
+	}
+	m_blob.assign(blob.begin(), blob.end());
+	return true;
+}
+
+void BGE::ActorArchetype::Reset(void)
+{
+	m_blob.clear();
+	m_components.clear();
+	m_type.clear();
+	m_resourceFilename.clear();
+}
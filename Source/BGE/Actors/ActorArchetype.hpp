@@ -0,0 +1,126 @@
+/*=============================================================================*
+ * ActorArchetype.hpp - Compiled binary actor definitions.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_ACTORARCHETYPE_HPP_
+#define _BGE_ACTORARCHETYPE_HPP_
+
+namespace BGE
+{
+	/**
+	 * Appends raw values to a byte buffer. Values are written in host byte order with
+	 * no padding, so a trivially copyable struct goes out as a single memcpy.
+	 */
+	class BlobWriter
+	{
+		std::vector<std::byte> &m_buffer;
+	public:
+		explicit BlobWriter(std::vector<std::byte> &buffer) : m_buffer(buffer) { }
+
+		void WriteBytes(const void *pData, std::size_t size);
+		template <typename Type> requires(std::is_trivially_copyable_v<Type>)
+		void Write(const Type &value) { WriteBytes(&value, sizeof(Type)); }
+		// 32-bit length followed by the characters.
+		void WriteString(std::string_view str);
+		// Overwrite a value written earlier at OFFSET, e.g. a size that was not known yet.
+		template <typename Type> requires(std::is_trivially_copyable_v<Type>)
+		void WriteAt(std::size_t offset, const Type &value)
+		{
+			BGE_ASSERT(offset + sizeof(Type) <= m_buffer.size());
+			std::memcpy(m_buffer.data() + offset, &value, sizeof(Type));
+		}
+		std::size_t GetSize(void) const noexcept { return m_buffer.size(); }
+	};
+	/**
+	 * Reads values written by BlobWriter. Every read is bounds checked and returns
+	 * false once the data runs out.
+	 */
+	class BlobReader
+	{
+		std::span<const std::byte> m_data;
+		std::size_t m_offset;
+	public:
+		explicit BlobReader(std::span<const std::byte> data) : m_data(data), m_offset(0) { }
+
+		bool ReadBytes(void *pData, std::size_t size);
+		template <typename Type> requires(std::is_trivially_copyable_v<Type>)
+		bool Read(Type &value) { return ReadBytes(&value, sizeof(Type)); }
+		bool ReadString(std::string &str);
+		// Borrow the next SIZE bytes without copying; they live as long as the data.
+		bool ReadSpan(std::size_t size, std::span<const std::byte> &span);
+		// Same, for a string written by BlobWriter::WriteString().
+		bool ReadStringView(std::string_view &str);
+		bool Skip(std::size_t size);
+		std::size_t GetRemaining(void) const noexcept { return m_data.size() - m_offset; }
+		bool IsAtEnd(void) const noexcept { return m_offset == m_data.size(); }
+	};
+	/**
+	 * ActorArchetype is an actor definition compiled to a compact binary blob: the
+	 * actor's type and resource name, then one record per component holding the
+	 * component ID and the bytes written by ActorComponent::VWriteBlob().
+	 *
+	 * The blob has no pointers, so it can be written out by a build step and handed
+	 * back to Load() as is.
+	 */
+	class ActorArchetype
+	{
+	public:
+		static constexpr std::uint32_t kMAGIC = 0x41454742; // "BGEA"
+		static constexpr std::uint16_t kVERSION = 1;
+		// Where one component's data lives in the blob
+		struct ComponentRecord
+		{
+			ActorComponentID cID;
+			std::uint32_t offset;
+			std::uint32_t size;
+		};
+	private:
+		std::vector<std::byte> m_blob;
+		std::vector<ComponentRecord> m_components; // Index into m_blob, in blob order
+		ActorType m_type;
+		std::string m_resourceFilename;
+	public:
+		ActorArchetype(void) = default;
+
+		// Serialize PROTOTYPE; false if one of its components cannot be written to a blob.
+		bool Compile(const Actor &prototype);
+		// Adopt a blob produced by Compile(); false if it is malformed or from another version.
+		bool Load(std::span<const std::byte> blob);
+		bool IsValid(void) const noexcept { return !m_blob.empty(); }
+		std::span<const std::byte> GetBlob(void) const { return m_blob; }
+		const ActorType &GetType(void) const noexcept { return m_type; }
+		const std::string &GetResourceFilename(void) const noexcept { return m_resourceFilename; }
+		std::span<const ComponentRecord> GetComponents(void) const { return m_components; }
+		std::span<const std::byte> GetComponentData(const ComponentRecord &record) const
+		{
+			return std::span<const std::byte>(m_blob).subspan(record.offset, record.size);
+		}
+	private:
+		void Reset(void);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_ACTORARCHETYPE_HPP_ */
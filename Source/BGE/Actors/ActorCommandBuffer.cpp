@@ -0,0 +1,131 @@
+/*=============================================================================*
+ * ActorCommandBuffer.cpp - Deferred actor spawns and despawns.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "ActorCommandBuffer.hpp"
+
+BGE::ActorCommandBuffer::ActorCommandBuffer(ActorFactory &factory, ActorQueryRegistry *pQueries)
+	: m_factory(factory),
+	  m_pQueries(pQueries),
+	  m_numQueuedSpawns(0)
+{
+}
+
+BGE::ActorID BGE::ActorCommandBuffer::Spawn(const ActorArchetype &archetype, std::size_t count,
+											std::span<const Math::Mat4x4f> transforms)
+{
+	BGE_ASSERT(transforms.empty() || transforms.size() == count);
+	if (count == 0)
+		return kINVALID_ACTOR_ID;
+
+	const ActorID kFirstID = m_factory.ReserveActorIDs(count);
+	Command command{};
+	command.type = CommandType::Spawn;
+	command.pArchetype = &archetype;
+	command.firstID = kFirstID;
+	command.first = static_cast<std::uint32_t>(m_transforms.size());
+	command.count = static_cast<std::uint32_t>(count);
+	command.hasTransforms = !transforms.empty();
+	m_transforms.insert(m_transforms.end(), transforms.begin(), transforms.end());
+	m_commands.push_back(command);
+	m_numQueuedSpawns += count;
+	return kFirstID;
+}
+
+void BGE::ActorCommandBuffer::Despawn(std::span<const ActorID> actorIDs)
+{
+	if (actorIDs.empty())
+		return;
+	// Back to back despawns share one command
+	if (m_commands.empty() || m_commands.back().type != CommandType::Despawn)
+	{
+		Command command{};
+		command.type = CommandType::Despawn;
+		command.first = static_cast<std::uint32_t>(m_despawnIDs.size());
+		m_commands.push_back(command);
+	}
+	m_despawnIDs.insert(m_despawnIDs.end(), actorIDs.begin(), actorIDs.end());
+	m_commands.back().count += static_cast<std::uint32_t>(actorIDs.size());
+}
+
+void BGE::ActorCommandBuffer::Clear(void)
+{
+	m_commands.clear();
+	m_transforms.clear();
+	m_despawnIDs.clear();
+	m_numQueuedSpawns = 0;
+}
+
+void BGE::ActorCommandBuffer::Flush(ActorMap &actors)
+{
+	if (m_commands.empty())
+		return;
+	// Grow the map once for the whole batch
+	actors.reserve(actors.size() + m_numQueuedSpawns);
+
+	for (const Command &kCommand : m_commands)
+	{
+		if (kCommand.type == CommandType::Spawn)
+		{
+			const auto kTransforms = kCommand.hasTransforms
+				? std::span<const Math::Mat4x4f>(m_transforms).subspan(kCommand.first, kCommand.count)
+				: std::span<const Math::Mat4x4f>();
+			m_factory.CreateActors(*kCommand.pArchetype, kCommand.firstID, kCommand.count, kTransforms, m_spawned);
+			for (auto &pActor : m_spawned)
+			{
+				// try_emplace leaves PACTOR alone when the ID is taken
+				const ActorID kID = pActor->GetID();
+				const auto [kIter, kIsInserted] = actors.try_emplace(kID, std::move(pActor));
+				if (!kIsInserted)
+				{
+					BGE_ERROR("Spawned actor %u collides with an existing actor; destroying it", kID);
+					pActor->Destroy(); // Break the component to owner cycle
+					continue;
+				}
+				if (m_pQueries)
+					m_pQueries->AddActor(*kIter->second);
+			}
+			m_spawned.clear();
+		}
+		else
+		{
+			for (const ActorID kID : std::span<const ActorID>(m_despawnIDs).subspan(kCommand.first, kCommand.count))
+			{
+				const auto kFindIter = actors.find(kID);
+				if (kFindIter == actors.end())
+					continue; // Already gone, or its spawn failed
+				m_factory.RecycleActor(std::move(kFindIter->second));
+				actors.erase(kFindIter);
+			}
+		}
+	}
+
+	m_commands.clear();
+	m_transforms.clear();
+	m_despawnIDs.clear();
+	m_numQueuedSpawns = 0;
+}
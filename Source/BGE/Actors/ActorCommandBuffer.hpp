@@ -0,0 +1,88 @@
+/*=============================================================================*
+ * ActorCommandBuffer.hpp - Deferred actor spawns and despawns.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_ACTORCOMMANDBUFFER_HPP_
+#define _BGE_ACTORCOMMANDBUFFER_HPP_
+
+#include "Actors/Actor.hpp"
+#include "Actors/ActorFactory.hpp"
+#include "Actors/ActorQuery.hpp"
+
+namespace BGE
+{
+	/**
+	 * ActorCommandBuffer queues spawns and despawns and applies them together at a
+	 * sync point (Flush()), so code iterating the actor map never sees it change.
+	 * Spawned actors get their IDs when queued, which lets the caller refer to them
+	 * before they exist. Commands are applied in the order they were queued.
+	 *
+	 * Not thread safe; queue from the thread that flushes.
+	 */
+	class ActorCommandBuffer : public INonCopyable
+	{
+		enum class CommandType : std::uint8_t
+		{
+			Spawn,
+			Despawn
+		};
+		struct Command
+		{
+			CommandType type;
+			const ActorArchetype *pArchetype; // Spawn only
+			ActorID firstID; // Spawn only; IDs run from here
+			std::uint32_t first; // Index into m_transforms (spawn) or m_despawnIDs (despawn)
+			std::uint32_t count;
+			bool hasTransforms;
+		};
+
+		ActorFactory &m_factory;
+		ActorQueryRegistry *m_pQueries; // Tracks spawned actors, if set
+		std::vector<Command> m_commands;
+		std::vector<Math::Mat4x4f> m_transforms;
+		std::vector<ActorID> m_despawnIDs;
+		std::vector<StrongActorPtr> m_spawned; // Scratch space, kept to reuse its capacity
+		std::size_t m_numQueuedSpawns;
+	public:
+		explicit ActorCommandBuffer(ActorFactory &factory, ActorQueryRegistry *pQueries = nullptr);
+
+		// Queue COUNT clones of ARCHETYPE, which must outlive the flush. TRANSFORMS is
+		// empty or holds one per actor. Returns the first of the COUNT consecutive IDs.
+		ActorID Spawn(const ActorArchetype &archetype, std::size_t count,
+					  std::span<const Math::Mat4x4f> transforms = {});
+		void Despawn(ActorID aID) { Despawn(std::span<const ActorID>(&aID, 1)); }
+		void Despawn(std::span<const ActorID> actorIDs);
+		// Apply every queued command to ACTORS. Spawned actors join the query registry;
+		// despawned actors leave it and are recycled by the factory.
+		void Flush(ActorMap &actors);
+		// Drop every queued command; the IDs reserved for spawns are not handed out again.
+		void Clear(void);
+		bool IsEmpty(void) const noexcept { return m_commands.empty(); }
+		std::size_t GetNumQueuedSpawns(void) const noexcept { return m_numQueuedSpawns; }
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_ACTORCOMMANDBUFFER_HPP_ */
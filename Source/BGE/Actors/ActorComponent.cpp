@@ -0,0 +1,109 @@
+/*=============================================================================*
+ * ActorComponent.cpp - Actor component ID registry.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "ActorComponent.hpp"
+#include "ComponentStore.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	struct ComponentIDRegistry
+	{
+		std::mutex mutex;
+		std::unordered_map<BGE::ActorComponentID, std::string> names;
+		std::vector<std::string> collisions; // Messages waiting for the logger
+	};
+	// Components register during static initialization, so construct on first use
+	ComponentIDRegistry &GetRegistry(void)
+	{
+		static ComponentIDRegistry s_registry;
+		return s_registry;
+	}
+	// Starts above 0 so that "changed since 0" covers every change
+	std::atomic<BGE::ChangeVersion> s_changeVersion{ 1 };
+	std::atomic<bool> s_hasUnpooledChanges{ false };
+} // End namespace
+
+void BGE::ActorComponent::MarkChanged(void)
+{
+	const ChangeVersion kVersion = s_changeVersion.load(std::memory_order_relaxed);
+	m_changeVersion = kVersion;
+	m_isChangePending = true;
+	if (m_pPool)
+		m_pPool->VMarkChanged(m_poolSlot, kVersion);
+	else
+		s_hasUnpooledChanges.store(true, std::memory_order_relaxed);
+}
+
+void BGE::ActorComponent::SetParked(bool isParked)
+{
+	if (isParked)
+		m_isChangePending = false;
+	if (m_pPool)
+		m_pPool->VSetParked(m_poolSlot, isParked);
+}
+
+BGE::ChangeVersion BGE::ActorComponent::GetCurrentVersion(void)
+{
+	return s_changeVersion.load(std::memory_order_relaxed);
+}
+
+BGE::ChangeVersion BGE::ActorComponent::AdvanceVersion(void)
+{
+	return s_changeVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+bool BGE::ActorComponent::ConsumeUnpooledChanges(void)
+{
+	return s_hasUnpooledChanges.exchange(false, std::memory_order_relaxed);
+}
+
+bool BGE::RegisterComponentID(ActorComponentID cID, std::string_view componentName)
+{
+	ComponentIDRegistry &registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	const auto [kIter, kInserted] = registry.names.try_emplace(cID, componentName);
+	if (kInserted || kIter->second == componentName)
+		return true;
+	// The logger may not exist yet, so keep the message for ValidateComponentIDs()
+	registry.collisions.push_back("\"" + std::string(componentName) + "\" and \"" + kIter->second +
+								  "\" share ID " + std::to_string(cID));
+	return false;
+}
+
+bool BGE::ValidateComponentIDs(void)
+{
+	ComponentIDRegistry &registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	for (const auto &kCollision : registry.collisions)
+		BGE_ERROR("Component ID collision: %s. Rename one of the components.", kCollision.c_str());
+	return registry.collisions.empty();
+}
@@ -1,13 +1,59 @@
 #ifndef _BGE_ACTORCOMPONENT_HPP_
 #define _BGE_ACTORCOMPONENT_HPP_
 
+#if defined(BGE_CONFIG_DEBUG) || defined(BGE_CONFIG_PROFILE)
+#define BGE_COMPONENT_ID_REGISTRY_ENABLED 1 // Record component IDs to catch hash collisions
+#else
+#define BGE_COMPONENT_ID_REGISTRY_ENABLED 0
+#endif
+
+#if BGE_COMPONENT_ID_REGISTRY_ENABLED
+#define BGE_REGISTER_COMPONENT_ID_() \
+	inline static const bool s_kIsIDRegistered = BGE::RegisterComponentID(kID, kNAME);
+#else
+#define BGE_REGISTER_COMPONENT_ID_()
+#endif
+// Place at the top of a component class. Gives it a compile time ID (kID) hashed from its
+// name (kNAME), implements VGetID() and VGetName(), and leaves the class in private access.
+#define BGE_ACTOR_COMPONENT(TYPE) \
+public: \
+	static constexpr std::string_view kNAME = #TYPE; \
+	static constexpr BGE::ActorComponentID kID = BGE::ActorComponent::GetIDFromName(kNAME); \
+	virtual BGE::ActorComponentID VGetID(void) const override { return kID; } \
+	virtual std::string VGetName(void) const override { return std::string(kNAME); } \
+private: \
+	BGE_REGISTER_COMPONENT_ID_()
+
 namespace BGE
 {
+	// Components declared with BGE_ACTOR_COMPONENT, usable with Actor::GetComponent<T>().
+	template <typename ComponentType>
+	concept IdentifiedComponent = requires
+	{
+		{ ComponentType::kID } -> std::convertible_to<ActorComponentID>;
+	};
+	// Record that NAME hashes to ID; false when another name already has it.
+	bool RegisterComponentID(ActorComponentID cID, std::string_view componentName);
+	// Log every collision recorded so far (call after Logger::Init). False if there were any.
+	bool ValidateComponentIDs(void);
+
+	class BlobWriter;
+	class BlobReader;
+	class IComponentPool;
+
 	class ActorComponent
 	{
+		friend class Actor;
 		friend class ActorFactory;
+		template <typename ComponentType>
+		friend class ComponentPool;
 	protected:
 		StrongActorPtr m_pOwner;
+	private:
+		IComponentPool *m_pPool = nullptr; // Set if it lives in a ComponentStore, which updates it
+		std::uint32_t m_poolSlot = 0;
+		ChangeVersion m_changeVersion = 0; // Version of the last MarkChanged(); 0 if never changed
+		bool m_isChangePending = false; // VOnChanged() not yet dispatched
 	public:
 		virtual ~ActorComponent(void) { m_pOwner.reset(); }
 
@@ -15,19 +61,63 @@ namespace BGE
 		virtual bool VInit(tinyxml2::XMLElement *pData) = 0;
 		virtual void VPostInit(void) { }
 		virtual void VUpdate(float deltaTime) { }
+		// Called at the sync point after MarkChanged(), once per frame however often it was marked.
 		virtual void VOnChanged(void) { }
-		// Editor methods:
-		virtual tinyxml2::XMLElement *VGenerateXML(void) = 0;
+		// Called when the owner is parked on an ActorFactory free list. Drop anything that
+		// makes it visible to the world; VPostInit() runs again when it is reused.
+		virtual void VOnRecycled(void) { }
+		// Editor methods. Build this component's element in DOC; the caller links it in.
+		virtual tinyxml2::XMLElement *VGenerateXML(tinyxml2::XMLDocument &doc) = 0;
+		// Archetype methods (see ActorArchetype). State that is a trivially copyable struct
+		// can be written and read back with one BlobWriter::Write()/BlobReader::Read().
+		// Components that return false are spawned from XML instead.
+		virtual bool VWriteBlob(BlobWriter &writer) const { return false; }
+		virtual bool VInitFromBlob(BlobReader &reader) { return false; }
 		// Accessors:
 		virtual ActorComponentID VGetID(void) const { return GetIDFromName(VGetName()); }
 		virtual std::string VGetName(void) const = 0;
-		static ActorComponentID GetIDFromName(std::string_view componentName)
+		bool IsPooled(void) const noexcept { return m_pPool != nullptr; }
+		// Record a change to this component's state: stamp it with the current version and
+		// queue VOnChanged(). Safe from parallel systems that own the component's type.
+		void MarkChanged(void);
+		bool IsChangePending(void) const noexcept { return m_isChangePending; }
+		ChangeVersion GetChangeVersion(void) const noexcept { return m_changeVersion; }
+		bool HasChangedSince(ChangeVersion version) const noexcept { return m_changeVersion > version; }
+		// The version MarkChanged() currently stamps. SystemScheduler advances it before
+		// each stage, so a system sees every change made since its previous run but its own.
+		static ChangeVersion GetCurrentVersion(void);
+		static ChangeVersion AdvanceVersion(void);
+		// True (once) if an unpooled component was marked since the last call.
+		static bool ConsumeUnpooledChanges(void);
+		// 32-bit FNV-1a of the name
+		static constexpr ActorComponentID GetIDFromName(std::string_view componentName)
 		{
-			return 0;
+			std::uint32_t hash = 2166136261u;
+			for (const char kChar : componentName)
+			{
+				hash ^= static_cast<std::uint8_t>(kChar);
+				hash *= 16777619u;
+			}
+			// The invalid ID must never name a component
+			return (hash == kINVALID_ACTOR_COMPONENT_ID) ? 1 : hash;
 		}
 	private:
 		void SetOwnerPtr(StrongActorPtr pOwner) { m_pOwner = pOwner; }
+		// Hide a pooled component from its pool's iteration while the owner is recycled.
+		void SetParked(bool isParked);
+		// Run VOnChanged() if a change is pending.
+		void DispatchChange(void)
+		{
+			if (!m_isChangePending)
+				return;
+			m_isChangePending = false;
+			VOnChanged();
+		}
 	};
+
+	// FNV-1a reference values
+	static_assert(ActorComponent::GetIDFromName("") == 2166136261u);
+	static_assert(ActorComponent::GetIDFromName("a") == 0xE40C292Cu);
 } // End namespace (BGE)
 
 #endif /* !_BGE_ACTORCOMPONENT_HPP_ */
\ No newline at end of file
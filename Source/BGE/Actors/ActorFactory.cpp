@@ -1,13 +1,324 @@
 #include "Engine/EngineStd.hpp"
 #include "ActorFactory.hpp"
 #include "ActorComponent.hpp"
+#include "Actor.hpp"
+#include "ActorQuery.hpp"
+#include "TransformComponent.hpp"
 
 BGE::ActorFactory::ActorFactory(void)
 	: m_lastActorID(kINVALID_ACTOR_ID)
 {
 }
 
+BGE::ActorFactory::~ActorFactory(void)
+{
+	// Recycled actors and their components reference each other
+	for (auto &[pArchetype, actors] : m_recycledActors)
+	{
+		for (auto &pActor : actors)
+			pActor->Destroy();
+	}
+}
+
+BGE::StrongActorPtr BGE::ActorFactory::CreateActor(std::string_view xmlFilename, tinyxml2::XMLElement *pOverrides,
+												   const Math::Mat4x4f &initialTransform, ActorID serverActorID)
+{
+	ArchetypeEntry *pEntry = FindOrLoadArchetype(xmlFilename);
+	if (!pEntry)
+		return StrongActorPtr();
+
+	StrongActorPtr pActor = pEntry->archetype.IsValid()
+		? CreateActor(pEntry->archetype, serverActorID)
+		: CreateActorFromXML(pEntry->pDocument->RootElement(), serverActorID);
+	if (!pActor)
+		return StrongActorPtr();
+	if (pOverrides)
+		ModifyActor(pActor, pOverrides);
+	VSetInitialTransform(*pActor, initialTransform);
+	return pActor;
+}
+
+BGE::StrongActorPtr BGE::ActorFactory::CreateActor(const ActorArchetype &archetype, ActorID serverActorID)
+{
+	const ActorID kID = (serverActorID != kINVALID_ACTOR_ID) ? serverActorID : GetNextActorID();
+	const auto kRecycledIter = m_recycledActors.find(&archetype);
+	if (kRecycledIter != m_recycledActors.end() && !kRecycledIter->second.empty())
+	{
+		StrongActorPtr pActor = std::move(kRecycledIter->second.back());
+		kRecycledIter->second.pop_back();
+		pActor->m_ID = kID;
+		if (ReinitActor(*pActor, archetype))
+			return pActor;
+		pActor->Destroy(); // Fall through to a fresh clone
+	}
+	return CloneActor(archetype, kID);
+}
+
+void BGE::ActorFactory::CreateActors(const ActorArchetype &archetype, ActorID firstID, std::size_t count,
+									   std::span<const Math::Mat4x4f> transforms, std::vector<StrongActorPtr> &outActors)
+{
+	BGE_ASSERT(transforms.empty() || transforms.size() == count);
+	outActors.reserve(outActors.size() + count);
+	for (std::size_t index = 0; index < count; ++index)
+	{
+		StrongActorPtr pActor = CreateActor(archetype, firstID + static_cast<ActorID>(index));
+		if (!pActor)
+			continue;
+		if (!transforms.empty())
+			VSetInitialTransform(*pActor, transforms[index]);
+		outActors.push_back(std::move(pActor));
+	}
+}
+
+BGE::StrongActorPtr BGE::ActorFactory::CloneActor(const ActorArchetype &archetype, ActorID aID)
+{
+	auto pActor = std::make_shared<Actor>(aID);
+	pActor->m_pArchetype = &archetype;
+	pActor->m_type = archetype.GetType();
+	pActor->m_resourceFilename = archetype.GetResourceFilename();
+
+	for (const auto &kRecord : archetype.GetComponents())
+	{
+		StrongActorComponentPtr pComponent = VCreateComponent(kRecord.cID);
+		BlobReader reader(archetype.GetComponentData(kRecord));
+		if (!pComponent || !pComponent->VInitFromBlob(reader))
+		{
+			BGE_ERROR("Failed to clone component %u of actor %s", kRecord.cID, archetype.GetType().c_str());
+			pActor->Destroy();
+			return StrongActorPtr();
+		}
+
+		pComponent->SetOwnerPtr(pActor);
+		pActor->AddComponent(std::move(pComponent));
+	}
+	pActor->PostInit();
+	return pActor;
+}
+
+BGE::StrongActorPtr BGE::ActorFactory::CreateActor(const ActorSnapshotReader &snapshot,
+												   const ActorSnapshotReader::ActorView &actorView)
+{
+	auto pActor = std::make_shared<Actor>(actorView.aID);
+	pActor->m_type = actorView.type;
+	pActor->m_resourceFilename = actorView.resource;
+	m_lastActorID = std::max(m_lastActorID, actorView.aID);
+
+	for (const auto &kComponentView : snapshot.GetComponents(actorView))
+	{
+		StrongActorComponentPtr pComponent = VCreateComponent(kComponentView.cID);
+		BlobReader reader(kComponentView.data);
+		if (!pComponent || !pComponent->VInitFromBlob(reader))
+		{
+			BGE_ERROR("Failed to load component %u of actor %u", kComponentView.cID, actorView.aID);
+			pActor->Destroy();
+			return StrongActorPtr();
+		}
+
+		pComponent->SetOwnerPtr(pActor);
+		pActor->AddComponent(std::move(pComponent));
+	}
+	pActor->PostInit();
+	return pActor;
+}
+
+BGE::StrongActorPtr BGE::ActorFactory::CreateActorFromXML(tinyxml2::XMLElement *pActorData, ActorID serverActorID)
+{
+	auto pActor = std::make_shared<Actor>((serverActorID != kINVALID_ACTOR_ID) ? serverActorID : GetNextActorID());
+	if (!pActor->Init(pActorData))
+	{
+		BGE_ERROR("Failed to initialize actor");
+		return StrongActorPtr();
+	}
+
+	for (auto *pElem = pActorData->FirstChildElement(); pElem; pElem = pElem->NextSiblingElement())
+	{
+		StrongActorComponentPtr pComponent = VCreateComponent(pElem);
+		if (!pComponent)
+		{
+			pActor->Destroy();
+			return StrongActorPtr();
+		}
+
+		pComponent->SetOwnerPtr(pActor);
+		pActor->AddComponent(std::move(pComponent));
+	}
+	pActor->PostInit();
+	return pActor;
+}
+
+const BGE::ActorArchetype *BGE::ActorFactory::PreloadArchetype(std::string_view xmlFilename)
+{
+	const ArchetypeEntry *pEntry = FindOrLoadArchetype(xmlFilename);
+	return (pEntry && pEntry->archetype.IsValid()) ? &pEntry->archetype : nullptr;
+}
+
+bool BGE::ActorFactory::AddArchetype(std::string_view xmlFilename, std::span<const std::byte> blob)
+{
+	ArchetypeEntry entry;
+	if (!entry.archetype.Load(blob))
+	{
+		BGE_ERROR("Invalid archetype blob for %s", std::string(xmlFilename).c_str());
+		return false;
+	}
+
+	const auto [kIter, kInserted] = m_archetypes.try_emplace(std::string(xmlFilename));
+	// Recycled actors were laid out for the old blob
+	if (!kInserted)
+		DestroyRecycledActors(kIter->second.archetype);
+	kIter->second = std::move(entry);
+	return true;
+}
+
+void BGE::ActorFactory::ModifyActor(StrongActorPtr pActor, tinyxml2::XMLElement *pOverrides)
+{
+	for (auto *pElem = pOverrides->FirstChildElement(); pElem; pElem = pElem->NextSiblingElement())
+	{
+		const ActorComponentID kID = ActorComponent::GetIDFromName(pElem->Name());
+		auto pComponent = Utils::MakeStrongPtr(pActor->GetComponentPtr<ActorComponent>(kID));
+		if (pComponent)
+		{
+			pComponent->VInit(pElem);
+			pComponent->MarkChanged();
+			continue;
+		}
+		// Overrides may also add components the definition lacks
+		pComponent = VCreateComponent(pElem);
+		if (pComponent)
+		{
+			pComponent->SetOwnerPtr(pActor);
+			pActor->AddComponent(pComponent);
+			pComponent->VPostInit();
+		}
+	}
+}
+
+void BGE::ActorFactory::RecycleActor(StrongActorPtr pActor)
+{
+	if (!pActor)
+		return;
+	// Free listed actors are out of the world
+	if (pActor->m_pQueries)
+		pActor->m_pQueries->RemoveActor(*pActor);
+	if (!pActor->m_pArchetype)
+	{
+		pActor->Destroy();
+		return;
+	}
+	for (const auto &pComponent : pActor->m_components.GetValues())
+	{
+		pComponent->VOnRecycled();
+		pComponent->SetParked(true);
+	}
+	// Vector growth is the only allocation here; ReserveActors() pays it up front
+	m_recycledActors[pActor->m_pArchetype].push_back(std::move(pActor));
+}
+
+void BGE::ActorFactory::ReserveActors(const ActorArchetype &archetype, std::size_t count)
+{
+	auto &actors = m_recycledActors[&archetype];
+	actors.reserve(count);
+	while (actors.size() < count)
+	{
+		StrongActorPtr pActor = CloneActor(archetype, std::numeric_limits<ActorID>::max());
+		if (!pActor)
+			return;
+		for (const auto &pComponent : pActor->m_components.GetValues())
+		{
+			pComponent->VOnRecycled();
+			pComponent->SetParked(true);
+		}
+		actors.push_back(std::move(pActor));
+	}
+}
+
+std::size_t BGE::ActorFactory::GetNumRecycledActors(const ActorArchetype &archetype) const
+{
+	const auto kFindIter = m_recycledActors.find(&archetype);
+	return (kFindIter != m_recycledActors.end()) ? kFindIter->second.size() : 0;
+}
+
 BGE::StrongActorComponentPtr BGE::ActorFactory::VCreateComponent(tinyxml2::XMLElement *pData)
 {
-	return StrongActorComponentPtr();
-}
\ No newline at end of file
+	StrongActorComponentPtr pComponent = VCreateComponent(ActorComponent::GetIDFromName(pData->Name()));
+	if (!pComponent)
+	{
+		BGE_ERROR("Unknown component %s", pData->Name());
+		return StrongActorComponentPtr();
+	}
+	if (!pComponent->VInit(pData))
+	{
+		BGE_ERROR("Failed to initialize component %s", pData->Name());
+		return StrongActorComponentPtr();
+	}
+	return pComponent;
+}
+
+BGE::StrongActorComponentPtr BGE::ActorFactory::VCreateComponent(ActorComponentID cID)
+{
+	const auto kFindIter = m_componentCreators.find(cID);
+	return (kFindIter != m_componentCreators.end()) ? kFindIter->second() : StrongActorComponentPtr();
+}
+
+void BGE::ActorFactory::VSetInitialTransform(Actor &actor, const Math::Mat4x4f &transform)
+{
+	if (auto *pTransform = actor.FindComponent<TransformComponent>())
+		pTransform->SetLocal(transform);
+}
+
+BGE::ActorFactory::ArchetypeEntry *BGE::ActorFactory::FindOrLoadArchetype(std::string_view xmlFilename)
+{
+	std::string filename(xmlFilename);
+	auto findIter = m_archetypes.find(filename);
+	if (findIter != m_archetypes.end())
+		return &findIter->second;
+
+	using namespace tinyxml2;
+	auto pDocument = std::make_unique<XMLDocument>();
+	if (pDocument->LoadFile(filename.c_str()) != XML_SUCCESS || !pDocument->RootElement())
+	{
+		BGE_ERROR("Failed to load actor definition %s", filename.c_str());
+		return nullptr;
+	}
+	// Build a throwaway prototype and compile it; it never gets a real actor ID
+	ArchetypeEntry entry;
+	auto pPrototype = CreateActorFromXML(pDocument->RootElement(), std::numeric_limits<ActorID>::max());
+	if (!pPrototype)
+		return nullptr;
+	if (!entry.archetype.Compile(*pPrototype))
+		entry.pDocument = std::move(pDocument);
+	pPrototype->Destroy();
+
+	return &m_archetypes.emplace(std::move(filename), std::move(entry)).first->second;
+}
+
+bool BGE::ActorFactory::ReinitActor(Actor &actor, const ActorArchetype &archetype)
+{
+	// Records were written in component ID order, the same order the actor stores them
+	const auto kRecords = archetype.GetComponents();
+	const auto kComponents = actor.m_components.GetValues();
+	if (kRecords.size() != kComponents.size())
+		return false;
+
+	for (std::size_t index = 0; index < kRecords.size(); ++index)
+	{
+		ActorComponent &component = *kComponents[index];
+		component.SetParked(false);
+		BlobReader reader(archetype.GetComponentData(kRecords[index]));
+		if (component.VGetID() != kRecords[index].cID || !component.VInitFromBlob(reader))
+			return false;
+		component.m_isChangePending = false; // Changes from its previous life are moot
+	}
+	actor.PostInit();
+	return true;
+}
+
+void BGE::ActorFactory::DestroyRecycledActors(const ActorArchetype &archetype)
+{
+	const auto kFindIter = m_recycledActors.find(&archetype);
+	if (kFindIter == m_recycledActors.end())
+		return;
+
+	for (auto &pActor : kFindIter->second)
+		pActor->Destroy();
+	m_recycledActors.erase(kFindIter);
+}
@@ -1,23 +1,121 @@
 #ifndef _BGE_ACTORFACTORY_HPP_
 #define _BGE_ACTORFACTORY_HPP_
 
+#include "Actors/ActorArchetype.hpp"
+#include "Actors/ActorComponent.hpp"
+#include "Actors/ComponentStore.hpp"
+#include "Actors/ActorSnapshot.hpp"
+
+#include <functional>
+#include <unordered_map>
+
 namespace BGE
 {
+	/**
+	 * ActorFactory builds actors from XML definitions. The first spawn of a file
+	 * parses it and compiles an ActorArchetype; later spawns clone the archetype,
+	 * initializing each component from its blob record without touching tinyxml2.
+	 *
+	 * Definitions with a component that has no blob support keep their parsed
+	 * document instead, so they still skip the disk read and parse.
+	 *
+	 * Actors cloned from an archetype can be handed back with RecycleActor(). They
+	 * keep their components and go on a free list per archetype; the next spawn
+	 * resets them from the blob rather than allocating a new actor.
+	 */
 	class ActorFactory
 	{
+		using ComponentCreator = std::function<StrongActorComponentPtr(void)>;
+		// Cached definition of one XML file
+		struct ArchetypeEntry
+		{
+			ActorArchetype archetype; // Valid if every component supports blobs
+			std::unique_ptr<tinyxml2::XMLDocument> pDocument; // Fallback when the archetype is not
+		};
+
 		ActorID m_lastActorID; // ID of the last constructed Actor
+		std::unordered_map<std::string, ArchetypeEntry> m_archetypes; // By XML filename
+		std::unordered_map<const ActorArchetype *, std::vector<StrongActorPtr>> m_recycledActors;
 	protected:
-		// TODO: 
+		std::unordered_map<ActorComponentID, ComponentCreator> m_componentCreators;
 	public:
 		ActorFactory(void);
+		virtual ~ActorFactory(void);
+
+		// Make COMPONENTTYPE creatable from XML elements and archetypes named after it.
+		template <IdentifiedComponent ComponentType>
+		void RegisterComponent(void)
+		{
+			m_componentCreators[ComponentType::kID] = [](void) -> StrongActorComponentPtr
+			{
+				return std::make_shared<ComponentType>();
+			};
+		}
+		// Same, for components that need constructor arguments CREATOR supplies.
+		template <IdentifiedComponent ComponentType>
+		void RegisterComponent(ComponentCreator creator)
+		{
+			m_componentCreators[ComponentType::kID] = std::move(creator);
+		}
+		// Same, but the components are packed in STORE's pool for COMPONENTTYPE and
+		// constructed from copies of ARGS (wrap references in std::ref). STORE must
+		// outlive every actor created from this factory.
+		template <IdentifiedComponent ComponentType, typename... Args>
+		void RegisterPooledComponent(ComponentStore &store, Args &&...args)
+		{
+			m_componentCreators[ComponentType::kID] = [&store, ...kArgs = std::forward<Args>(args)](void) -> StrongActorComponentPtr
+			{
+				return store.Create<ComponentType>(kArgs...);
+			};
+		}
 
 		StrongActorPtr CreateActor(std::string_view xmlFilename, tinyxml2::XMLElement *pOverrides, const Math::Mat4x4f &initialTransform, ActorID serverActorID);
+		// Clone ARCHETYPE, reusing a recycled actor when one is available. A SERVERACTORID
+		// of kINVALID_ACTOR_ID assigns the next local ID. ARCHETYPE must outlive the actor.
+		StrongActorPtr CreateActor(const ActorArchetype &archetype, ActorID serverActorID = kINVALID_ACTOR_ID);
+		// Clone COUNT actors with IDs FIRSTID onward and append them to OUTACTORS.
+		// TRANSFORMS is either empty or holds one transform per actor.
+		void CreateActors(const ActorArchetype &archetype, ActorID firstID, std::size_t count,
+						  std::span<const Math::Mat4x4f> transforms, std::vector<StrongActorPtr> &outActors);
+		// Rebuild an actor saved in SNAPSHOT, keeping its ID. Later local IDs are
+		// assigned after it.
+		StrongActorPtr CreateActor(const ActorSnapshotReader &snapshot, const ActorSnapshotReader::ActorView &actorView);
+		// Build an actor straight from an <Actor> element, bypassing the archetype cache.
+		StrongActorPtr CreateActorFromXML(tinyxml2::XMLElement *pActorData, ActorID serverActorID = kINVALID_ACTOR_ID);
+		// Parse and compile XMLFILENAME ahead of the first spawn (e.g. during level load).
+		// Returns nullptr if the file fails to load or cannot be compiled.
+		const ActorArchetype *PreloadArchetype(std::string_view xmlFilename);
+		// Register a blob compiled offline under the XML filename it was built from.
+		bool AddArchetype(std::string_view xmlFilename, std::span<const std::byte> blob);
 		void ModifyActor(StrongActorPtr pActor, tinyxml2::XMLElement *pOverrides);
+		// Despawn PACTOR. Actors cloned from an archetype are kept for reuse; others are
+		// destroyed. References to a recycled actor must not be used afterwards.
+		void RecycleActor(StrongActorPtr pActor);
+		// Grow ARCHETYPE's free list to COUNT actors, so that many spawns need no allocation.
+		void ReserveActors(const ActorArchetype &archetype, std::size_t count);
+		std::size_t GetNumRecycledActors(const ActorArchetype &archetype) const;
 		virtual StrongActorComponentPtr VCreateComponent(tinyxml2::XMLElement *pData);
+		virtual StrongActorComponentPtr VCreateComponent(ActorComponentID cID);
+		// Place a newly spawned actor. The default sets the local matrix of its
+		// TransformComponent, if it has one.
+		virtual void VSetInitialTransform(Actor &actor, const Math::Mat4x4f &transform);
+		// Claim COUNT consecutive local IDs and return the first.
+		ActorID ReserveActorIDs(std::size_t count)
+		{
+			const ActorID kFirstID = m_lastActorID + 1;
+			m_lastActorID += static_cast<ActorID>(count);
+			return kFirstID;
+		}
 	private:
 		// Increment internal ID count and return the previous ID.
 		ActorID GetNextActorID(void) { ++m_lastActorID; return m_lastActorID; }
+		ArchetypeEntry *FindOrLoadArchetype(std::string_view xmlFilename);
+		// Build a new actor from ARCHETYPE, ignoring the free list.
+		StrongActorPtr CloneActor(const ActorArchetype &archetype, ActorID aID);
+		// Reset a recycled actor's components from ARCHETYPE; false if they no longer match.
+		bool ReinitActor(Actor &actor, const ActorArchetype &archetype);
+		void DestroyRecycledActors(const ActorArchetype &archetype);
 	};
 } // End namespace (BGE)
 
-#endif /* !_BGE_ACTORFACTORY_HPP_ */
\ No newline at end of file
+#endif /* !_BGE_ACTORFACTORY_HPP_ */
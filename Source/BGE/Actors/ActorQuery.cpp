@@ -0,0 +1,150 @@
+/*=============================================================================*
+ * ActorQuery.cpp - Cached queries over actors' component sets.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "ActorQuery.hpp"
+
+bool BGE::ActorQueryDesc::Matches(const Actor &actor) const
+{
+	const auto &kComponents = actor.GetComponents();
+	for (const ActorComponentID kID : with)
+	{
+		if (!kComponents.contains(kID))
+			return false;
+	}
+	for (const ActorComponentID kID : without)
+	{
+		if (kComponents.contains(kID))
+			return false;
+	}
+	return true;
+}
+
+void BGE::ActorQueryDesc::Insert(std::vector<ActorComponentID> &cIDs, ActorComponentID cID)
+{
+	const auto kIter = std::lower_bound(cIDs.begin(), cIDs.end(), cID);
+	if (kIter == cIDs.end() || *kIter != cID)
+		cIDs.insert(kIter, cID);
+}
+
+void BGE::ActorQuery::Refresh(Actor &actor)
+{
+	if (!m_desc.Matches(actor))
+	{
+		Remove(actor);
+		return;
+	}
+
+	const auto [kIter, kInserted] = m_indices.try_emplace(&actor, static_cast<std::uint32_t>(m_actors.size()));
+	if (kInserted)
+	{
+		m_actors.push_back(&actor);
+		m_components.resize(m_components.size() + GetNumColumns());
+	}
+	// Refill the columns either way; a matching actor may have swapped a component
+	const auto &kComponents = actor.GetComponents();
+	ActorComponent **ppComponents = m_components.data() + kIter->second * GetNumColumns();
+	for (std::size_t column = 0; column < GetNumColumns(); ++column)
+		ppComponents[column] = kComponents.FindValue(m_desc.with[column])->get();
+}
+
+void BGE::ActorQuery::Remove(const Actor &actor)
+{
+	const auto kFindIter = m_indices.find(&actor);
+	if (kFindIter == m_indices.end())
+		return;
+
+	const std::uint32_t kIndex = kFindIter->second;
+	const std::size_t kLast = m_actors.size() - 1;
+	m_indices.erase(kFindIter);
+	if (kIndex != kLast)
+	{
+		m_actors[kIndex] = m_actors[kLast];
+		std::copy_n(m_components.begin() + kLast * GetNumColumns(), GetNumColumns(),
+					m_components.begin() + kIndex * GetNumColumns());
+		m_indices[m_actors[kIndex]] = kIndex;
+	}
+	m_actors.pop_back();
+	m_components.resize(m_components.size() - GetNumColumns());
+}
+
+BGE::ActorQueryRegistry::~ActorQueryRegistry(void)
+{
+	for (Actor *pActor : m_actors)
+		pActor->m_pQueries = nullptr;
+}
+
+BGE::ActorQuery &BGE::ActorQueryRegistry::GetQuery(const ActorQueryDesc &desc)
+{
+	for (const auto &pQuery : m_queries)
+	{
+		if (pQuery->GetDesc() == desc)
+			return *pQuery;
+	}
+
+	auto &pQuery = m_queries.emplace_back(std::make_unique<ActorQuery>(desc));
+	for (Actor *pActor : m_actors)
+		pQuery->Refresh(*pActor);
+	return *pQuery;
+}
+
+void BGE::ActorQueryRegistry::AddActor(Actor &actor)
+{
+	BGE_ASSERT(actor.m_pQueries == nullptr || actor.m_pQueries == this);
+	if (!m_indices.try_emplace(&actor, static_cast<std::uint32_t>(m_actors.size())).second)
+		return;
+
+	m_actors.push_back(&actor);
+	actor.m_pQueries = this;
+	OnComponentsChanged(actor);
+}
+
+void BGE::ActorQueryRegistry::RemoveActor(Actor &actor)
+{
+	const auto kFindIter = m_indices.find(&actor);
+	if (kFindIter == m_indices.end())
+		return;
+	// Swap remove; only a later GetQuery() sees the changed order
+	const std::uint32_t kIndex = kFindIter->second;
+	m_indices.erase(kFindIter);
+	if (kIndex != m_actors.size() - 1)
+	{
+		m_actors[kIndex] = m_actors.back();
+		m_indices[m_actors[kIndex]] = kIndex;
+	}
+	m_actors.pop_back();
+
+	actor.m_pQueries = nullptr;
+	for (const auto &pQuery : m_queries)
+		pQuery->Remove(actor);
+}
+
+void BGE::ActorQueryRegistry::OnComponentsChanged(Actor &actor)
+{
+	for (const auto &pQuery : m_queries)
+		pQuery->Refresh(actor);
+}
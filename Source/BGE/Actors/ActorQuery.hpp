@@ -0,0 +1,140 @@
+/*=============================================================================*
+ * ActorQuery.hpp - Cached queries over actors' component sets.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_ACTORQUERY_HPP_
+#define _BGE_ACTORQUERY_HPP_
+
+#include "Actors/Actor.hpp"
+
+#include <unordered_map>
+
+namespace BGE
+{
+	// Which components an actor needs (With) and must lack (Without) to match a query.
+	struct ActorQueryDesc
+	{
+		std::vector<ActorComponentID> with; // Sorted, unique
+		std::vector<ActorComponentID> without; // Sorted, unique
+
+		template <IdentifiedComponent... ComponentTypes>
+		ActorQueryDesc &With(void) { (Insert(with, ComponentTypes::kID), ...); return *this; }
+		template <IdentifiedComponent... ComponentTypes>
+		ActorQueryDesc &Without(void) { (Insert(without, ComponentTypes::kID), ...); return *this; }
+		bool Matches(const Actor &actor) const;
+		bool operator==(const ActorQueryDesc &) const = default;
+	private:
+		static void Insert(std::vector<ActorComponentID> &cIDs, ActorComponentID cID);
+	};
+	/**
+	 * ActorQuery holds the actors matching its description in a dense array, along
+	 * with their With components, so iterating a query costs O(matches) and no
+	 * component map lookups. ActorQueryRegistry keeps it current as actors enter and
+	 * leave the world and gain or lose components.
+	 *
+	 * Removal swaps the last match into the hole, so order is unspecified and spans
+	 * are invalidated by any change to the matching set.
+	 */
+	class ActorQuery : public INonCopyable
+	{
+		friend class ActorQueryRegistry;
+
+		ActorQueryDesc m_desc;
+		std::vector<Actor *> m_actors;
+		std::vector<ActorComponent *> m_components; // GetNumColumns() per actor, in m_desc.with order
+		std::unordered_map<const Actor *, std::uint32_t> m_indices; // Into m_actors
+	public:
+		explicit ActorQuery(ActorQueryDesc desc) : m_desc(std::move(desc)) { }
+
+		const ActorQueryDesc &GetDesc(void) const noexcept { return m_desc; }
+		std::span<Actor *const> GetActors(void) const { return m_actors; }
+		// The With components of match INDEX, in GetDesc().with order.
+		std::span<ActorComponent *const> GetComponents(std::size_t index) const
+		{
+			return std::span<ActorComponent *const>(m_components).subspan(index * GetNumColumns(), GetNumColumns());
+		}
+		std::size_t GetSize(void) const noexcept { return m_actors.size(); }
+		bool IsEmpty(void) const noexcept { return m_actors.empty(); }
+		// Call FUNC(Actor &, ComponentTypes &...) for every match. Each type must be
+		// one of the query's With components.
+		template <IdentifiedComponent... ComponentTypes, typename Func>
+		void ForEach(Func &&func) const
+		{
+			ForEachImpl<ComponentTypes...>(func, std::index_sequence_for<ComponentTypes...>());
+		}
+	private:
+		std::size_t GetNumColumns(void) const noexcept { return m_desc.with.size(); }
+		std::size_t GetColumn(ActorComponentID cID) const
+		{
+			const auto kIter = std::lower_bound(m_desc.with.begin(), m_desc.with.end(), cID);
+			BGE_ASSERT(kIter != m_desc.with.end() && *kIter == cID);
+			return static_cast<std::size_t>(kIter - m_desc.with.begin());
+		}
+		template <IdentifiedComponent... ComponentTypes, typename Func, std::size_t... kIndices>
+		void ForEachImpl(Func &func, std::index_sequence<kIndices...>) const
+		{
+			// Column lookups once per call rather than per actor
+			[[maybe_unused]] const std::array<std::size_t, sizeof...(ComponentTypes)> kColumns{ GetColumn(ComponentTypes::kID)... };
+			const std::size_t kStride = GetNumColumns();
+			for (std::size_t index = 0; index < m_actors.size(); ++index)
+			{
+				ActorComponent *const *ppComponents = m_components.data() + index * kStride;
+				func(*m_actors[index], static_cast<ComponentTypes &>(*ppComponents[kColumns[kIndices]])...);
+			}
+		}
+		// Add or drop ACTOR as its components now dictate.
+		void Refresh(Actor &actor);
+		void Remove(const Actor &actor);
+	};
+	/**
+	 * ActorQueryRegistry owns the queries of one world and the set of actors they
+	 * see. Actors are tracked from AddActor() until RemoveActor(), Actor::Destroy() or
+	 * ActorFactory::RecycleActor(); Actor::AddComponent() and RemoveComponent() on a
+	 * tracked actor update every query at once.
+	 */
+	class ActorQueryRegistry : public INonCopyable, public INonMoveable
+	{
+		std::vector<std::unique_ptr<ActorQuery>> m_queries;
+		// In insertion order (swap removed), so new queries match in a reproducible order
+		std::vector<Actor *> m_actors;
+		std::unordered_map<const Actor *, std::uint32_t> m_indices; // Into m_actors
+	public:
+		ActorQueryRegistry(void) = default;
+		~ActorQueryRegistry(void);
+
+		// Return the query for DESC, creating and filling it on first use. Queries live
+		// as long as the registry and are shared by equal descriptions.
+		ActorQuery &GetQuery(const ActorQueryDesc &desc);
+		void AddActor(Actor &actor);
+		void RemoveActor(Actor &actor);
+		std::size_t GetNumActors(void) const noexcept { return m_actors.size(); }
+	private:
+		friend class Actor;
+		void OnComponentsChanged(Actor &actor);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_ACTORQUERY_HPP_ */
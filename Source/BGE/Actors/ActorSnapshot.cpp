@@ -0,0 +1,184 @@
+/*=============================================================================*
+ * ActorSnapshot.cpp - Binary snapshot of every live actor.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "ActorSnapshot.hpp"
+
+#include <ostream>
+
+BGE::ActorSnapshotWriter::ActorSnapshotWriter(std::ostream &stream)
+	: m_stream(stream),
+	  m_writer(m_buffer),
+	  m_numActors(0),
+	  m_numSkippedComponents(0),
+	  m_isFinished(false)
+{
+	m_buffer.reserve(kFLUSH_SIZE * 2);
+	m_writer.Write(ActorSnapshot::kMAGIC);
+	m_writer.Write(ActorSnapshot::kVERSION);
+	m_writer.Write(std::uint16_t(0));
+}
+
+BGE::ActorSnapshotWriter::~ActorSnapshotWriter(void)
+{
+	if (!m_isFinished)
+		Finish();
+}
+
+void BGE::ActorSnapshotWriter::WriteActor(const Actor &actor)
+{
+	BGE_ASSERT(!m_isFinished && actor.GetID() != kINVALID_ACTOR_ID);
+	m_writer.Write(actor.GetID());
+	WriteInternedString(actor.GetType());
+	WriteInternedString(actor.GetResourceFilename());
+	const std::size_t kCountOffset = m_writer.GetSize();
+	m_writer.Write(std::uint32_t(0));
+
+	std::uint32_t numComponents = 0;
+	for (const auto &pComponent : actor.GetComponents().GetValues())
+	{
+		const std::size_t kRecordOffset = m_writer.GetSize();
+		m_writer.Write(pComponent->VGetID());
+		m_writer.Write(std::uint32_t(0));
+		if (!pComponent->VWriteBlob(m_writer))
+		{
+			BGE_WARNING("Component %s of actor %u does not support blobs; not saved",
+						pComponent->VGetName().c_str(), actor.GetID());
+			m_buffer.resize(kRecordOffset);
+			++m_numSkippedComponents;
+			continue;
+		}
+		const std::size_t kDataOffset = kRecordOffset + sizeof(ActorComponentID) + sizeof(std::uint32_t);
+		m_writer.WriteAt(kDataOffset - sizeof(std::uint32_t), static_cast<std::uint32_t>(m_writer.GetSize() - kDataOffset));
+		++numComponents;
+	}
+	m_writer.WriteAt(kCountOffset, numComponents);
+	++m_numActors;
+	if (m_buffer.size() >= kFLUSH_SIZE)
+		Flush();
+}
+
+void BGE::ActorSnapshotWriter::WriteActors(const ActorMap &actors)
+{
+	for (const auto &[kID, pActor] : actors)
+		WriteActor(*pActor);
+}
+
+bool BGE::ActorSnapshotWriter::Finish(void)
+{
+	if (!m_isFinished)
+	{
+		m_writer.Write(kINVALID_ACTOR_ID);
+		Flush();
+		m_stream.flush();
+		m_isFinished = true;
+	}
+	return m_stream.good();
+}
+
+void BGE::ActorSnapshotWriter::WriteInternedString(const std::string &str)
+{
+	const auto [kIter, kInserted] = m_strings.try_emplace(str, static_cast<std::uint32_t>(m_strings.size()));
+	m_writer.Write(kIter->second);
+	if (kInserted)
+		m_writer.WriteString(str);
+}
+
+void BGE::ActorSnapshotWriter::Flush(void)
+{
+	m_stream.write(reinterpret_cast<const char *>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	m_buffer.clear();
+}
+
+bool BGE::ActorSnapshotReader::Open(std::span<const std::byte> data)
+{
+	m_actors.clear();
+	m_components.clear();
+	m_strings.clear();
+
+	BlobReader reader(data);
+	std::uint32_t magic = 0;
+	std::uint16_t version = 0, reserved = 0;
+	if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(reserved)
+		|| magic != ActorSnapshot::kMAGIC || version != ActorSnapshot::kVERSION)
+	{
+		BGE_ERROR("Not an actor snapshot, or from another version");
+		return false;
+	}
+
+	bool isComplete = false;
+	ActorID aID = kINVALID_ACTOR_ID;
+	while (reader.Read(aID))
+	{
+		if (aID == kINVALID_ACTOR_ID)
+		{
+			isComplete = true;
+			break;
+		}
+
+		ActorView actor{ aID, {}, {}, static_cast<std::uint32_t>(m_components.size()), 0 };
+		if (!ReadInternedString(reader, actor.type) || !ReadInternedString(reader, actor.resource)
+			|| !reader.Read(actor.numComponents))
+			break;
+		for (std::uint32_t index = 0; index < actor.numComponents; ++index)
+		{
+			ComponentView component;
+			std::uint32_t size = 0;
+			if (!reader.Read(component.cID) || !reader.Read(size) || !reader.ReadSpan(size, component.data))
+				break;
+			m_components.push_back(component);
+		}
+		if (m_components.size() != actor.firstComponent + actor.numComponents)
+			break;
+		m_actors.push_back(actor);
+	}
+
+	if (!isComplete)
+	{
+		BGE_ERROR("Actor snapshot is truncated after %zu actors", m_actors.size());
+		m_actors.clear();
+		m_components.clear();
+		return false;
+	}
+	return true;
+}
+
+bool BGE::ActorSnapshotReader::ReadInternedString(BlobReader &reader, std::string_view &str)
+{
+	std::uint32_t index = 0;
+	if (!reader.Read(index) || index > m_strings.size())
+		return false;
+	if (index == m_strings.size())
+	{
+		if (!reader.ReadStringView(str))
+			return false;
+		m_strings.push_back(str);
+		return true;
+	}
+	str = m_strings[index];
+	return true;
+}
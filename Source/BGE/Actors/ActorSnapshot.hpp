@@ -0,0 +1,129 @@
+/*=============================================================================*
+ * ActorSnapshot.hpp - Binary snapshot of every live actor.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_ACTORSNAPSHOT_HPP_
+#define _BGE_ACTORSNAPSHOT_HPP_
+
+#include "Actors/Actor.hpp"
+#include "Actors/ActorArchetype.hpp"
+
+#include <iosfwd>
+
+namespace BGE
+{
+	/**
+	 * Snapshot format, all values in host byte order:
+	 *
+	 *   u32 magic, u16 version, u16 reserved
+	 *   per actor: ActorID (never kINVALID_ACTOR_ID), type, resource,
+	 *              u32 component count, then per component: ActorComponentID,
+	 *              u32 size, and the bytes written by ActorComponent::VWriteBlob()
+	 *   ActorID kINVALID_ACTOR_ID terminator
+	 *
+	 * Strings are interned: a u32 index into the strings seen so far, followed by the
+	 * string itself the first time it appears. Thousands of actors sharing a type and
+	 * resource then cost eight bytes each for both.
+	 */
+	namespace ActorSnapshot
+	{
+		inline constexpr std::uint32_t kMAGIC = 0x53454742; // "BGES"
+		inline constexpr std::uint16_t kVERSION = 2; // 2: TransformComponent blobs name their parent
+	} // End namespace (ActorSnapshot)
+	/**
+	 * Streams actors to an output stream in the snapshot format. Actors are
+	 * serialized into a reused buffer that is flushed in large blocks, so memory use
+	 * stays flat however many actors are written.
+	 */
+	class ActorSnapshotWriter : public INonCopyable
+	{
+		static constexpr std::size_t kFLUSH_SIZE = 64 * 1024;
+
+		std::ostream &m_stream;
+		std::vector<std::byte> m_buffer;
+		BlobWriter m_writer;
+		std::unordered_map<std::string, std::uint32_t> m_strings;
+		std::size_t m_numActors;
+		std::size_t m_numSkippedComponents;
+		bool m_isFinished;
+	public:
+		// Writes the header to STREAM, which must outlive the writer.
+		explicit ActorSnapshotWriter(std::ostream &stream);
+		~ActorSnapshotWriter(void);
+
+		// Components that do not support blobs are skipped with a warning.
+		void WriteActor(const Actor &actor);
+		void WriteActors(const ActorMap &actors);
+		// Write the terminator and flush. False if the stream failed at any point.
+		bool Finish(void);
+		std::size_t GetNumActors(void) const noexcept { return m_numActors; }
+		std::size_t GetNumSkippedComponents(void) const noexcept { return m_numSkippedComponents; }
+	private:
+		void WriteInternedString(const std::string &str);
+		void Flush(void);
+	};
+	/**
+	 * Indexes a snapshot in place. Nothing is copied: strings and component data are
+	 * views into the bytes passed to Open(), which may be a memory mapped file and
+	 * must outlive the reader. Actors are built from the views by
+	 * ActorFactory::CreateActor().
+	 */
+	class ActorSnapshotReader
+	{
+	public:
+		struct ComponentView
+		{
+			ActorComponentID cID;
+			std::span<const std::byte> data;
+		};
+		struct ActorView
+		{
+			ActorID aID;
+			std::string_view type;
+			std::string_view resource;
+			std::uint32_t firstComponent; // Into GetComponents()
+			std::uint32_t numComponents;
+		};
+	private:
+		std::vector<ActorView> m_actors;
+		std::vector<ComponentView> m_components;
+		std::vector<std::string_view> m_strings;
+	public:
+		ActorSnapshotReader(void) = default;
+
+		// False if DATA is truncated, malformed or from another version.
+		bool Open(std::span<const std::byte> data);
+		std::span<const ActorView> GetActors(void) const { return m_actors; }
+		std::span<const ComponentView> GetComponents(const ActorView &actor) const
+		{
+			return std::span<const ComponentView>(m_components).subspan(actor.firstComponent, actor.numComponents);
+		}
+	private:
+		bool ReadInternedString(BlobReader &reader, std::string_view &str);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_ACTORSNAPSHOT_HPP_ */
@@ -0,0 +1,329 @@
+/*=============================================================================*
+ * ComponentStore.hpp - Contiguous per-type actor component storage.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_COMPONENTSTORE_HPP_
+#define _BGE_COMPONENTSTORE_HPP_
+
+#include "Actors/ActorComponent.hpp"
+
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+
+namespace BGE
+{
+	/**
+	 * Type erased interface for ComponentPool.
+	 */
+	class IComponentPool
+	{
+		bool m_isUpdatedBySystem = false;
+	public:
+		virtual ~IComponentPool(void) = default;
+		virtual void VUpdateAll(float deltaTime) = 0;
+		virtual std::size_t VGetSize(void) const = 0;
+		// Called by ActorComponent::MarkChanged() for the component in SLOT.
+		virtual void VMarkChanged(std::uint32_t slot, ChangeVersion version) = 0;
+		// Run VOnChanged() on every component marked since the last dispatch.
+		virtual void VDispatchChanges(void) = 0;
+		// Latest version any component in the pool was marked with; 0 if none ever was.
+		virtual ChangeVersion VGetChangeVersion(void) const = 0;
+		// Parked components (e.g. of actors on an ActorFactory free list) stay allocated
+		// but are skipped by updates, change tracking and dispatch.
+		virtual void VSetParked(std::uint32_t slot, bool isParked) = 0;
+		// Pools claimed by a system (see SystemScheduler) are skipped by ComponentStore::UpdateAll().
+		bool IsUpdatedBySystem(void) const noexcept { return m_isUpdatedBySystem; }
+		void SetUpdatedBySystem(bool isUpdatedBySystem) noexcept { m_isUpdatedBySystem = isUpdatedBySystem; }
+	};
+	/**
+	 * ComponentPool stores every component of one concrete type in fixed size chunks,
+	 * so iterating them touches contiguous memory instead of one heap block per
+	 * component. Slots never move, which keeps the shared pointers held by each
+	 * Actor valid; freed slots are reused before the pool grows.
+	 *
+	 * Changes are tracked per chunk with a bitset of marked slots, the latest version
+	 * marked and a packed array of slot versions. Change queries and VOnChanged()
+	 * dispatch skip untouched chunks and never read unchanged components.
+	 */
+	template <typename ComponentType>
+	class ComponentPool final : public IComponentPool
+	{
+		static_assert(std::is_base_of_v<ActorComponent, ComponentType>);
+	public:
+		static constexpr std::size_t kCHUNK_SIZE = 256; // Components per chunk
+	private:
+		struct Chunk
+		{
+			alignas(ComponentType) std::byte storage[kCHUNK_SIZE * sizeof(ComponentType)];
+			std::bitset<kCHUNK_SIZE> isLive;
+			std::bitset<kCHUNK_SIZE> isActive; // Live and not parked
+			// Slots marked since the last dispatch, as words so dispatch can skip to set bits
+			std::array<std::uint64_t, kCHUNK_SIZE / 64> changedWords{};
+			std::size_t numLive = 0;
+			std::size_t numActive = 0;
+			ChangeVersion changeVersion = 0; // Latest version of any slot
+			std::array<ChangeVersion, kCHUNK_SIZE> slotVersions{}; // Packed copy, scanned by change queries
+
+			ComponentType *GetSlot(std::size_t index)
+			{
+				return std::launder(reinterpret_cast<ComponentType *>(storage) + index);
+			}
+		};
+		// Returns the slot to the pool when the last reference to a component is dropped
+		struct Deleter
+		{
+			ComponentPool *pPool;
+			std::uint32_t slot;
+
+			void operator()(ComponentType *pComponent) const { pPool->Destroy(slot); }
+		};
+
+		std::vector<std::unique_ptr<Chunk>> m_chunks;
+		std::vector<std::uint32_t> m_freeSlots; // Reused last in, first out
+		std::size_t m_size;
+		std::atomic<ChangeVersion> m_changeVersion; // Parallel jobs of one stage all store the same value
+	public:
+		ComponentPool(void) : m_size(0), m_changeVersion(0) { }
+		ComponentPool(const ComponentPool &) = delete;
+		ComponentPool &operator=(const ComponentPool &) = delete;
+		~ComponentPool(void)
+		{
+			// Components still referenced would point into freed chunks
+			BGE_ASSERT(m_size == 0 && "ComponentPool destroyed while components are alive!");
+		}
+
+		template <typename... Args>
+		std::shared_ptr<ComponentType> Create(Args &&...args);
+		// Call FUNC(ComponentType &) on every live component in slot order.
+		template <typename Func>
+		void ForEach(Func &&func) { ForEachInChunks(0, m_chunks.size(), std::forward<Func>(func)); }
+		// As ForEach(), limited to chunks [firstChunk, endChunk). Disjoint chunk ranges
+		// share no components, so they may be visited from different threads.
+		template <typename Func>
+		void ForEachInChunks(std::size_t firstChunk, std::size_t endChunk, Func &&func);
+		// Call FUNC(ComponentType &) on every live component marked after VERSION.
+		template <typename Func>
+		void ForEachChangedSince(ChangeVersion version, Func &&func);
+		// The call is qualified, so VUpdate is dispatched statically and can be inlined.
+		virtual void VUpdateAll(float deltaTime) override
+		{
+			ForEach([deltaTime](ComponentType &component) { component.ComponentType::VUpdate(deltaTime); });
+		}
+		virtual std::size_t VGetSize(void) const override { return m_size; }
+		virtual void VMarkChanged(std::uint32_t slot, ChangeVersion version) override
+		{
+			// Jobs of a parallel system own whole chunks, so these writes never overlap
+			Chunk &chunk = *m_chunks[slot / kCHUNK_SIZE];
+			if (!chunk.isActive.test(slot % kCHUNK_SIZE))
+				return;
+			chunk.changedWords[(slot % kCHUNK_SIZE) / 64] |= std::uint64_t(1) << (slot % 64);
+			chunk.slotVersions[slot % kCHUNK_SIZE] = version;
+			chunk.changeVersion = version;
+			if (m_changeVersion.load(std::memory_order_relaxed) != version)
+				m_changeVersion.store(version, std::memory_order_relaxed);
+		}
+		virtual void VDispatchChanges(void) override;
+		virtual ChangeVersion VGetChangeVersion(void) const override { return m_changeVersion.load(std::memory_order_relaxed); }
+		virtual void VSetParked(std::uint32_t slot, bool isParked) override;
+		std::size_t GetCapacity(void) const { return m_chunks.size() * kCHUNK_SIZE; }
+		std::size_t GetNumChunks(void) const { return m_chunks.size(); }
+	private:
+		void Destroy(std::uint32_t slot);
+	};
+	/**
+	 * ComponentStore owns one ComponentPool per component type. Components created
+	 * here are added to actors as usual; ComponentStore::UpdateAll() then updates
+	 * them pool by pool, and Actor::Update() skips them.
+	 *
+	 * The store must outlive every component created from it.
+	 */
+	class ComponentStore : public INonCopyable
+	{
+		std::vector<std::unique_ptr<IComponentPool>> m_pools; // Registration order
+		std::unordered_map<std::type_index, IComponentPool *> m_poolsByType;
+	public:
+		ComponentStore(void) = default;
+
+		template <typename ComponentType>
+		ComponentPool<ComponentType> &GetPool(void);
+		template <typename ComponentType, typename... Args>
+		std::shared_ptr<ComponentType> Create(Args &&...args)
+		{
+			return GetPool<ComponentType>().Create(std::forward<Args>(args)...);
+		}
+		// Update every pooled component not claimed by a system, one type at a time.
+		void UpdateAll(float deltaTime);
+		// Run VOnChanged() on every pooled component marked since the last dispatch.
+		void DispatchChanges(void);
+		std::size_t GetNumComponents(void) const;
+		std::size_t GetNumPools(void) const { return m_pools.size(); }
+	};
+
+	template <typename ComponentType>
+	template <typename... Args>
+	std::shared_ptr<ComponentType> ComponentPool<ComponentType>::Create(Args &&...args)
+	{
+		if (m_freeSlots.empty())
+		{
+			// Push the new chunk's slots so the lowest index is handed out first
+			const auto kFirstSlot = static_cast<std::uint32_t>(m_chunks.size() * kCHUNK_SIZE);
+			m_chunks.push_back(std::make_unique<Chunk>());
+			for (std::size_t index = kCHUNK_SIZE; index > 0; --index)
+				m_freeSlots.push_back(kFirstSlot + static_cast<std::uint32_t>(index - 1));
+		}
+
+		const std::uint32_t kSlot = m_freeSlots.back();
+		Chunk &chunk = *m_chunks[kSlot / kCHUNK_SIZE];
+		const std::size_t kIndex = kSlot % kCHUNK_SIZE;
+		auto *pComponent = ::new (static_cast<void *>(chunk.GetSlot(kIndex))) ComponentType(std::forward<Args>(args)...);
+		m_freeSlots.pop_back();
+		chunk.isLive.set(kIndex);
+		chunk.isActive.set(kIndex);
+		++chunk.numLive;
+		++chunk.numActive;
+		++m_size;
+		pComponent->m_pPool = this;
+		pComponent->m_poolSlot = kSlot;
+		return std::shared_ptr<ComponentType>(pComponent, Deleter{ this, kSlot });
+	}
+
+	template <typename ComponentType>
+	template <typename Func>
+	void ComponentPool<ComponentType>::ForEachInChunks(std::size_t firstChunk, std::size_t endChunk, Func &&func)
+	{
+		// Index based, so chunks added by FUNC are safe (they may or may not be visited)
+		for (std::size_t chunkIndex = firstChunk; chunkIndex < std::min(endChunk, m_chunks.size()); ++chunkIndex)
+		{
+			Chunk &chunk = *m_chunks[chunkIndex];
+			if (chunk.numActive == 0)
+				continue;
+
+			for (std::size_t index = 0; index < kCHUNK_SIZE; ++index)
+			{
+				if (chunk.isActive.test(index))
+					func(*chunk.GetSlot(index));
+			}
+		}
+	}
+
+	template <typename ComponentType>
+	template <typename Func>
+	void ComponentPool<ComponentType>::ForEachChangedSince(ChangeVersion version, Func &&func)
+	{
+		if (m_changeVersion.load(std::memory_order_relaxed) <= version)
+			return;
+
+		for (auto &pChunk : m_chunks)
+		{
+			if (pChunk->changeVersion <= version)
+				continue;
+
+			for (std::size_t index = 0; index < kCHUNK_SIZE; ++index)
+			{
+				// Freed and parked slots are reset to 0, which is never newer than VERSION
+				if (pChunk->slotVersions[index] > version)
+					func(*pChunk->GetSlot(index));
+			}
+		}
+	}
+
+	template <typename ComponentType>
+	void ComponentPool<ComponentType>::VDispatchChanges(void)
+	{
+		for (auto &pChunk : m_chunks)
+		{
+			for (std::size_t wordIndex = 0; wordIndex < pChunk->changedWords.size(); ++wordIndex)
+			{
+				// Clear first: VOnChanged() may mark the component again for the next dispatch
+				std::uint64_t word = std::exchange(pChunk->changedWords[wordIndex], 0);
+				while (word != 0)
+				{
+					const auto kBit = static_cast<std::size_t>(std::countr_zero(word));
+					word &= word - 1;
+					pChunk->GetSlot(wordIndex * 64 + kBit)->DispatchChange();
+				}
+			}
+		}
+	}
+
+	template <typename ComponentType>
+	void ComponentPool<ComponentType>::VSetParked(std::uint32_t slot, bool isParked)
+	{
+		Chunk &chunk = *m_chunks[slot / kCHUNK_SIZE];
+		const std::size_t kIndex = slot % kCHUNK_SIZE;
+		BGE_ASSERT(chunk.isLive.test(kIndex));
+		if (chunk.isActive.test(kIndex) != isParked)
+			return;
+
+		chunk.isActive.set(kIndex, !isParked);
+		if (isParked)
+		{
+			// Forget pending changes so neither dispatch nor change queries see the slot
+			--chunk.numActive;
+			chunk.changedWords[kIndex / 64] &= ~(std::uint64_t(1) << (kIndex % 64));
+			chunk.slotVersions[kIndex] = 0;
+		}
+		else
+			++chunk.numActive;
+	}
+
+	template <typename ComponentType>
+	void ComponentPool<ComponentType>::Destroy(std::uint32_t slot)
+	{
+		Chunk &chunk = *m_chunks[slot / kCHUNK_SIZE];
+		const std::size_t kIndex = slot % kCHUNK_SIZE;
+		BGE_ASSERT(chunk.isLive.test(kIndex));
+		std::destroy_at(chunk.GetSlot(kIndex));
+		if (chunk.isActive.test(kIndex))
+			--chunk.numActive;
+		chunk.isLive.reset(kIndex);
+		chunk.isActive.reset(kIndex);
+		chunk.changedWords[kIndex / 64] &= ~(std::uint64_t(1) << (kIndex % 64));
+		chunk.slotVersions[kIndex] = 0;
+		--chunk.numLive;
+		--m_size;
+		m_freeSlots.push_back(slot);
+	}
+
+	template <typename ComponentType>
+	ComponentPool<ComponentType> &ComponentStore::GetPool(void)
+	{
+		const std::type_index kType(typeid(ComponentType));
+		auto findIter = m_poolsByType.find(kType);
+		if (findIter == m_poolsByType.end())
+		{
+			m_pools.push_back(std::make_unique<ComponentPool<ComponentType>>());
+			findIter = m_poolsByType.emplace(kType, m_pools.back().get()).first;
+		}
+		return static_cast<ComponentPool<ComponentType> &>(*findIter->second);
+	}
+} // End namespace (BGE)
+
+#endif /* !_BGE_COMPONENTSTORE_HPP_ */
@@ -0,0 +1,148 @@
+/*=============================================================================*
+ * SystemScheduler.cpp - Parallel system updates ordered by component access.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "SystemScheduler.hpp"
+
+namespace
+{
+	bool Intersects(const std::vector<BGE::ActorComponentID> &lhs, const std::vector<BGE::ActorComponentID> &rhs)
+	{
+		// Access sets hold a handful of IDs, so a nested scan is fine
+		return std::any_of(lhs.begin(), lhs.end(), [&rhs](BGE::ActorComponentID cID)
+		{
+			return std::find(rhs.begin(), rhs.end(), cID) != rhs.end();
+		});
+	}
+} // End anonymous namespace
+
+bool BGE::SystemAccess::ConflictsWith(const SystemAccess &other) const
+{
+	return Intersects(writes, other.writes) || Intersects(writes, other.reads) || Intersects(reads, other.writes);
+}
+
+BGE::SystemScheduler::SystemScheduler(void)
+	: m_isScheduleDirty(false)
+{
+}
+
+void BGE::SystemScheduler::AddSystem(UniqueISystemPtr pSystem)
+{
+	BGE_ASSERT(pSystem);
+	m_systems.push_back(std::move(pSystem));
+	m_isScheduleDirty = true;
+}
+
+bool BGE::SystemScheduler::RemoveSystem(std::string_view name)
+{
+	const auto kFindIter = std::find_if(m_systems.begin(), m_systems.end(),
+										[name](const UniqueISystemPtr &pSystem) { return pSystem->VGetName() == name; });
+	if (kFindIter == m_systems.end())
+		return false;
+
+	m_systems.erase(kFindIter);
+	m_isScheduleDirty = true;
+	return true;
+}
+
+void BGE::SystemScheduler::Update(JobSystem &jobs, float deltaTime)
+{
+	if (m_isScheduleDirty)
+		BuildSchedule();
+
+	for (const auto &kStage : m_stages)
+	{
+		const ChangeVersion kVersion = ActorComponent::AdvanceVersion();
+		if (kStage.size() == 1)
+		{
+			m_systems[kStage.front()]->VUpdate(jobs, deltaTime);
+		}
+		else
+		{
+			jobs.ParallelFor(kStage.size(), 1, [this, &kStage, &jobs, deltaTime](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t index = begin; index < end; ++index)
+					m_systems[kStage[index]]->VUpdate(jobs, deltaTime);
+			});
+		}
+
+		for (const std::size_t kSystem : kStage)
+			m_systems[kSystem]->m_lastRunVersion = kVersion;
+	}
+	// Changes made outside the scheduler until the next update must look newer still
+	ActorComponent::AdvanceVersion();
+}
+
+std::size_t BGE::SystemScheduler::GetNumStages(void)
+{
+	if (m_isScheduleDirty)
+		BuildSchedule();
+	return m_stages.size();
+}
+
+void BGE::SystemScheduler::LogSchedule(void)
+{
+	if (m_isScheduleDirty)
+		BuildSchedule();
+
+	for (std::size_t stageIndex = 0; stageIndex < m_stages.size(); ++stageIndex)
+	{
+		std::string names;
+		for (const std::size_t kSystem : m_stages[stageIndex])
+		{
+			if (!names.empty())
+				names += ", ";
+			names += m_systems[kSystem]->VGetName();
+		}
+		BGE_INFO("System stage %zu: %s", stageIndex, names.c_str());
+	}
+}
+
+void BGE::SystemScheduler::BuildSchedule(void)
+{
+	std::vector<SystemAccess> access;
+	access.reserve(m_systems.size());
+	for (const auto &pSystem : m_systems)
+		access.push_back(pSystem->VGetAccess());
+	// Each system's stage is one past the latest earlier system it depends on
+	std::vector<std::size_t> stageOf(m_systems.size(), 0);
+	std::size_t numStages = 0;
+	for (std::size_t index = 0; index < m_systems.size(); ++index)
+	{
+		for (std::size_t prevIndex = 0; prevIndex < index; ++prevIndex)
+		{
+			if (access[index].ConflictsWith(access[prevIndex]))
+				stageOf[index] = std::max(stageOf[index], stageOf[prevIndex] + 1);
+		}
+		numStages = std::max(numStages, stageOf[index] + 1);
+	}
+
+	m_stages.assign(numStages, {});
+	for (std::size_t index = 0; index < m_systems.size(); ++index)
+		m_stages[stageOf[index]].push_back(index);
+	m_isScheduleDirty = false;
+}
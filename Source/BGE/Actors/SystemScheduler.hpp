@@ -0,0 +1,135 @@
+/*=============================================================================*
+ * SystemScheduler.hpp - Parallel system updates ordered by component access.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_SYSTEMSCHEDULER_HPP_
+#define _BGE_SYSTEMSCHEDULER_HPP_
+
+#include "Actors/ComponentStore.hpp"
+#include "Multicore/JobSystem.hpp"
+
+namespace BGE
+{
+	// Component types a system reads and writes.
+	struct SystemAccess
+	{
+		std::vector<ActorComponentID> reads;
+		std::vector<ActorComponentID> writes;
+
+		template <IdentifiedComponent... ComponentTypes>
+		SystemAccess &Read(void) { (reads.push_back(ComponentTypes::kID), ...); return *this; }
+		template <IdentifiedComponent... ComponentTypes>
+		SystemAccess &Write(void) { (writes.push_back(ComponentTypes::kID), ...); return *this; }
+		// True if either side writes a component type the other reads or writes.
+		bool ConflictsWith(const SystemAccess &other) const;
+	};
+	/**
+	 * A system updates components of one or more types each frame. Its access set
+	 * must name every component type VUpdate() touches; the scheduler relies on it
+	 * to run systems side by side.
+	 */
+	class ISystem
+	{
+		friend class SystemScheduler;
+
+		ChangeVersion m_lastRunVersion = 0;
+	public:
+		virtual ~ISystem(void) = default;
+		virtual std::string_view VGetName(void) const = 0;
+		virtual SystemAccess VGetAccess(void) const = 0;
+		// JOBS may be used to split the system's own work across threads.
+		virtual void VUpdate(JobSystem &jobs, float deltaTime) = 0;
+		// Change version of the previous run; pass it to ForEachChangedSince() to visit
+		// only components changed since then. 0 before the first run.
+		ChangeVersion GetLastRunVersion(void) const noexcept { return m_lastRunVersion; }
+	};
+	BGE_DECLARE_PTR(ISystem);
+	/**
+	 * Runs ComponentType::VUpdate() for every component in a pool, a few pool chunks
+	 * per job. The pool is taken over from ComponentStore::UpdateAll() while the
+	 * system exists. Each VUpdate() may only modify its own component.
+	 */
+	template <IdentifiedComponent ComponentType>
+	class PooledUpdateSystem final : public ISystem
+	{
+		ComponentPool<ComponentType> &m_pool;
+		SystemAccess m_access;
+		std::size_t m_chunksPerJob;
+	public:
+		// READS lists other component types the update reads.
+		explicit PooledUpdateSystem(ComponentPool<ComponentType> &pool, SystemAccess reads = {},
+									std::size_t chunksPerJob = 4)
+			: m_pool(pool), m_access(std::move(reads)), m_chunksPerJob(chunksPerJob)
+		{
+			m_access.template Write<ComponentType>();
+			m_pool.SetUpdatedBySystem(true);
+		}
+		virtual ~PooledUpdateSystem(void) override { m_pool.SetUpdatedBySystem(false); }
+
+		virtual std::string_view VGetName(void) const override { return ComponentType::kNAME; }
+		virtual SystemAccess VGetAccess(void) const override { return m_access; }
+		virtual void VUpdate(JobSystem &jobs, float deltaTime) override
+		{
+			jobs.ParallelFor(m_pool.GetNumChunks(), m_chunksPerJob,
+				[this, deltaTime](std::size_t firstChunk, std::size_t endChunk)
+				{
+					m_pool.ForEachInChunks(firstChunk, endChunk,
+						[deltaTime](ComponentType &component) { component.ComponentType::VUpdate(deltaTime); });
+				});
+		}
+	};
+	/**
+	 * SystemScheduler orders systems into stages from their access sets. A system
+	 * goes in the stage after the latest earlier-registered system it conflicts
+	 * with, so systems within a stage touch disjoint data and run in parallel.
+	 *
+	 * Every conflicting pair still runs in registration order, so the results match
+	 * a serial update in registration order no matter how the threads interleave.
+	 *
+	 * The change version advances before each stage and after the last, so changes
+	 * made by a stage are newer than the last run of every system that may read them.
+	 */
+	class SystemScheduler : public INonCopyable
+	{
+		std::vector<UniqueISystemPtr> m_systems; // Registration order
+		std::vector<std::vector<std::size_t>> m_stages; // Indices into m_systems
+		bool m_isScheduleDirty;
+	public:
+		SystemScheduler(void);
+
+		void AddSystem(UniqueISystemPtr pSystem);
+		// Destroys the system; false if no system has NAME.
+		bool RemoveSystem(std::string_view name);
+		void Update(JobSystem &jobs, float deltaTime);
+		std::size_t GetNumSystems(void) const { return m_systems.size(); }
+		std::size_t GetNumStages(void);
+		void LogSchedule(void);
+	private:
+		void BuildSchedule(void);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_SYSTEMSCHEDULER_HPP_ */
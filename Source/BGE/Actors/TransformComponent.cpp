@@ -0,0 +1,181 @@
+/*=============================================================================*
+ * TransformComponent.cpp - Actor component placing its owner in a TransformHierarchy.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "TransformComponent.hpp"
+#include "ActorArchetype.hpp"
+
+BGE::TransformComponent::TransformComponent(TransformHierarchy &hierarchy)
+	: m_hierarchy(hierarchy),
+	  m_handle(hierarchy.Add(Math::Mat4x4f::Identity())),
+	  m_parentHandle(kINVALID_TRANSFORM_HANDLE),
+	  m_parentID(kINVALID_ACTOR_ID)
+{
+}
+
+BGE::TransformComponent::~TransformComponent(void)
+{
+	m_hierarchy.Remove(m_handle);
+}
+
+bool BGE::TransformComponent::VInit(tinyxml2::XMLElement *pData)
+{
+	Math::Vec3f position(0.0f), scale(1.0f);
+	Math::Quatf rotation;
+	pData->QueryFloatAttribute("x", &position.x);
+	pData->QueryFloatAttribute("y", &position.y);
+	pData->QueryFloatAttribute("z", &position.z);
+	pData->QueryFloatAttribute("rx", &rotation.x);
+	pData->QueryFloatAttribute("ry", &rotation.y);
+	pData->QueryFloatAttribute("rz", &rotation.z);
+	pData->QueryFloatAttribute("rw", &rotation.w);
+	pData->QueryFloatAttribute("sx", &scale.x);
+	pData->QueryFloatAttribute("sy", &scale.y);
+	pData->QueryFloatAttribute("sz", &scale.z);
+	m_hierarchy.SetLocal(m_handle, Math::Mat4x4f::FromTRS(position, rotation, scale));
+	return true;
+}
+
+tinyxml2::XMLElement *BGE::TransformComponent::VGenerateXML(tinyxml2::XMLDocument &doc)
+{
+	// Decompose the local matrix back into the attributes VInit() reads; assumes no shear
+	const Math::Mat4x4f &kLocal = GetLocal();
+	const Math::Vec3f kPosition = kLocal.GetTranslation();
+	float scale[3];
+	float rotation[3][3];
+	for (int column = 0; column < 3; ++column)
+	{
+		scale[column] = Math::Vec3f(kLocal(0, column), kLocal(1, column), kLocal(2, column)).Magnitude();
+		const float kInvScale = (scale[column] != 0.0f) ? 1.0f / scale[column] : 0.0f;
+		for (int row = 0; row < 3; ++row)
+			rotation[row][column] = kLocal(row, column) * kInvScale;
+	}
+
+	Math::Quatf quat;
+	const float kTrace = rotation[0][0] + rotation[1][1] + rotation[2][2];
+	if (kTrace > 0.0f)
+	{
+		const float kS = std::sqrt(kTrace + 1.0f) * 2.0f;
+		quat = Math::Quatf((rotation[2][1] - rotation[1][2]) / kS, (rotation[0][2] - rotation[2][0]) / kS,
+						   (rotation[1][0] - rotation[0][1]) / kS, 0.25f * kS);
+	}
+	else if (rotation[0][0] > rotation[1][1] && rotation[0][0] > rotation[2][2])
+	{
+		const float kS = std::sqrt(1.0f + rotation[0][0] - rotation[1][1] - rotation[2][2]) * 2.0f;
+		quat = Math::Quatf(0.25f * kS, (rotation[0][1] + rotation[1][0]) / kS,
+						   (rotation[0][2] + rotation[2][0]) / kS, (rotation[2][1] - rotation[1][2]) / kS);
+	}
+	else if (rotation[1][1] > rotation[2][2])
+	{
+		const float kS = std::sqrt(1.0f + rotation[1][1] - rotation[0][0] - rotation[2][2]) * 2.0f;
+		quat = Math::Quatf((rotation[0][1] + rotation[1][0]) / kS, 0.25f * kS,
+						   (rotation[1][2] + rotation[2][1]) / kS, (rotation[0][2] - rotation[2][0]) / kS);
+	}
+	else
+	{
+		const float kS = std::sqrt(1.0f + rotation[2][2] - rotation[0][0] - rotation[1][1]) * 2.0f;
+		quat = Math::Quatf((rotation[0][2] + rotation[2][0]) / kS, (rotation[1][2] + rotation[2][1]) / kS,
+						   0.25f * kS, (rotation[1][0] - rotation[0][1]) / kS);
+	}
+
+	tinyxml2::XMLElement *pElem = doc.NewElement(kNAME.data());
+	pElem->SetAttribute("x", kPosition.x);
+	pElem->SetAttribute("y", kPosition.y);
+	pElem->SetAttribute("z", kPosition.z);
+	pElem->SetAttribute("rx", quat.x);
+	pElem->SetAttribute("ry", quat.y);
+	pElem->SetAttribute("rz", quat.z);
+	pElem->SetAttribute("rw", quat.w);
+	pElem->SetAttribute("sx", scale[0]);
+	pElem->SetAttribute("sy", scale[1]);
+	pElem->SetAttribute("sz", scale[2]);
+	return pElem;
+}
+
+bool BGE::TransformComponent::VWriteBlob(BlobWriter &writer) const
+{
+	writer.Write(GetLocal().AsArray());
+	writer.Write(GetParentID());
+	return true;
+}
+
+bool BGE::TransformComponent::VInitFromBlob(BlobReader &reader)
+{
+	Math::Mat4x4f::TypeArray elements;
+	ActorID parentID;
+	if (!reader.Read(elements) || !reader.Read(parentID))
+		return false;
+	m_hierarchy.SetLocal(m_handle, Math::Mat4x4f(elements));
+	// Linked later, once the parent's actor exists
+	m_parentHandle = kINVALID_TRANSFORM_HANDLE;
+	m_parentID = parentID;
+	return true;
+}
+
+void BGE::TransformComponent::VOnRecycled(void)
+{
+	SetParent(nullptr);
+	m_hierarchy.DetachChildren(m_handle);
+}
+
+void BGE::TransformComponent::SetLocal(const Math::Mat4x4f &local)
+{
+	m_hierarchy.SetLocal(m_handle, local);
+	MarkChanged();
+}
+
+bool BGE::TransformComponent::SetParent(const TransformComponent *pParent)
+{
+	BGE_ASSERT(pParent == nullptr || &pParent->m_hierarchy == &m_hierarchy);
+	const TransformHandle kParentHandle = (pParent != nullptr) ? pParent->m_handle : kINVALID_TRANSFORM_HANDLE;
+	if (!m_hierarchy.SetParent(m_handle, kParentHandle))
+		return false;
+	m_parentHandle = kParentHandle;
+	m_parentID = (pParent != nullptr && pParent->m_pOwner) ? pParent->m_pOwner->GetID() : kINVALID_ACTOR_ID;
+	return true;
+}
+
+bool BGE::TransformComponent::LinkBlobParent(const ActorMap &actors)
+{
+	if (m_parentHandle != kINVALID_TRANSFORM_HANDLE || m_parentID == kINVALID_ACTOR_ID)
+		return true;
+	const ActorID kParentID = m_parentID;
+	m_parentID = kINVALID_ACTOR_ID;
+	const auto kFindIter = actors.find(kParentID);
+	if (kFindIter == actors.end())
+		return false;
+	const auto pParent = kFindIter->second->GetComponent<TransformComponent>().lock();
+	return pParent && SetParent(pParent.get());
+}
+
+BGE::ActorID BGE::TransformComponent::GetParentID(void) const
+{
+	// The hierarchy forgets removed parents, and may have been reparented directly
+	if (m_parentHandle == kINVALID_TRANSFORM_HANDLE || m_hierarchy.GetParent(m_handle) != m_parentHandle)
+		return kINVALID_ACTOR_ID;
+	return m_parentID;
+}
@@ -0,0 +1,80 @@
+/*=============================================================================*
+ * TransformComponent.hpp - Actor component placing its owner in a TransformHierarchy.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_TRANSFORMCOMPONENT_HPP_
+#define _BGE_TRANSFORMCOMPONENT_HPP_
+
+#include "ActorComponent.hpp"
+#include "TransformHierarchy.hpp"
+
+namespace BGE
+{
+	/**
+	 * TransformComponent owns one node of a TransformHierarchy for the lifetime of
+	 * the component. World matrices are those of the hierarchy's last Update().
+	 *
+	 * XML: <TransformComponent x="" y="" z="" rx="" ry="" rz="" rw="" sx="" sy="" sz=""/>
+	 * with position, rotation quaternion and scale; missing attributes keep identity.
+	 *
+	 * Blobs hold the local matrix and the ActorID of the parent set through
+	 * SetParent(). Reading one only records that ID; whoever loads the actors links
+	 * the parent once it exists (see BaseGameLogic::LoadActors()).
+	 */
+	class TransformComponent final : public ActorComponent
+	{
+		BGE_ACTOR_COMPONENT(TransformComponent)
+	private:
+		TransformHierarchy &m_hierarchy;
+		TransformHandle m_handle;
+		TransformHandle m_parentHandle; // As of the last SetParent()
+		ActorID m_parentID; // Owner of m_parentHandle, or the unlinked parent read from a blob
+	public:
+		explicit TransformComponent(TransformHierarchy &hierarchy);
+		virtual ~TransformComponent(void);
+
+		virtual bool VInit(tinyxml2::XMLElement *pData) override;
+		virtual tinyxml2::XMLElement *VGenerateXML(tinyxml2::XMLDocument &doc) override;
+		virtual bool VWriteBlob(BlobWriter &writer) const override;
+		virtual bool VInitFromBlob(BlobReader &reader) override;
+		// Parked actors must not drag their old parent or children along when reused
+		virtual void VOnRecycled(void) override;
+
+		void SetLocal(const Math::Mat4x4f &local);
+		const Math::Mat4x4f &GetLocal(void) const { return m_hierarchy.GetLocal(m_handle); }
+		const Math::Mat4x4f &GetWorld(void) const { return m_hierarchy.GetWorld(m_handle); }
+		// Attach below PPARENT, or make this a root if nullptr. False if that would create a cycle.
+		bool SetParent(const TransformComponent *pParent);
+		TransformHandle GetHandle(void) const noexcept { return m_handle; }
+		// Owner of the parent set through SetParent(), kINVALID_ACTOR_ID if none or reparented since.
+		ActorID GetParentID(void) const;
+		// Attach below the parent named by the last blob read, looked up in ACTORS. True if
+		// there was none to link; false if it is missing or has no TransformComponent.
+		bool LinkBlobParent(const ActorMap &actors);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_TRANSFORMCOMPONENT_HPP_ */
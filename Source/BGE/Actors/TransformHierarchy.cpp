@@ -0,0 +1,244 @@
+/*=============================================================================*
+ * TransformHierarchy.cpp - Flat parent/child transform hierarchy.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "TransformHierarchy.hpp"
+
+BGE::TransformHierarchy::TransformHierarchy(void)
+	: m_firstDirty(0),
+	  m_numRemoved(0),
+	  m_isOrderDirty(false)
+{
+}
+
+BGE::TransformHandle BGE::TransformHierarchy::Add(const Math::Mat4x4f &local, TransformHandle parent)
+{
+	BGE_ASSERT(parent == kINVALID_TRANSFORM_HANDLE || IsValid(parent));
+	TransformHandle handle;
+	if (m_freeHandles.empty())
+	{
+		handle = static_cast<TransformHandle>(m_indices.size());
+		m_indices.push_back(kNO_INDEX);
+	}
+	else
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	// Appending keeps parents before children
+	const auto kIndex = static_cast<std::uint32_t>(m_handles.size());
+	m_indices[handle] = kIndex;
+	m_locals.push_back(local);
+	m_worlds.push_back(local);
+	m_parents.push_back((parent != kINVALID_TRANSFORM_HANDLE) ? m_indices[parent] : kNO_INDEX);
+	m_isDirty.push_back(0);
+	m_numChildren.push_back(0);
+	if (parent != kINVALID_TRANSFORM_HANDLE)
+		++m_numChildren[m_indices[parent]];
+	m_handles.push_back(handle);
+	MarkDirty(kIndex);
+	return handle;
+}
+
+void BGE::TransformHierarchy::Remove(TransformHandle handle)
+{
+	BGE_ASSERT(IsValid(handle));
+	// The node keeps its slot until Reorder(); children notice the removal there
+	const std::uint32_t kIndex = m_indices[handle];
+	if (m_parents[kIndex] != kNO_INDEX)
+		--m_numChildren[m_parents[kIndex]];
+	m_handles[kIndex] = kINVALID_TRANSFORM_HANDLE;
+	m_indices[handle] = kNO_INDEX;
+	m_freeHandles.push_back(handle);
+	++m_numRemoved;
+	m_isOrderDirty = true;
+}
+
+bool BGE::TransformHierarchy::SetParent(TransformHandle handle, TransformHandle parent)
+{
+	BGE_ASSERT(IsValid(handle) && (parent == kINVALID_TRANSFORM_HANDLE || IsValid(parent)));
+	const std::uint32_t kIndex = m_indices[handle];
+	const std::uint32_t kParentIndex = (parent != kINVALID_TRANSFORM_HANDLE) ? m_indices[parent] : kNO_INDEX;
+	// Walk up from the new parent; meeting HANDLE means it would become its own ancestor
+	for (std::uint32_t ancestor = kParentIndex; ancestor != kNO_INDEX; ancestor = m_parents[ancestor])
+	{
+		if (ancestor == kIndex)
+			return false;
+	}
+
+	if (m_parents[kIndex] != kNO_INDEX)
+		--m_numChildren[m_parents[kIndex]];
+	if (kParentIndex != kNO_INDEX)
+		++m_numChildren[kParentIndex];
+	m_parents[kIndex] = kParentIndex;
+	if (kParentIndex != kNO_INDEX && kParentIndex > kIndex)
+		m_isOrderDirty = true;
+	MarkDirty(kIndex);
+	return true;
+}
+
+BGE::TransformHandle BGE::TransformHierarchy::GetParent(TransformHandle handle) const
+{
+	const std::uint32_t kParentIndex = m_parents[m_indices[handle]];
+	return (kParentIndex != kNO_INDEX) ? m_handles[kParentIndex] : kINVALID_TRANSFORM_HANDLE;
+}
+
+void BGE::TransformHierarchy::DetachChildren(TransformHandle handle)
+{
+	BGE_ASSERT(IsValid(handle));
+	const std::uint32_t kIndex = m_indices[handle];
+	// Children follow their parent unless the order is pending a Reorder()
+	std::size_t index = (m_isOrderDirty) ? 0 : kIndex + 1;
+	for (; m_numChildren[kIndex] > 0 && index < m_parents.size(); ++index)
+	{
+		if (m_parents[index] != kIndex || m_handles[index] == kINVALID_TRANSFORM_HANDLE)
+			continue;
+		// Roots never break the parent-before-child order
+		m_parents[index] = kNO_INDEX;
+		--m_numChildren[kIndex];
+		MarkDirty(static_cast<std::uint32_t>(index));
+	}
+	BGE_ASSERT(m_numChildren[kIndex] == 0);
+}
+
+void BGE::TransformHierarchy::SetLocal(TransformHandle handle, const Math::Mat4x4f &local)
+{
+	const std::uint32_t kIndex = m_indices[handle];
+	m_locals[kIndex] = local;
+	MarkDirty(kIndex);
+}
+
+std::size_t BGE::TransformHierarchy::Update(void)
+{
+	if (m_isOrderDirty)
+		Reorder();
+
+	m_updatedHandles.clear();
+	const std::size_t kNumNodes = m_handles.size();
+	for (std::size_t index = m_firstDirty; index < kNumNodes; ++index)
+	{
+		const std::uint32_t kParent = m_parents[index];
+		// Parents come first, so their flag is final by the time a child is visited
+		if (kParent != kNO_INDEX && m_isDirty[kParent])
+			m_isDirty[index] = 1;
+		if (!m_isDirty[index])
+			continue;
+
+		if (kParent == kNO_INDEX)
+			m_worlds[index] = m_locals[index];
+		else
+			Math::Mat4x4f::Multiply(m_worlds[kParent], m_locals[index], m_worlds[index]);
+		m_updatedHandles.push_back(m_handles[index]);
+	}
+
+	if (m_firstDirty < kNumNodes)
+		std::fill(m_isDirty.begin() + m_firstDirty, m_isDirty.end(), std::uint8_t(0));
+	m_firstDirty = kNumNodes;
+	return m_updatedHandles.size();
+}
+
+void BGE::TransformHierarchy::Reorder(void)
+{
+	const std::size_t kNumNodes = m_handles.size();
+	// Removed parents leave their children as roots
+	for (std::size_t index = 0; index < kNumNodes; ++index)
+	{
+		const std::uint32_t kParent = m_parents[index];
+		if (kParent != kNO_INDEX && m_handles[kParent] == kINVALID_TRANSFORM_HANDLE)
+		{
+			m_parents[index] = kNO_INDEX;
+			m_isDirty[index] = 1;
+		}
+	}
+	// Depth of every node, walking up to the nearest ancestor with a known depth
+	constexpr std::uint32_t kUNKNOWN = 0xFFFFFFFF;
+	std::vector<std::uint32_t> depths(kNumNodes, kUNKNOWN);
+	std::vector<std::uint32_t> chain;
+	std::uint32_t maxDepth = 0;
+	for (std::size_t index = 0; index < kNumNodes; ++index)
+	{
+		auto node = static_cast<std::uint32_t>(index);
+		while (depths[node] == kUNKNOWN && m_parents[node] != kNO_INDEX)
+		{
+			chain.push_back(node);
+			node = m_parents[node];
+		}
+		std::uint32_t depth = (depths[node] != kUNKNOWN) ? depths[node] : (depths[node] = 0);
+		while (!chain.empty())
+		{
+			depths[chain.back()] = ++depth;
+			chain.pop_back();
+		}
+		maxDepth = std::max(maxDepth, depths[index]);
+	}
+	// Counting sort by depth, stable so siblings keep their relative order
+	std::vector<std::uint32_t> depthStarts(maxDepth + 2, 0);
+	for (std::size_t index = 0; index < kNumNodes; ++index)
+	{
+		if (m_handles[index] != kINVALID_TRANSFORM_HANDLE)
+			++depthStarts[depths[index] + 1];
+	}
+	std::partial_sum(depthStarts.begin(), depthStarts.end(), depthStarts.begin());
+
+	const std::size_t kNumLive = kNumNodes - m_numRemoved;
+	std::vector<std::uint32_t> newIndices(kNumNodes, kNO_INDEX);
+	for (std::size_t index = 0; index < kNumNodes; ++index)
+	{
+		if (m_handles[index] != kINVALID_TRANSFORM_HANDLE)
+			newIndices[index] = depthStarts[depths[index]]++;
+	}
+
+	std::vector<Math::Mat4x4f> locals(kNumLive), worlds(kNumLive);
+	std::vector<std::uint32_t> parents(kNumLive);
+	std::vector<std::uint8_t> isDirty(kNumLive);
+	std::vector<TransformHandle> handles(kNumLive);
+	std::vector<std::uint32_t> numChildren(kNumLive);
+	for (std::size_t index = 0; index < kNumNodes; ++index)
+	{
+		const std::uint32_t kNewIndex = newIndices[index];
+		if (kNewIndex == kNO_INDEX)
+			continue;
+		const std::uint32_t kParent = m_parents[index];
+		locals[kNewIndex] = m_locals[index];
+		worlds[kNewIndex] = m_worlds[index];
+		parents[kNewIndex] = (kParent != kNO_INDEX) ? newIndices[kParent] : kNO_INDEX;
+		isDirty[kNewIndex] = m_isDirty[index];
+		numChildren[kNewIndex] = m_numChildren[index];
+		handles[kNewIndex] = m_handles[index];
+		m_indices[m_handles[index]] = kNewIndex;
+	}
+
+	m_locals = std::move(locals);
+	m_worlds = std::move(worlds);
+	m_parents = std::move(parents);
+	m_isDirty = std::move(isDirty);
+	m_handles = std::move(handles);
+	m_numChildren = std::move(numChildren);
+	m_numRemoved = 0;
+	m_firstDirty = 0;
+	m_isOrderDirty = false;
+}
@@ -0,0 +1,101 @@
+/*=============================================================================*
+ * TransformHierarchy.hpp - Flat parent/child transform hierarchy.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_TRANSFORMHIERARCHY_HPP_
+#define _BGE_TRANSFORMHIERARCHY_HPP_
+
+namespace BGE
+{
+	// Stable reference to a node in a TransformHierarchy.
+	using TransformHandle = std::uint32_t;
+	inline constexpr TransformHandle kINVALID_TRANSFORM_HANDLE = 0xFFFFFFFF;
+	/**
+	 * TransformHierarchy keeps local and world matrices of every node in flat arrays
+	 * ordered so that each parent comes before its children. Update() then needs a
+	 * single forward pass: a node is recomputed only if its own local matrix changed
+	 * or its parent was recomputed, so untouched subtrees cost one flag test each.
+	 *
+	 * New nodes are appended, which keeps the order valid. Reparenting or removing
+	 * nodes sorts the arrays by depth again at the next Update(). Handles stay
+	 * valid across reordering.
+	 */
+	class TransformHierarchy : public INonCopyable
+	{
+		static constexpr std::uint32_t kNO_INDEX = 0xFFFFFFFF;
+
+		// Per node, in parent-before-child order:
+		std::vector<Math::Mat4x4f> m_locals;
+		std::vector<Math::Mat4x4f> m_worlds; // As of the last Update()
+		std::vector<std::uint32_t> m_parents; // Parent's index, or kNO_INDEX for roots
+		std::vector<std::uint8_t> m_isDirty; // Local matrix changed since the last Update()
+		std::vector<std::uint32_t> m_numChildren; // Live children, so leaves detach in constant time
+		std::vector<TransformHandle> m_handles; // kINVALID_TRANSFORM_HANDLE once removed
+		// Per handle:
+		std::vector<std::uint32_t> m_indices; // Node index, or kNO_INDEX if free
+		std::vector<TransformHandle> m_freeHandles;
+		std::vector<TransformHandle> m_updatedHandles; // Recomputed by the last Update()
+		std::size_t m_firstDirty; // Nodes before this index are clean
+		std::size_t m_numRemoved; // Removed nodes still occupying an index
+		bool m_isOrderDirty; // Parent-before-child order may be broken
+	public:
+		TransformHierarchy(void);
+
+		TransformHandle Add(const Math::Mat4x4f &local, TransformHandle parent = kINVALID_TRANSFORM_HANDLE);
+		// Children of HANDLE become roots, keeping their local matrices.
+		void Remove(TransformHandle handle);
+		// PARENT may be kINVALID_TRANSFORM_HANDLE to make HANDLE a root. False if that
+		// would create a cycle.
+		bool SetParent(TransformHandle handle, TransformHandle parent);
+		TransformHandle GetParent(TransformHandle handle) const;
+		// Children of HANDLE become roots, keeping their local matrices. Free for leaves;
+		// otherwise scans the nodes after HANDLE until every child is found.
+		void DetachChildren(TransformHandle handle);
+		void SetLocal(TransformHandle handle, const Math::Mat4x4f &local);
+		const Math::Mat4x4f &GetLocal(TransformHandle handle) const { return m_locals[m_indices[handle]]; }
+		const Math::Mat4x4f &GetWorld(TransformHandle handle) const { return m_worlds[m_indices[handle]]; }
+		bool IsValid(TransformHandle handle) const
+		{
+			return handle < m_indices.size() && m_indices[handle] != kNO_INDEX;
+		}
+		// Recompute world matrices of changed nodes and their descendants. Returns the
+		// number of nodes recomputed.
+		std::size_t Update(void);
+		// Nodes whose world matrix the last Update() recomputed, for incremental consumers.
+		std::span<const TransformHandle> GetUpdatedHandles(void) const { return m_updatedHandles; }
+		std::size_t GetSize(void) const noexcept { return m_handles.size() - m_numRemoved; }
+	private:
+		void MarkDirty(std::uint32_t index)
+		{
+			m_isDirty[index] = 1;
+			m_firstDirty = std::min<std::size_t>(m_firstDirty, index);
+		}
+		// Drop removed nodes and sort the rest by depth.
+		void Reorder(void);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_TRANSFORMHIERARCHY_HPP_ */
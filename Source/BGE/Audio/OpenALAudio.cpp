@@ -2,3 +2,49 @@
 #include "Audio.hpp"
 #include "OpenALAudio.hpp"
 
+
+BGE::Audio::Audio(void)
+	: m_pDevice(nullptr),
+	  m_pContext(nullptr),
+	  m_allPaused(false)
+{
+}
+
+BGE::Audio::~Audio(void)
+{
+	VShutdown();
+}
+
+bool BGE::Audio::VInitialize(void)
+{
+	// Opening the device is slow on some backends, so don't reopen it
+	if (VActive())
+		return true;
+
+	m_pDevice = alcOpenDevice(nullptr); // Default output device
+	if (!m_pDevice)
+		return false;
+
+	m_pContext = alcCreateContext(m_pDevice, nullptr);
+	if (!m_pContext || !alcMakeContextCurrent(m_pContext))
+	{
+		VShutdown();
+		return false;
+	}
+	return true;
+}
+
+void BGE::Audio::VShutdown(void)
+{
+	alcMakeContextCurrent(nullptr);
+	if (m_pContext)
+	{
+		alcDestroyContext(m_pContext);
+		m_pContext = nullptr;
+	}
+	if (m_pDevice)
+	{
+		alcCloseDevice(m_pDevice);
+		m_pDevice = nullptr;
+	}
+}
@@ -12,7 +12,7 @@ namespace BGE
 		Audio(void);
 		~Audio(void);
 	
-		virtual bool VActive(void) { return false; }
+		virtual bool VActive(void) { return m_pDevice && m_pContext; }
 	
 		virtual IAudioListener *VInitAudioListener(void) { return nullptr; }
 		virtual void VReleaseAudioListener(void) { }
@@ -27,12 +27,13 @@ namespace BGE
 		virtual void VPauseAllSounds(void) { }
 		virtual void VResumeAllSounds(void) { }
 	
-		virtual bool VInitialize(void) { return false; }
-		virtual void VShutdown(void) { }
+		// Opens the default device; safe to call off the main thread.
+		virtual bool VInitialize(void);
+		virtual void VShutdown(void);
 	
-		ALCdevice *GetDevice(void) { return nullptr; }
-		ALCcontext *GetContext(void) { return nullptr; }
-		bool IsPaused(void) const { return false; }
+		ALCdevice *GetDevice(void) { return m_pDevice; }
+		ALCcontext *GetContext(void) { return m_pContext; }
+		bool IsPaused(void) const { return m_allPaused; }
 	};
 	
 	class AudioListener : public IAudioListener
@@ -39,6 +39,7 @@
 #include <sstream>
 #include <map>
 #include <list>
+#include <mutex>
 
 using namespace BGE;
 
@@ -61,6 +62,8 @@ private:
 	TagMap m_tags;
 	ErrorMessengerList m_errorMessengers;
 	// thread mutexes:
+	std::mutex m_tagsMutex;
+	std::mutex m_messengersMutex;
 public:
 	LogManager(void);
 	LogManager(const LogManager &) = delete;
@@ -213,7 +216,7 @@ LogManager::LogManager(void)
 LogManager::~LogManager(void)
 {
 	using Logger::ErrorMessenger;
-	// TODO: Implement thread safety.
+	std::lock_guard<std::mutex> lock(m_messengersMutex);
 	for (auto iter = m_errorMessengers.begin(); iter != m_errorMessengers.end(); ++iter)
 	{
 		ErrorMessenger *pMessenger = (*iter);
@@ -262,7 +265,7 @@ int LogManager::Write(std::string_view tagName, std::string_view msgFormat, ...)
 
 void LogManager::SetDisplayFlags(std::string_view tagName, std::uint8_t flags)
 {
-	// TODO: Implement thread safety.
+	std::lock_guard<std::mutex> lock(m_tagsMutex);
 	if (flags != 0)
 	{
 		auto resultIter = m_tags.find(std::string(tagName));
@@ -279,7 +282,8 @@ void LogManager::SetDisplayFlags(std::string_view tagName, std::uint8_t flags)
 
 void LogManager::AddErrorMessenger(Logger::ErrorMessenger *pMessenger)
 {
-	// TODO: Implement thread safety.
+	// Messengers are created lazily by BGE_ERROR, possibly on worker threads
+	std::lock_guard<std::mutex> lock(m_messengersMutex);
 	m_errorMessengers.push_back(pMessenger);
 }
 
@@ -29,12 +29,19 @@
 #include "BGUT.hpp"
 
 #include "Graphics/Debug.hpp"
+#include "Input/InputEventQueue.hpp"
+#include "MainLoop/QualityGovernor.hpp"
+#include "MainLoop/RenderPipeline.hpp"
+#include "MainLoop/Replay.hpp"
+#include "MainLoop/StartupProfiler.hpp"
 #include "Utilities/Utils.hpp"
 
 #include "imgui_impl_sdl2.h"
 #include "imgui_impl_opengl3.h"
 
+#include <atomic>
 #include <cstdlib>
+#include <thread>
 
 namespace BGE
 {
@@ -58,18 +65,71 @@ namespace BGE
 		bool fullscreenEnabled = false;
 		bool verticalSyncEnabled = false;
 		int multisamplingLevel = 0;
+		bool rendererMultisamplingEnabled = false; // MSAA goes to the renderer's target, not the window
 		bool imGuiEnabled = false;
-		bool isRunning = false;
+		bool headlessEnabled = false; // No window, OpenGL context, or ImGui
+		std::atomic<bool> isRunning = false; // Cleared from the update thread when pipelined
+		bool pipelineEnabled = false; // Update on a worker thread while rendering
 		bool toLimitFrames = false;
 		Uint32 minFrames = 6;
+		bool fixedTimestepEnabled = false;
+		int fixedUpdateRate = 60; // Simulation steps per second
+		int maxStepsPerFrame = 5; // Max simulation steps before dropping time
+		struct StepState
+		{
+			double minStepMillis = 0.0;
+			double fixedStepMillis = 0.0;
+			int maxStepsPerFrame = 1;
+			double accumulatorMillis = 0.0; // Real time not yet simulated
+			double simulationMillis = 0.0; // Total simulated time
+			double elapsedMillis = 0.0; // Sum of frame deltas, so replays see the same clock
+			std::uint64_t frameIndex = 0;
+		} stepState; // Owned by whichever thread runs the update
+		std::uint64_t renderFrameIndex = 0;
+		double renderElapsedMillis = 0.0; // Advanced by the render phase only
 		Timer mainLoopTimer{};
-		BGUTUpdateCallback pUpdateCallback = nullptr;
-		BGUTRenderCallback pRenderCallback = nullptr;
-		BGUTEventHandlerCallback pEventHandlerCallback = nullptr;
-		int exitCode = BGE_EXIT_SUCCESS;
+		int targetFrameRate = 0; // Frame limiter rate (0 uses the display refresh rate)
+		FrameLimiter frameLimiter{};
+		InputEventQueue inputEventQueue{}; // Events received this frame, main thread only
+		std::thread::id mainThreadID{}; // Thread that called BGUTInit
+		bool qualityGovernorEnabled = false;
+		QualityGovernor qualityGovernor{}; // Adjusts registered knobs to hold the frame budget
+		Scheduler scheduler{}; // Subsystem tick functions
+		std::string recordFilename; // --record: capture frame times and events
+		std::string replayFilename; // --replay: feed a capture back in instead of SDL
+		std::string replayTimesFilename; // --replay-times: per-frame times measured during replay
+		ReplayRecorder replayRecorder{};
+		ReplayPlayer replayPlayer{};
+		// Systems wrapping the single callback setters
+		SchedulerHandle updateCallbackHandle = kINVALID_SCHEDULER_HANDLE;
+		SchedulerHandle renderCallbackHandle = kINVALID_SCHEDULER_HANDLE;
+		SchedulerHandle eventHandlerCallbackHandle = kINVALID_SCHEDULER_HANDLE;
+		BGUTSnapshotFactory pSnapshotFactory = nullptr;
+		BGUTSnapshotCallback pSnapshotCallback = nullptr;
+		BGUTRenderSnapshotCallback pRenderSnapshotCallback = nullptr;
+		std::atomic<int> exitCode = BGE_EXIT_SUCCESS;
 	};
 	
 	static bool BGUTParseConfig(std::string_view configFilename, BGUTData &data);
+	static void BGUTParseArguments(const std::vector<std::string_view> &args, BGUTData &data);
+	static bool BGUTInitHeadless(void);
+	static void BGUTMainLoopSerial(void);
+	static void BGUTMainLoopPipelined(void);
+	static bool BGUTBeginReplay(void);
+	static void BGUTEndReplay(void);
+	// Events and delta for this frame, from SDL or the replay; false when the replay ends.
+	static bool BGUTGatherFrameInput(double &inOutFrameMillis, std::span<const SDL_Event> &outEvents);
+	static float BGUTSimulateFrame(IRenderSnapshot &snapshot, std::span<const SDL_Event> events, double frameMillis);
+	static void BGUTResetStepState(void);
+	// Returns the interpolation alpha
+	static float BGUTStepUpdates(std::span<const SDL_Event> events, double frameMillis);
+	static void BGUTRunInputPhase(std::span<const SDL_Event> events, double frameMillis);
+	static void BGUTRunUpdatePhases(std::span<const SDL_Event> events, double deltaMillis, double elapsedMillis);
+	static SchedulerHandle BGUTReplaceCallbackSystem(SchedulerHandle oldHandle, std::string_view name,
+													 SchedulerPhase phase, SchedulerTickFunc tickFunc);
+	static void BGUTRenderFrame(const IRenderSnapshot *pSnapshot, float interpAlpha, double frameMillis);
+	static void BGUTPresentFrame(Uint64 frameStartCounter); // Swap, feed the governor, and pace
+	static int BGUTGetRefreshRate(void);
 	static bool BGUTInitImGui(BGUTWindowPtr pWindow); // also for ImPlot
 	static void BGUTShutdownImGui(void);
 	static void BGUTLogInfo(void);
@@ -79,14 +139,27 @@ namespace BGE
 	static BGUTData s_BGUT = {};
 } // End namespace (BGE)
 
-bool BGE::BGUTInit(std::string_view configFilename)
+bool BGE::BGUTInit(std::string_view configFilename, const std::vector<std::string_view> &args)
 {
+	// Each emplace() ends the previous startup phase and begins the next
+	std::optional<StartupProfiler::ScopedPhase> phase;
+	phase.emplace("BGUT: Parse config");
+	s_BGUT.mainThreadID = std::this_thread::get_id();
 	// Parse engine configuration file
 	if (!BGUTParseConfig(configFilename, s_BGUT))
 	{
 		BGE_ERROR("BGUTInit Failure: Couldn't parse config file!");
 		return false;
 	}
+	// Command line options take precedence over the configuration file
+	BGUTParseArguments(args, s_BGUT);
+	// Headless mode skips the video subsystem entirely
+	if (s_BGUT.headlessEnabled)
+	{
+		phase.emplace("BGUT: Init headless");
+		return BGUTInitHeadless();
+	}
+	phase.emplace("BGUT: SDL_Init");
 	// Decide which parts of SDL should be initialized
 	if (SDL_Init(SDL_INIT_EVERYTHING) < 0)
 	{
@@ -120,6 +193,7 @@ bool BGE::BGUTInit(std::string_view configFilename)
 		s_BGUT.defWindowWidth = displayMode.w;
 		s_BGUT.defWindowHeight = displayMode.h;
 	}
+	phase.emplace("BGUT: Create window");
 	// Create the SDL window
 	s_BGUT.pWindow = SDL_CreateWindow(s_BGUT.defWindowTitle.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
 									  s_BGUT.defWindowWidth, s_BGUT.defWindowHeight, s_BGUT.defWindowFlags);
@@ -128,6 +202,7 @@ bool BGE::BGUTInit(std::string_view configFilename)
 		BGE_ERROR("BGUTInit Failure: SDL window could not be created (%s).", SDL_GetError());
 		return false;
 	}
+	phase.emplace("BGUT: Create OpenGL context");
 	// Attempt to create the OpenGL context
 	s_BGUT.pContext = SDL_GL_CreateContext(s_BGUT.pWindow);
 	if (!s_BGUT.pContext)
@@ -147,6 +222,7 @@ bool BGE::BGUTInit(std::string_view configFilename)
 		BGE_ERROR("BGUTInit Failure: Can't set OpenGL swap interval (%s).", SDL_GetError());
 		return false;
 	}
+	phase.emplace("BGUT: Load OpenGL functions");
 	// Set the function loader for OpenGL
 	if (!gladLoadGLLoader(SDL_GL_GetProcAddress))
 	{
@@ -157,6 +233,7 @@ bool BGE::BGUTInit(std::string_view configFilename)
 	if (s_BGUT.glDebugEnabled)
 		GL::DebugContextSetup();
 
+	phase.emplace("BGUT: Init ImGui");
 	// Only init ImGui when it is enabled (rely on short circuit evaluation)
 	if (s_BGUT.imGuiEnabled && !BGUTInitImGui(s_BGUT.pWindow))
 	{
@@ -165,8 +242,7 @@ bool BGE::BGUTInit(std::string_view configFilename)
 	}
 	// Set the OpenGL viewport
 	BGUTSetViewport(0, 0, s_BGUT.defWindowWidth, s_BGUT.defWindowHeight);
-	// Write some information to the log related to the toolkit
-	BGUTLogInfo();
+	// BGUTLogInfo() queries many OpenGL attributes, so it runs after the first frame
 	return true;
 }
 
@@ -180,64 +256,44 @@ bool BGE::BGUTCreateWindow(std::string_view windowTitle, std::string_view iconFi
 
 void BGE::BGUTMainLoop(void)
 {
-	SDL_Event event; // Poll event
 	s_BGUT.isRunning = true; // Set game running to true
-	// https://gamedev.stackexchange.com/questions/151877/handling-variable-frame-rate-in-sdl2
-	constexpr Uint64 kMillis = 1000;
-	// Protect from divide by zero UB
-	const Uint64 kTicksMinStepMillis = kMillis / ((s_BGUT.minFrames == 0) ? 1 : s_BGUT.minFrames); // Min delta
-	Uint64 kTicksLastStepMillis = SDL_GetTicks64(); // Previous delta
-
-	s_BGUT.mainLoopTimer.Start(); // Start the mainloop timer
-	while (s_BGUT.isRunning) // Keep looping while isRunning is true
+	if (!BGUTBeginReplay())
 	{
-		const Uint64 kTicksNowMillis = SDL_GetTicks64();
-		while (SDL_PollEvent(&event))
-		{
-			// call default event handler
-			BGUTDefEventHandler(event);
-			// call user event handler callback
-			if (s_BGUT.pEventHandlerCallback)
-				s_BGUT.pEventHandlerCallback(event);
-		}
-
-		if (kTicksLastStepMillis < kTicksNowMillis)
-		{
-			Uint64 deltaTimeMS = kTicksNowMillis - kTicksLastStepMillis; // Delta time
-
-			if (deltaTimeMS > kTicksMinStepMillis) // Set the current delta to the minimum
-				deltaTimeMS = kTicksMinStepMillis;
-			// Call update callback
-			if (s_BGUT.pUpdateCallback)
-				s_BGUT.pUpdateCallback(static_cast<float>(deltaTimeMS), s_BGUT.mainLoopTimer.GetElapsedMillis());
-
-			kTicksLastStepMillis = kTicksNowMillis; // set previous step
-			// when ImGui is enabled, prepare the new frame
-			if (s_BGUT.imGuiEnabled)
-			{
-				ImGui_ImplOpenGL3_NewFrame();
-				ImGui_ImplSDL2_NewFrame();
-				ImGui::NewFrame();
-			}
-
-			if (s_BGUT.pRenderCallback) // call render callback
-				s_BGUT.pRenderCallback();
-			// when ImGui is enabled, call end of frame routines
-			if (s_BGUT.imGuiEnabled)
-			{
-				ImGui::Render();
-				ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-			}
-		}
-		else
-		{
-			if (s_BGUT.toLimitFrames) // limit frames if needed
-				SDL_Delay(1u);
-		}
-		// swap OpenGL buffers on window
-		SDL_GL_SwapWindow(s_BGUT.pWindow);
+		s_BGUT.exitCode = BGE_EXIT_FAILURE;
+		return;
+	}
+	BGUTResetStepState();
+	s_BGUT.renderFrameIndex = 0;
+	s_BGUT.renderElapsedMillis = 0.0;
+	// Pace to the configured rate, or the display refresh rate when unset
+	if (s_BGUT.toLimitFrames)
+	{
+		s_BGUT.frameLimiter.SetTargetRate((s_BGUT.targetFrameRate > 0) ? s_BGUT.targetFrameRate
+																	 : BGUTGetRefreshRate());
+		s_BGUT.frameLimiter.ResetStats();
+		s_BGUT.frameLimiter.Reset();
 	}
+	// Governor budget matches the paced frame period
+	if (s_BGUT.qualityGovernorEnabled)
+	{
+		const int kTargetRate = (s_BGUT.targetFrameRate > 0) ? s_BGUT.targetFrameRate : BGUTGetRefreshRate();
+		s_BGUT.qualityGovernor.SetTargetFrameMillis(1000.0 / kTargetRate);
+	}
+	// The pipeline needs snapshot callbacks and something to render to
+	const bool kUsePipeline = s_BGUT.pipelineEnabled && !s_BGUT.headlessEnabled;
+	BGE_WARNING_IF(kUsePipeline && !s_BGUT.pSnapshotFactory,
+				   "BGUTMainLoop: Pipeline enabled without snapshot callbacks, running serially.");
+
+	s_BGUT.mainLoopTimer.Start(); // Start the mainloop timer
+	if (kUsePipeline && s_BGUT.pSnapshotFactory)
+		BGUTMainLoopPipelined();
+	else
+		BGUTMainLoopSerial();
 	s_BGUT.mainLoopTimer.Stop(); // Stop the mainloop timer
+	BGUTEndReplay();
+	if (s_BGUT.toLimitFrames)
+		s_BGUT.frameLimiter.LogStats();
+	s_BGUT.scheduler.LogStats();
 }
 
 void BGE::BGUTSendExitCode(int exitCode)
@@ -252,8 +308,11 @@ void BGE::BGUTShutdown(void)
 	if (s_BGUT.imGuiEnabled)
 		BGUTShutdownImGui();
 
-	SDL_GL_DeleteContext(s_BGUT.pContext);
-	SDL_DestroyWindow(s_BGUT.pWindow);
+	// Window and context are null when headless
+	if (s_BGUT.pContext)
+		SDL_GL_DeleteContext(s_BGUT.pContext);
+	if (s_BGUT.pWindow)
+		SDL_DestroyWindow(s_BGUT.pWindow);
 	SDL_Quit();
 }
 
@@ -269,22 +328,81 @@ void BGE::BGUTSetWindowSize(BGUTWindowPtr pWindow, int width, int height)
 
 void BGE::BGUTSetViewport(int x, int y, int width, int height)
 {
+	// No OpenGL functions are loaded when headless
+	if (s_BGUT.headlessEnabled)
+		return;
 	glViewport(x, y, width, height);
 }
 
 void BGE::BGUTSetCallbackUpdate(BGUTUpdateCallback pUpdateCallback)
 {
-	s_BGUT.pUpdateCallback = pUpdateCallback;
+	SchedulerTickFunc tickFunc;
+	if (pUpdateCallback)
+		tickFunc = [pUpdateCallback](const TickContext &context) { pUpdateCallback(context.deltaMillis, context.elapsedMillis); };
+	s_BGUT.updateCallbackHandle = BGUTReplaceCallbackSystem(s_BGUT.updateCallbackHandle, "BGUTUpdateCallback",
+															SchedulerPhase::Update, std::move(tickFunc));
 }
 
 void BGE::BGUTSetCallbackRender(BGUTRenderCallback pRenderCallback)
 {
-	s_BGUT.pRenderCallback = pRenderCallback;
+	SchedulerTickFunc tickFunc;
+	if (pRenderCallback)
+		tickFunc = [pRenderCallback](const TickContext &context) { pRenderCallback(context.interpAlpha); };
+	s_BGUT.renderCallbackHandle = BGUTReplaceCallbackSystem(s_BGUT.renderCallbackHandle, "BGUTRenderCallback",
+															SchedulerPhase::Render, std::move(tickFunc));
 }
 
 void BGE::BGUTSetCallbackEventHandler(BGUTEventHandlerCallback pEventHandlerCallback)
 {
-	s_BGUT.pEventHandlerCallback = pEventHandlerCallback;
+	SchedulerTickFunc tickFunc;
+	if (pEventHandlerCallback)
+	{
+		tickFunc = [pEventHandlerCallback](const TickContext &context)
+		{
+			for (const auto &kEvent : context.events)
+				pEventHandlerCallback(kEvent);
+		};
+	}
+	s_BGUT.eventHandlerCallbackHandle = BGUTReplaceCallbackSystem(s_BGUT.eventHandlerCallbackHandle,
+																  "BGUTEventHandlerCallback", SchedulerPhase::Input,
+																  std::move(tickFunc));
+}
+
+BGE::Scheduler &BGE::BGUTGetScheduler(void)
+{
+	return s_BGUT.scheduler;
+}
+
+BGE::QualityGovernor &BGE::BGUTGetQualityGovernor(void)
+{
+	return s_BGUT.qualityGovernor;
+}
+
+bool BGE::BGUTIsQualityGovernorEnabled(void)
+{
+	return s_BGUT.qualityGovernorEnabled;
+}
+
+int BGE::BGUTGetMultisamplingLevel(void)
+{
+	return s_BGUT.multisamplingLevel;
+}
+
+void BGE::BGUTSetRendererMultisampling(bool isEnabled)
+{
+	s_BGUT.rendererMultisamplingEnabled = isEnabled;
+}
+
+void BGE::BGUTSetCallbackSnapshot(BGUTSnapshotFactory pSnapshotFactory, BGUTSnapshotCallback pSnapshotCallback,
+								  BGUTRenderSnapshotCallback pRenderSnapshotCallback)
+{
+	// All three are needed for the pipeline; a partial set disables it
+	const bool kIsComplete = pSnapshotFactory && pSnapshotCallback && pRenderSnapshotCallback;
+	BGE_WARNING_IF(!kIsComplete && (pSnapshotFactory || pSnapshotCallback || pRenderSnapshotCallback),
+				   "BGUTSetCallbackSnapshot: Incomplete snapshot callbacks ignored.");
+	s_BGUT.pSnapshotFactory = (kIsComplete) ? pSnapshotFactory : nullptr;
+	s_BGUT.pSnapshotCallback = (kIsComplete) ? pSnapshotCallback : nullptr;
+	s_BGUT.pRenderSnapshotCallback = (kIsComplete) ? pRenderSnapshotCallback : nullptr;
 }
 
 SDL_Window *BGE::BGUTGetWindowPtr(void)
@@ -302,11 +420,39 @@ const BGE::Timer &BGE::BGUTGetMainLoopTimer(void)
 	return s_BGUT.mainLoopTimer;
 }
 
+std::span<const SDL_Event> BGE::BGUTGetInputEvents(void)
+{
+	// The queue is refilled by the main loop while a pipelined update runs
+	BGE_ASSERT(std::this_thread::get_id() == s_BGUT.mainThreadID && "BGUTGetInputEvents called off the main thread!");
+	return s_BGUT.inputEventQueue.GetEvents();
+}
+
+std::span<const SDL_Event> BGE::BGUTGetInputEvents(InputEventCategory category)
+{
+	BGE_ASSERT(std::this_thread::get_id() == s_BGUT.mainThreadID && "BGUTGetInputEvents called off the main thread!");
+	return s_BGUT.inputEventQueue.GetEvents(category);
+}
+
+void BGE::BGUTSetCoalesceMouseMotion(bool toCoalesce)
+{
+	s_BGUT.inputEventQueue.SetCoalesceMouseMotion(toCoalesce);
+}
+
+const BGE::FrameLimiter::Stats &BGE::BGUTGetFramePacingStats(void)
+{
+	return s_BGUT.frameLimiter.GetStats();
+}
+
 int BGE::BGUTGetExitCode(void)
 {
 	return s_BGUT.exitCode;
 }
 
+bool BGE::BGUTIsHeadless(void)
+{
+	return s_BGUT.headlessEnabled;
+}
+
 bool BGE::BGUTParseConfig(std::string_view configFilename, BGUTData &data)
 {
 	using namespace tinyxml2;
@@ -325,9 +471,11 @@ bool BGE::BGUTParseConfig(std::string_view configFilename, BGUTData &data)
 
 	static constexpr const char *c_kpATTRIB_TAG_NAME = "name";
 	static constexpr const char *c_kpATTRIB_VALUE_NAME = "value";
-	for (auto *pElem = pRoot->FirstChildElement(); pElem; pElem->NextSiblingElement())
+	for (auto *pElem = pRoot->FirstChildElement(); pElem; pElem = pElem->NextSiblingElement())
 	{
-		const std::string kOptionName(pElem->Attribute(c_kpATTRIB_TAG_NAME));
+		const char *pkName = pElem->Attribute(c_kpATTRIB_TAG_NAME);
+		if (!pkName) continue; // Skip malformed options
+		const std::string kOptionName(pkName);
 		// Look for known options
 		if (kOptionName == "glVersion")
 		{
@@ -390,10 +538,87 @@ bool BGE::BGUTParseConfig(std::string_view configFilename, BGUTData &data)
 			const int kValue = pElem->IntAttribute(c_kpATTRIB_VALUE_NAME);
 			s_BGUT.minFrames = kValue;
 		}
+		else if (kOptionName == "targetFrameRate")
+		{
+			const int kValue = pElem->IntAttribute(c_kpATTRIB_VALUE_NAME);
+			s_BGUT.targetFrameRate = kValue;
+		}
+		else if (kOptionName == "fixedTimestepEnabled")
+		{
+			const bool kValue = pElem->BoolAttribute(c_kpATTRIB_VALUE_NAME);
+			s_BGUT.fixedTimestepEnabled = kValue;
+		}
+		else if (kOptionName == "fixedUpdateRate")
+		{
+			const int kValue = pElem->IntAttribute(c_kpATTRIB_VALUE_NAME);
+			s_BGUT.fixedUpdateRate = kValue;
+		}
+		else if (kOptionName == "maxStepsPerFrame")
+		{
+			const int kValue = pElem->IntAttribute(c_kpATTRIB_VALUE_NAME);
+			s_BGUT.maxStepsPerFrame = kValue;
+		}
+		else if (kOptionName == "pipelineEnabled")
+		{
+			const bool kValue = pElem->BoolAttribute(c_kpATTRIB_VALUE_NAME);
+			s_BGUT.pipelineEnabled = kValue;
+		}
+		else if (kOptionName == "qualityGovernorEnabled")
+		{
+			const bool kValue = pElem->BoolAttribute(c_kpATTRIB_VALUE_NAME);
+			s_BGUT.qualityGovernorEnabled = kValue;
+		}
+		else if (kOptionName == "headlessEnabled")
+		{
+			const bool kValue = pElem->BoolAttribute(c_kpATTRIB_VALUE_NAME);
+			s_BGUT.headlessEnabled = kValue;
+		}
 	}
 	return true;
 }
 
+void BGE::BGUTParseArguments(const std::vector<std::string_view> &args, BGUTData &data)
+{
+	for (std::size_t index = 0; index < args.size(); ++index)
+	{
+		const auto &kArg = args[index];
+		// Options followed by a value
+		const bool kHasValue = (index + 1 < args.size());
+		if (kArg == "--headless")
+			data.headlessEnabled = true;
+		else if (kArg == "--windowed")
+			data.headlessEnabled = false;
+		else if (kArg == "--record" && kHasValue)
+			data.recordFilename = args[++index];
+		else if (kArg == "--replay" && kHasValue)
+			data.replayFilename = args[++index];
+		else if (kArg == "--replay-times" && kHasValue)
+			data.replayTimesFilename = args[++index];
+	}
+	// Replays are for comparing builds, so they run without a window
+	if (!data.replayFilename.empty())
+		data.headlessEnabled = true;
+	BGE_WARNING_IF(!data.replayFilename.empty() && !data.recordFilename.empty(),
+				   "Both --record and --replay given; only replaying.");
+}
+
+bool BGE::BGUTInitHeadless(void)
+{
+	// Only the subsystems needed to drive the main loop
+	if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS) < 0)
+	{
+		BGE_ERROR("BGUTInitHeadless Failure: SDL failed to initialize (%s).", SDL_GetError());
+		return false;
+	}
+
+	SDL_LogSetOutputFunction(Logger::LogOutputFunc_SDL, nullptr);
+	SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+	// ImGui requires a window and renderer backend
+	s_BGUT.imGuiEnabled = false;
+	BGE_INFO("Running headless (no window, OpenGL context, or ImGui).");
+	return true;
+}
+
 bool BGE::BGUTInitImGui(BGUTWindowPtr pWindow)
 {
 	IMGUI_CHECKVERSION(); // What does this do?
@@ -437,6 +662,311 @@ void BGE::BGUTShutdownImGui(void)
 	ImGui::DestroyContext();
 }
 
+void BGE::BGUTMainLoopSerial(void)
+{
+	// Performance counter gives sub-millisecond deltas
+	const double kCounterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	Uint64 lastStepCounter = SDL_GetPerformanceCounter(); // Previous delta
+
+	while (s_BGUT.isRunning) // Keep looping while isRunning is true
+	{
+		const Uint64 kNowCounter = SDL_GetPerformanceCounter();
+		double frameMillis = static_cast<double>(kNowCounter - lastStepCounter) * 1000.0 / kCounterFrequency;
+		std::span<const SDL_Event> events;
+		if (!BGUTGatherFrameInput(frameMillis, events))
+			break;
+		for (const auto &kEvent : events)
+			BGUTDefEventHandler(kEvent); // call default event handler
+		BGUTRunInputPhase(events, frameMillis);
+
+		if (frameMillis > 0.0)
+		{
+			const float kInterpAlpha = BGUTStepUpdates(events, frameMillis);
+			lastStepCounter = kNowCounter; // set previous step
+			// Nothing to draw to when headless
+			if (!s_BGUT.headlessEnabled)
+				BGUTRenderFrame(nullptr, kInterpAlpha, frameMillis);
+		}
+		BGUTPresentFrame(kNowCounter);
+	}
+}
+
+void BGE::BGUTMainLoopPipelined(void)
+{
+	RenderPipeline pipeline;
+	if (!pipeline.Start(s_BGUT.pSnapshotFactory(), s_BGUT.pSnapshotFactory(), BGUTSimulateFrame))
+	{
+		BGE_ERROR("BGUTMainLoopPipelined Failure: Couldn't start pipeline, running serially.");
+		BGUTMainLoopSerial();
+		return;
+	}
+
+	std::vector<SDL_Event> events; // Forwarded to the update thread
+	events.reserve(InputEventQueue::kDEFAULT_CAPACITY);
+	const double kCounterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	Uint64 lastStepCounter = SDL_GetPerformanceCounter(); // Previous delta
+	// Prime the pipeline with the first frame
+	pipeline.Kick(events, 0.0);
+	while (s_BGUT.isRunning) // Keep looping while isRunning is true
+	{
+		const Uint64 kNowCounter = SDL_GetPerformanceCounter();
+		double frameMillis = static_cast<double>(kNowCounter - lastStepCounter) * 1000.0 / kCounterFrequency;
+		lastStepCounter = kNowCounter; // set previous step
+		// Events are polled here, but the user handler runs on the update thread
+		std::span<const SDL_Event> frameEvents;
+		if (!BGUTGatherFrameInput(frameMillis, frameEvents))
+			break;
+		for (const auto &kEvent : frameEvents)
+			BGUTDefEventHandler(kEvent);
+		events.insert(events.end(), frameEvents.begin(), frameEvents.end());
+		// Take frame N, then start frame N+1 while N is drawn
+		const auto kFrame = pipeline.WaitForFrame();
+		pipeline.Kick(events, frameMillis);
+		BGUTRenderFrame(&kFrame.snapshot, kFrame.interpAlpha, frameMillis);
+		BGUTPresentFrame(kNowCounter);
+	}
+	pipeline.WaitForFrame(); // Retire the last job before the pipeline is destroyed
+	pipeline.Stop();
+}
+
+bool BGE::BGUTBeginReplay(void)
+{
+	if (!s_BGUT.replayFilename.empty())
+	{
+		if (!s_BGUT.replayPlayer.Open(s_BGUT.replayFilename))
+			return false;
+		// Step the recorded frame times exactly as the recording did
+		const ReplayTimingSettings &kSettings = s_BGUT.replayPlayer.GetTimingSettings();
+		s_BGUT.fixedTimestepEnabled = kSettings.fixedTimestepEnabled;
+		s_BGUT.fixedUpdateRate = kSettings.fixedUpdateRate;
+		s_BGUT.maxStepsPerFrame = kSettings.maxStepsPerFrame;
+		s_BGUT.minFrames = kSettings.minFrames;
+		// Anything reacting to measured time would make the run diverge, and pacing would only slow it
+		s_BGUT.toLimitFrames = false;
+		s_BGUT.qualityGovernorEnabled = false;
+		s_BGUT.scheduler.SetBudgetAdaptationEnabled(false);
+		BGE_INFO("Replaying \"%s\".", s_BGUT.replayFilename.c_str());
+	}
+	else if (!s_BGUT.recordFilename.empty())
+	{
+		ReplayTimingSettings settings;
+		settings.fixedTimestepEnabled = s_BGUT.fixedTimestepEnabled;
+		settings.fixedUpdateRate = s_BGUT.fixedUpdateRate;
+		settings.maxStepsPerFrame = s_BGUT.maxStepsPerFrame;
+		settings.minFrames = s_BGUT.minFrames;
+		if (!s_BGUT.replayRecorder.Open(s_BGUT.recordFilename, settings))
+			return false;
+		BGE_INFO("Recording replay to \"%s\".", s_BGUT.recordFilename.c_str());
+	}
+	return true;
+}
+
+void BGE::BGUTEndReplay(void)
+{
+	if (s_BGUT.replayRecorder.IsOpen())
+		s_BGUT.replayRecorder.Close();
+
+	if (s_BGUT.replayPlayer.IsOpen())
+	{
+		s_BGUT.replayPlayer.LogMeasuredFrameTimes();
+		if (!s_BGUT.replayTimesFilename.empty())
+			s_BGUT.replayPlayer.WriteMeasuredFrameTimes(s_BGUT.replayTimesFilename);
+		s_BGUT.replayPlayer.Close();
+	}
+}
+
+bool BGE::BGUTGatherFrameInput(double &inOutFrameMillis, std::span<const SDL_Event> &outEvents)
+{
+	if (s_BGUT.replayPlayer.IsOpen())
+	{
+		std::span<const SDL_Event> events;
+		if (!s_BGUT.replayPlayer.NextFrame(inOutFrameMillis, events))
+		{
+			BGE_INFO("Replay finished after %u frames.", s_BGUT.replayPlayer.GetFrameIndex());
+			s_BGUT.isRunning = false;
+			return false;
+		}
+		// Keep BGUTGetInputEvents() consistent with what the handlers see
+		s_BGUT.inputEventQueue.Assign(events);
+		outEvents = s_BGUT.inputEventQueue.GetEvents();
+		return true;
+	}
+	// Drain all pending events in batches
+	outEvents = s_BGUT.inputEventQueue.Poll();
+	if (s_BGUT.replayRecorder.IsOpen())
+		s_BGUT.replayRecorder.RecordFrame(inOutFrameMillis, outEvents);
+	return true;
+}
+
+float BGE::BGUTSimulateFrame(IRenderSnapshot &snapshot, std::span<const SDL_Event> events, double frameMillis)
+{
+	BGUTRunInputPhase(events, frameMillis);
+	const float kInterpAlpha = BGUTStepUpdates(events, frameMillis);
+	// Capture the state the render thread will draw
+	s_BGUT.pSnapshotCallback(snapshot);
+	return kInterpAlpha;
+}
+
+void BGE::BGUTResetStepState(void)
+{
+	// https://gamedev.stackexchange.com/questions/151877/handling-variable-frame-rate-in-sdl2
+	constexpr double kMillis = 1000.0;
+	auto &step = s_BGUT.stepState;
+	// Protect from divide by zero UB
+	step.minStepMillis = kMillis / ((s_BGUT.minFrames == 0) ? 1 : s_BGUT.minFrames); // Min delta
+	// Fixed timestep state: https://gafferongames.com/post/fix_your_timestep/
+	step.fixedStepMillis = kMillis / ((s_BGUT.fixedUpdateRate <= 0) ? 60 : s_BGUT.fixedUpdateRate);
+	step.maxStepsPerFrame = (s_BGUT.maxStepsPerFrame <= 0) ? 1 : s_BGUT.maxStepsPerFrame;
+	step.accumulatorMillis = 0.0;
+	step.simulationMillis = 0.0;
+	step.elapsedMillis = 0.0;
+}
+
+float BGE::BGUTStepUpdates(std::span<const SDL_Event> events, double frameMillis)
+{
+	auto &step = s_BGUT.stepState;
+	if (!s_BGUT.fixedTimestepEnabled)
+	{
+		double deltaTimeMS = frameMillis; // Delta time
+
+		if (deltaTimeMS > step.minStepMillis) // Set the current delta to the minimum
+			deltaTimeMS = step.minStepMillis;
+		// Run the update phases
+		BGUTRunUpdatePhases(events, deltaTimeMS, step.elapsedMillis);
+		++step.frameIndex;
+		return 1.0f; // Variable steps always render the latest state
+	}
+
+	step.accumulatorMillis += frameMillis;
+	// Consume the accumulated time in fixed increments
+	int numSteps = 0;
+	while (step.accumulatorMillis >= step.fixedStepMillis && numSteps < step.maxStepsPerFrame)
+	{
+		BGUTRunUpdatePhases(events, step.fixedStepMillis, step.simulationMillis);
+		step.simulationMillis += step.fixedStepMillis;
+		step.accumulatorMillis -= step.fixedStepMillis;
+		++numSteps;
+	}
+	// Spiral of death guard: drop time the simulation can't catch up on
+	if (step.accumulatorMillis >= step.fixedStepMillis)
+		step.accumulatorMillis = std::fmod(step.accumulatorMillis, step.fixedStepMillis);
+	++step.frameIndex;
+	// Fraction of a step between the previous and current simulation state
+	return static_cast<float>(step.accumulatorMillis / step.fixedStepMillis);
+}
+
+void BGE::BGUTRunInputPhase(std::span<const SDL_Event> events, double frameMillis)
+{
+	// The input phase is the first work of every frame
+	s_BGUT.stepState.elapsedMillis += frameMillis;
+	TickContext context;
+	context.deltaMillis = static_cast<float>(frameMillis);
+	context.elapsedMillis = static_cast<float>(s_BGUT.stepState.elapsedMillis);
+	context.events = events;
+	context.frameIndex = s_BGUT.stepState.frameIndex;
+	s_BGUT.scheduler.RunPhase(SchedulerPhase::Input, context);
+}
+
+void BGE::BGUTRunUpdatePhases(std::span<const SDL_Event> events, double deltaMillis, double elapsedMillis)
+{
+	TickContext context;
+	context.deltaMillis = static_cast<float>(deltaMillis);
+	context.elapsedMillis = static_cast<float>(elapsedMillis);
+	context.events = events; // The frame's copy when pipelined, so updates never touch the live queue
+	context.frameIndex = s_BGUT.stepState.frameIndex;
+	s_BGUT.scheduler.RunPhase(SchedulerPhase::PreUpdate, context);
+	s_BGUT.scheduler.RunPhase(SchedulerPhase::Update, context);
+	s_BGUT.scheduler.RunPhase(SchedulerPhase::PostUpdate, context);
+}
+
+BGE::SchedulerHandle BGE::BGUTReplaceCallbackSystem(SchedulerHandle oldHandle, std::string_view name,
+													 SchedulerPhase phase, SchedulerTickFunc tickFunc)
+{
+	if (oldHandle != kINVALID_SCHEDULER_HANDLE)
+		s_BGUT.scheduler.Unregister(oldHandle);
+	// A null callback only removes the old one
+	if (!tickFunc)
+		return kINVALID_SCHEDULER_HANDLE;
+
+	SchedulerSystemDesc desc;
+	desc.name = name;
+	desc.phase = phase;
+	desc.tickFunc = std::move(tickFunc);
+	return s_BGUT.scheduler.Register(std::move(desc));
+}
+
+void BGE::BGUTRenderFrame(const IRenderSnapshot *pSnapshot, float interpAlpha, double frameMillis)
+{
+	// when ImGui is enabled, prepare the new frame
+	if (s_BGUT.imGuiEnabled)
+	{
+		ImGui_ImplOpenGL3_NewFrame();
+		ImGui_ImplSDL2_NewFrame();
+		ImGui::NewFrame();
+	}
+	// call snapshot render callback, then the render phase systems
+	if (pSnapshot && s_BGUT.pRenderSnapshotCallback)
+		s_BGUT.pRenderSnapshotCallback(*pSnapshot, interpAlpha);
+
+	// The update clock belongs to the update thread when pipelined
+	s_BGUT.renderElapsedMillis += frameMillis;
+	TickContext context;
+	context.deltaMillis = static_cast<float>(frameMillis);
+	context.elapsedMillis = static_cast<float>(s_BGUT.renderElapsedMillis);
+	context.interpAlpha = interpAlpha;
+	context.frameIndex = s_BGUT.renderFrameIndex++;
+	s_BGUT.scheduler.RunPhase(SchedulerPhase::Render, context);
+	// when ImGui is enabled, call end of frame routines
+	if (s_BGUT.imGuiEnabled)
+	{
+		ImGui::Render();
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	}
+}
+
+void BGE::BGUTPresentFrame(Uint64 frameStartCounter)
+{
+	const double kCounterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	const auto kGetWorkMillis = [frameStartCounter, kCounterFrequency](void)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - frameStartCounter) * 1000.0 / kCounterFrequency;
+	};
+	// With vertical sync the swap blocks for the display, so it isn't counted as work
+	double workMillis = kGetWorkMillis();
+	// swap OpenGL buffers on window
+	if (!s_BGUT.headlessEnabled)
+	{
+		SDL_GL_SwapWindow(s_BGUT.pWindow);
+		if (!s_BGUT.verticalSyncEnabled)
+			workMillis = kGetWorkMillis();
+	}
+	if (s_BGUT.replayPlayer.IsOpen())
+		s_BGUT.replayPlayer.AddMeasuredFrameTime(workMillis);
+	// Feed the governor before any limiter sleep
+	if (s_BGUT.qualityGovernorEnabled)
+		s_BGUT.qualityGovernor.AddFrameTime(workMillis);
+	// Report startup once the first frame is out
+	if (StartupProfiler::Get().MarkFirstFrame())
+	{
+		StartupProfiler::Get().LogReport();
+		// Write some information to the log related to the toolkit
+		BGUTLogInfo();
+	}
+	// Sleep off the remainder of the frame period
+	if (s_BGUT.toLimitFrames)
+		s_BGUT.frameLimiter.Wait();
+}
+
+int BGE::BGUTGetRefreshRate(void)
+{
+	constexpr int kDEFAULT_REFRESH_RATE = 60; // No display when headless
+	SDL_DisplayMode displayMode;
+	if (!s_BGUT.pWindow || SDL_GetWindowDisplayMode(s_BGUT.pWindow, &displayMode) != 0 ||
+		displayMode.refresh_rate <= 0)
+		return kDEFAULT_REFRESH_RATE;
+	return displayMode.refresh_rate;
+}
+
 void BGE::BGUTLogInfo(void)
 {
 	SDL_version version;
@@ -446,6 +976,9 @@ void BGE::BGUTLogInfo(void)
 	// When ImGui is enabled, log the version
 	if (s_BGUT.imGuiEnabled)
 		BGE_INFO("ImGui Version: %s", ImGui::GetVersion());
+	// There is no OpenGL context to query
+	if (s_BGUT.headlessEnabled)
+		return;
 
 	BGE_INFO("Current OpenGL Version: %d.%d", s_BGUT.glVersion.major, s_BGUT.glVersion.minor);
 
@@ -483,9 +1016,10 @@ void BGE::BGUTSetAttributes(int versionMajor, int versionMinor, bool doubleBuffe
 	SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, doubleBuffered);
-	// Set multisampling
-	SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, (s_BGUT.multisamplingLevel > 0) ? 1 : 0);
-	SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, s_BGUT.multisamplingLevel); // Set level
+	// Set multisampling; a renderer that resolves its own target needs a single sample window
+	const int kWindowSamples = (s_BGUT.rendererMultisamplingEnabled) ? 0 : s_BGUT.multisamplingLevel;
+	SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, (kWindowSamples > 0) ? 1 : 0);
+	SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, kWindowSamples); // Set level
 	//glEnable(GL_MULTISAMPLE);
 }
 
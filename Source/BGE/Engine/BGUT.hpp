@@ -32,14 +32,30 @@
 
 namespace BGE
 {
+	enum class InputEventCategory : int;
+	class QualityGovernor;
+
 	// 1st Arg (delta time milliseconds), 2nd Arg (elapsed time milliseconds)
+	// With a fixed timestep the delta is constant and elapsed time is simulated time.
 	using BGUTUpdateCallback = std::add_pointer_t<void(float, float)>;
-	using BGUTRenderCallback = std::add_pointer_t<void()>;
+	// 1st Arg (interpolation alpha [0, 1) between the previous and current fixed step)
+	using BGUTRenderCallback = std::add_pointer_t<void(float)>;
 	using BGUTEventHandlerCallback = std::add_pointer_t<void(const SDL_Event &)>;
+	// Pipelined main loop: the factory allocates each snapshot slot, the snapshot callback
+	// fills one after update (update thread), and the render callback draws one (main thread).
+	// Update and event handler callbacks run on the update thread and must not touch GL or ImGui.
+	using BGUTSnapshotFactory = std::add_pointer_t<UniqueIRenderSnapshotPtr()>;
+	using BGUTSnapshotCallback = std::add_pointer_t<void(IRenderSnapshot &)>;
+	using BGUTRenderSnapshotCallback = std::add_pointer_t<void(const IRenderSnapshot &, float)>;
 	using BGUTWindowPtr = SDL_Window *;
 	using BGUTWindowID = std::size_t;
 
-	bool BGUTInit(std::string_view configFilename);
+	// Command line ARGS override options from CONFIGFILENAME:
+	//   --headless, --windowed
+	//   --record FILE: write each frame's delta time and events to FILE
+	//   --replay FILE: run headless on the deltas and events in FILE instead of live input
+	//   --replay-times FILE: write the frame times measured during the replay to FILE
+	bool BGUTInit(std::string_view configFilename, const std::vector<std::string_view> &args = {});
 	bool BGUTCreateWindow(std::string_view windowTitle, std::string_view iconFilename);
 	void BGUTSetWindow(BGUTWindowPtr pWindow);
 	void BGUTMainLoop(void);
@@ -49,13 +65,29 @@ namespace BGE
 	void BGUTSetWindowSize(BGUTWindowPtr pWindow, int width, int height);
 	// TODO: This responsibility should be handled by the renderer and the app layer.
 	void BGUTSetViewport(int x, int y, int width, int height);
+	// Each setter (re)registers a single system with the scheduler; pass nullptr to remove it.
 	void BGUTSetCallbackUpdate(BGUTUpdateCallback pUpdateCallback);
 	void BGUTSetCallbackRender(BGUTRenderCallback pRenderCallback);
 	void BGUTSetCallbackEventHandler(BGUTEventHandlerCallback pEventHandlerCallback);
+	void BGUTSetCallbackSnapshot(BGUTSnapshotFactory pSnapshotFactory, BGUTSnapshotCallback pSnapshotCallback,
+								 BGUTRenderSnapshotCallback pRenderSnapshotCallback);
 	SDL_Window *BGUTGetWindowPtr(void); // BGUTWindowID windowID
 	SDL_GLContext BGUTGetContextPtr(void);
 	const Timer &BGUTGetMainLoopTimer(void);
+	Scheduler &BGUTGetScheduler(void); // Register additional subsystems
+	QualityGovernor &BGUTGetQualityGovernor(void); // Register quality knobs
+	bool BGUTIsQualityGovernorEnabled(void);
+	int BGUTGetMultisamplingLevel(void); // MSAA option from the config
+	// Call before BGUTInit when the renderer multisamples offscreen; the window is then single sample.
+	void BGUTSetRendererMultisampling(bool isEnabled);
+	const FrameLimiter::Stats &BGUTGetFramePacingStats(void); // Valid when toLimitFrames is set
+	// Events received this frame, in arrival order or grouped by category. Main thread only; systems
+	// should read TickContext::events, which is the worker's copy when the update is pipelined.
+	std::span<const SDL_Event> BGUTGetInputEvents(void);
+	std::span<const SDL_Event> BGUTGetInputEvents(InputEventCategory category);
+	void BGUTSetCoalesceMouseMotion(bool toCoalesce); // Enabled by default
 	int BGUTGetExitCode(void); // App exit code
+	bool BGUTIsHeadless(void); // True when running without a window or OpenGL context
 } // End namespace (BGE)
 
 #define BGE_EXIT_SUCCESS 0 // Pass to BGUTSendExitCode()
@@ -1,2 +1,93 @@
 #include "Engine/EngineStd.hpp"
 #include "BaseGameLogic.hpp"
+#include "Actors/TransformComponent.hpp"
+#include "Physics/SpatialComponent.hpp"
+
+BGE::BaseGameLogic::BaseGameLogic(void)
+	: m_spatialIndex(m_transforms, Math::Vec3f(kSPATIAL_WORLD_SIZE * -0.5f), kSPATIAL_WORLD_SIZE, kSPATIAL_MAX_DEPTH),
+	  m_actorCommands(m_actorFactory, &m_actorQueries)
+{
+	// Pooled, so spawned, cloned and loaded actors all get packed component storage
+	m_actorFactory.RegisterPooledComponent<TransformComponent>(m_componentStore, std::ref(m_transforms));
+	m_actorFactory.RegisterPooledComponent<SpatialComponent>(m_componentStore, std::ref(m_spatialIndex));
+}
+
+BGE::BaseGameLogic::~BaseGameLogic(void)
+{
+	// Actors and their components reference each other
+	for (auto &[kID, pActor] : m_actors)
+		pActor->Destroy();
+}
+
+void BGE::BaseGameLogic::VOnUpdate(float deltaTime)
+{
+	for (auto &[kID, pActor] : m_actors)
+		pActor->Update(deltaTime);
+	m_componentStore.UpdateAll(deltaTime);
+	m_systemScheduler.Update(m_jobSystem, deltaTime);
+	// World matrices are final for the rest of the frame from here on
+	m_transforms.Update();
+	m_spatialIndex.Sync();
+	DispatchComponentChanges();
+	FlushActorCommands();
+}
+
+void BGE::BaseGameLogic::DispatchComponentChanges(void)
+{
+	m_componentStore.DispatchChanges();
+	// Unpooled components have no per type tracking; only walk the actors if one changed
+	if (ActorComponent::ConsumeUnpooledChanges())
+	{
+		for (auto &[kID, pActor] : m_actors)
+			pActor->DispatchChanges();
+	}
+}
+
+bool BGE::BaseGameLogic::SaveActors(std::ostream &stream) const
+{
+	ActorSnapshotWriter writer(stream);
+	writer.WriteActors(m_actors);
+	return writer.Finish();
+}
+
+bool BGE::BaseGameLogic::LoadActors(std::span<const std::byte> snapshot)
+{
+	ActorSnapshotReader reader;
+	if (!reader.Open(snapshot))
+		return false;
+
+	// Queued spawns hold reserved IDs that may now belong to loaded actors
+	m_actorCommands.Clear();
+	for (auto &[kID, pActor] : m_actors)
+		pActor->Destroy();
+	m_actors.clear();
+	m_actors.reserve(reader.GetActors().size());
+	bool isComplete = true;
+	for (const auto &kActorView : reader.GetActors())
+	{
+		if (StrongActorPtr pActor = m_actorFactory.CreateActor(reader, kActorView))
+		{
+			m_actorQueries.AddActor(*pActor);
+			m_actors.emplace(kActorView.aID, std::move(pActor));
+		}
+		else
+			isComplete = false;
+	}
+	// Parents may come after their children in the snapshot
+	for (auto &[kID, pActor] : m_actors)
+	{
+		const auto pTransform = pActor->GetComponent<TransformComponent>().lock();
+		if (pTransform && !pTransform->LinkBlobParent(m_actors))
+		{
+			BGE_WARNING("Parent transform of actor %u not found; left as a root", static_cast<unsigned>(kID));
+			isComplete = false;
+		}
+	}
+	return isComplete;
+}
+
+BGE::WeakActorPtr BGE::BaseGameLogic::GetActor(ActorID aID)
+{
+	const auto kFindIter = m_actors.find(aID);
+	return (kFindIter != m_actors.end()) ? WeakActorPtr(kFindIter->second) : WeakActorPtr();
+}
@@ -1,15 +1,63 @@
 #ifndef _BGE_BASEGAMELOGIC_HPP_
 #define _BGE_BASEGAMELOGIC_HPP_
 
+#include "Actors/ActorCommandBuffer.hpp"
+#include "Actors/ActorFactory.hpp"
+#include "Actors/ActorQuery.hpp"
+#include "Actors/ComponentStore.hpp"
+#include "Actors/SystemScheduler.hpp"
+#include "Actors/TransformHierarchy.hpp"
+#include "Multicore/JobSystem.hpp"
+#include "Physics/TransformSpatialIndex.hpp"
+
 namespace BGE
 {
 	class BaseGameLogic
 	{
 	protected:
+		// Extent of the spatial index around the origin; actors beyond it are found, just slower
+		static constexpr float kSPATIAL_WORLD_SIZE = 16384.0f;
+		static constexpr std::uint32_t kSPATIAL_MAX_DEPTH = 10;
+
+		TransformHierarchy m_transforms; // Declared first; TransformComponents remove their nodes
+		TransformOctree m_spatialIndex; // Actors with a SpatialComponent, as of the last update
+		ComponentStore m_componentStore; // Pooled components of every actor
+		ActorQueryRegistry m_actorQueries; // Component queries over m_actors
+		ActorFactory m_actorFactory;
+		ActorMap m_actors; // Only changed by FlushActorCommands()
+		ActorCommandBuffer m_actorCommands; // Spawns and despawns waiting for the next flush
+		JobSystem m_jobSystem; // Workers for parallel system updates
+		SystemScheduler m_systemScheduler; // Declared last; its systems reference the store's pools
 	public:
-		BaseGameLogic(void) = default;
+		BaseGameLogic(void);
+		virtual ~BaseGameLogic(void);
+
+		virtual void VOnUpdate(float deltaTime);
+		// Sync point for structural changes; VOnUpdate() calls it after every update.
+		void FlushActorCommands(void) { m_actorCommands.Flush(m_actors); }
+		// Run VOnChanged() on every component marked changed; VOnUpdate() calls it
+		// before flushing, so handlers may queue spawns and despawns.
+		void DispatchComponentChanges(void);
+		// Quicksave: write every live actor as a binary snapshot (see ActorSnapshot.hpp).
+		// Spawns and despawns still queued are not included.
+		bool SaveActors(std::ostream &stream) const;
+		// Replace all actors with those in SNAPSHOT, e.g. a memory mapped save file. The
+		// current actors are kept if SNAPSHOT cannot be read; otherwise queued spawns and
+		// despawns are dropped.
+		bool LoadActors(std::span<const std::byte> snapshot);
+		WeakActorPtr GetActor(ActorID aID);
+		const ActorMap &GetActors(void) const { return m_actors; }
+		ActorCommandBuffer &GetActorCommands(void) { return m_actorCommands; }
+		ActorFactory &GetActorFactory(void) { return m_actorFactory; }
+		// Cached set of live actors matching DESC, kept current as actors change.
+		ActorQuery &GetQuery(const ActorQueryDesc &desc) { return m_actorQueries.GetQuery(desc); }
+		ComponentStore &GetComponentStore(void) { return m_componentStore; }
+		TransformHierarchy &GetTransforms(void) { return m_transforms; }
+		const LooseOctree &GetSpatialIndex(void) const { return m_spatialIndex.GetIndex(); }
+		JobSystem &GetJobSystem(void) { return m_jobSystem; }
+		SystemScheduler &GetSystemScheduler(void) { return m_systemScheduler; }
 	private:
 	};
 } // End namespace (BGE)
 
-#endif /* !_BGE_BASEGAMELOGIC_HPP_ */
\ No newline at end of file
+#endif /* !_BGE_BASEGAMELOGIC_HPP_ */
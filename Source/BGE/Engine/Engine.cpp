@@ -113,7 +113,7 @@ void BGE::EngineApp::OnUpdate(float deltaTime, float elapsedTime)
 	// TODO: Call update routines.
 }
 
-void BGE::EngineApp::OnRender(void)
+void BGE::EngineApp::OnRender(float interpAlpha)
 {
 	// TODO: Call rendering routines.
 }
@@ -77,7 +77,7 @@ namespace BGE
 		std::wstring GetString(std::wstring_view sID);
 		// These are marked static so it will be easier to pass them as arguments:
 		static void OnUpdate(float deltaTime, float elsapsedTime);
-		static void OnRender(void);
+		static void OnRender(float interpAlpha);
 		static void OnHandleEvent(const SDL_Event &event);
 		static void OnDisplayChange(int colorDepth, int width, int height);
 		void OnClose(void);
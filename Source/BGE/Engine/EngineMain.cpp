@@ -21,6 +21,12 @@
  *============================================================================*/
 #include "Engine/EngineStd.hpp"
 #include "Graphics/Screenshot.hpp"
+#include "Graphics/Renderer.hpp"
+#include "MainLoop/QualityGovernor.hpp"
+#include "MainLoop/StartupProfiler.hpp"
+#include "Multicore/ThreadPool.hpp"
+#include "Audio/Audio.hpp"
+#include "Audio/OpenALAudio.hpp"
 
 #include <csignal>
 #include <iostream>
@@ -31,11 +37,22 @@
 
 using namespace BGE;
 
+// Startup work that doesn't need the main thread, in flight on the init pool
+struct PrepareTasks
+{
+	std::future<bool> isDiskSpaceAvailable;
+	std::future<bool> isMemoryAvailable;
+	std::future<std::optional<std::string>> saveGameDir;
+	std::future<bool> isAudioInitialized;
+};
+
 static void DebugDumpClient(void *pUserPortion, std::size_t blockSize);
-static bool Prepare(void);
+static void Prepare(ThreadPool &pool, PrepareTasks &outTasks);
+static bool FinishPrepare(PrepareTasks &tasks);
 static bool Init(void);
+static void ShutdownAudio(void);
 static void Update(float deltaTime, float elapsedTime);
-static void Render(void);
+static void Render(float interpAlpha);
 static void HandleEvent(const SDL_Event &event);
 static void Shutdown(void);
 
@@ -43,6 +60,8 @@ static GLuint s_triangleVAO, s_triangleVBO;
 static constexpr GLuint s_kNUM_VERTICES = 3;
 static GLuint s_vertexShaderID, s_fragmentShaderID, s_programID;
 static std::string s_saveGameDir;
+static std::unique_ptr<OpenGLRenderer> s_pRenderer;
+static std::unique_ptr<Audio> s_pAudio;
 static constexpr const char *s_pkVERTEX_SHADER_SOURCE = R"vs(
 #version 420 compatibility
 
@@ -84,19 +103,37 @@ int BGE::EngineMain(int numArgs, char *pArgv[])
 	_CrtSetDbgFlag(tmpDbgFlag);
 	_CrtSetDumpClient(DebugDumpClient);
 #endif /* BGE_PLATFORM_WINDBG */
-	if (!Prepare())
 	{
-		BGE_ERROR("Engine preparation failure.");
-		return 1;
+		StartupProfiler::ScopedPhase phase("Logger::Init");
+		// Initialize logging system
+		Logger::Init("Logging.xml");
 	}
-
-	// Initialize logging system
-	Logger::Init("Logging.xml");
-	// Try to initialize the utility toolkit
-	if (!BGUTInit("Engine.xml"))
+	// Component IDs registered during static initialization can be reported now
+	ValidateComponentIDs();
 	{
-		BGE_ERROR("Couldn't initialize engine!");
-		return BGE_EXIT_FAILURE;
+		// The checks run on workers while BGUTInit, which must stay on this thread, creates the window
+		ThreadPool initPool;
+		PrepareTasks prepareTasks;
+		Prepare(initPool, prepareTasks);
+		// OpenGLRenderer resolves MSAA from its own target, so the window needn't pay for it too
+		BGUTSetRendererMultisampling(true);
+		// Try to initialize the utility toolkit
+		if (!BGUTInit("Engine.xml", kArgsSpan))
+		{
+			BGE_ERROR("Couldn't initialize engine!");
+			// The tasks still reference s_pAudio, so retire them before closing it
+			FinishPrepare(prepareTasks);
+			ShutdownAudio();
+			return BGE_EXIT_FAILURE;
+		}
+		
+		if (!FinishPrepare(prepareTasks))
+		{
+			BGE_ERROR("Engine preparation failure.");
+			ShutdownAudio();
+			BGUTShutdown();
+			return BGE_EXIT_FAILURE;
+		}
 	}
 	// Set the utility callbacks
 	//BGUTSetCallbackUpdate(EngineApp::OnUpdate);
@@ -109,7 +146,10 @@ int BGE::EngineMain(int numArgs, char *pArgv[])
 	//	return BGE_EXIT_FAILURE;
 	//}
 
-	Init();
+	{
+		StartupProfiler::ScopedPhase phase("App Init");
+		Init();
+	}
 	// TODO: Use SDL_Set/GetWindowData to set class object pointer.
 	BGUTSetCallbackUpdate(Update);
 	BGUTSetCallbackRender(Render);
@@ -138,13 +178,45 @@ void DebugDumpClient(void *pUserPortion, std::size_t blockSize)
 	std::fprintf(stderr, "Memory leak at: %llu, bytes allocated: %llu", address, blockSize);
 }
 
-bool Prepare(void)
+void Prepare(ThreadPool &pool, PrepareTasks &outTasks)
 {
 	HideConsole(); // TODO: This should be called by Logger based on configuration.
 	BGE_INFO("Platform: %s", GetPlatform().data());
 	BGE_INFO("CPU speed: %dMHz", ReadCPUSpeed());
 	BGE_INFO("Logical CPU cores: %d", ReadLogicalCPUCores());
-	if (!IsDiskSpaceAvailable(1'000))
+	// Each task only computes its result; it is reported on the main thread
+	outTasks.isDiskSpaceAvailable = pool.Submit([](void)
+	{
+		StartupProfiler::ScopedPhase phase("Check disk space");
+		return IsDiskSpaceAvailable(1'000);
+	});
+	outTasks.isMemoryAvailable = pool.Submit([](void)
+	{
+		StartupProfiler::ScopedPhase phase("Check memory");
+		return IsMemoryAvailable(1'000);
+	});
+	outTasks.saveGameDir = pool.Submit([](void)
+	{
+		StartupProfiler::ScopedPhase phase("Find save game directory");
+		return GetSaveGameDirectory("cppimmo", "Tank Battles");
+	});
+	s_pAudio = std::make_unique<Audio>();
+	outTasks.isAudioInitialized = pool.Submit([](void)
+	{
+		StartupProfiler::ScopedPhase phase("Open audio device");
+		return s_pAudio->VInitialize();
+	});
+}
+
+bool FinishPrepare(PrepareTasks &tasks)
+{
+	StartupProfiler::ScopedPhase phase("Wait for startup tasks");
+	// Collect every result before failing, so no task outlives its inputs
+	const bool kIsDiskSpaceAvailable = tasks.isDiskSpaceAvailable.get();
+	const bool kIsMemoryAvailable = tasks.isMemoryAvailable.get();
+	const auto kSaveGameDir = tasks.saveGameDir.get();
+	const bool kIsAudioInitialized = tasks.isAudioInitialized.get();
+	if (!kIsDiskSpaceAvailable)
 	{
 		BGE_ERROR("Not enough storage!");
 		return false;
@@ -154,7 +226,7 @@ bool Prepare(void)
 		BGE_INFO("Adequate storage is available.");
 	}
 	
-	if (!IsMemoryAvailable(1'000))
+	if (!kIsMemoryAvailable)
 	{
 		BGE_ERROR("Not enough memory!");
 		return false;
@@ -163,8 +235,6 @@ bool Prepare(void)
 	{
 		BGE_INFO("Adequate memory is available.");
 	}
-	
-	const auto kSaveGameDir = GetSaveGameDirectory("cppimmo", "Tank Battles");
 	// check for null optional
 	if (!kSaveGameDir)
 	{
@@ -176,11 +246,31 @@ bool Prepare(void)
 		BGE_INFO("Save game directory: %s", (*kSaveGameDir).c_str());
 		s_saveGameDir = *kSaveGameDir;
 	}
+	// The game can run without sound
+	BGE_WARNING_IF(!kIsAudioInitialized, "Couldn't open an audio device.");
 	return true;
 }
 
 bool Init(void)
 {
+	// No OpenGL resources can be created without a context
+	if (BGUTIsHeadless())
+		return true;
+
+	s_pRenderer = std::make_unique<OpenGLRenderer>();
+	if (!s_pRenderer->VInit(BGUTGetMultisamplingLevel()))
+	{
+		BGE_ERROR("Couldn't initialize renderer!");
+		return false;
+	}
+	if (BGUTIsQualityGovernorEnabled())
+	{
+		// Drop MSAA before resolution; scaling is the more visible change
+		QualityGovernor &governor = BGUTGetQualityGovernor();
+		governor.AddKnob(MakeRenderScaleKnob(*s_pRenderer, { 1.0f, 0.85f, 0.7f, 0.5f }, 1));
+		governor.AddKnob(MakeMultisamplingKnob(*s_pRenderer, BGUTGetMultisamplingLevel(), 0));
+	}
+
 	static constexpr GLfloat vertices[s_kNUM_VERTICES][3 + 3] =
 	{
 		{ -0.5f, -0.5f, 0.0f, 1.0f, 0.0f, 0.0f },
@@ -244,8 +334,11 @@ void Update(float deltaTime, float elapsedTime)
 	}
 }
 
-void Render(void)
+void Render(float interpAlpha)
 {
+	if (!s_pRenderer->VPreRender())
+		return;
+
 	constexpr float kCLEAR_COLOR[4] = { 0.0f, 0.5f, 1.0f, 1.0f };
 	glClearBufferfv(GL_COLOR, 0, kCLEAR_COLOR);
 
@@ -254,6 +347,7 @@ void Render(void)
 
 	glBindVertexArray(s_triangleVAO);
 	glDrawArrays(GL_TRIANGLES, 0, s_kNUM_VERTICES);
+	s_pRenderer->VPostRender();
 }
 
 void HandleEvent(const SDL_Event &event)
@@ -277,11 +371,26 @@ void HandleEvent(const SDL_Event &event)
 	}
 }
 
+void ShutdownAudio(void)
+{
+	if (s_pAudio)
+	{
+		s_pAudio->VShutdown();
+		s_pAudio.reset();
+	}
+}
+
 void Shutdown(void)
 {
+	ShutdownAudio();
+	if (BGUTIsHeadless())
+		return;
+
 	glDeleteBuffers(1, &s_triangleVBO);
 	glDeleteBuffers(1, &s_triangleVAO);
 	glDeleteShader(s_vertexShaderID);
 	glDeleteShader(s_fragmentShaderID);
 	glDeleteProgram(s_programID);
+	s_pRenderer->VShutdown();
+	s_pRenderer.reset();
 }
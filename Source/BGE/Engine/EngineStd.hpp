@@ -74,6 +74,8 @@
 #include "Utilities/Exception.hpp"
 #include "Utilities/String.hpp"
 #include "Utilities/Timer.hpp"
+#include "MainLoop/FrameLimiter.hpp"
+#include "MainLoop/Scheduler.hpp"
 #include "Utilities/Math.hpp"
 //#include "Utilities/Random.hpp"
 #include "Engine/BGUT.hpp"
@@ -68,6 +68,16 @@ namespace BGE
 	public:
 		virtual ~IGameView(void) = default;
 	};
+	/**
+	 * IRenderSnapshot is an immutable copy of the state needed to draw one frame.
+	 * With the pipelined main loop it is written by the update thread and read by
+	 * the render thread, never both at once.
+	 */
+	class IRenderSnapshot
+	{
+	public:
+		virtual ~IRenderSnapshot(void) = default;
+	};
 } // end namespace (BGE)
 
 #endif /* !_BGE_INTERFACES_HPP_ */
\ No newline at end of file
@@ -0,0 +1,147 @@
+/*=============================================================================*
+ * FrameBuffer.cpp - Offscreen framebuffer utilities.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "FrameBuffer.hpp"
+
+BGE::FrameBuffer::FrameBuffer(void)
+	: m_frameBufferID(0),
+	  m_colorID(0),
+	  m_depthStencilID(0),
+	  m_resolveFrameBufferID(0),
+	  m_resolveColorID(0),
+	  m_width(0),
+	  m_height(0),
+	  m_numSamples(0)
+{
+}
+
+BGE::FrameBuffer::~FrameBuffer(void)
+{
+	Destroy();
+}
+
+bool BGE::FrameBuffer::Create(int width, int height, int numSamples)
+{
+	Destroy();
+	if (width <= 0 || height <= 0)
+	{
+		BGE_ERROR("FrameBuffer::Create Failure: Invalid size (%dx%d)!", width, height);
+		return false;
+	}
+	// Clamp to what the implementation supports
+	GLint maxSamples = 0;
+	glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+	numSamples = std::clamp(numSamples, 0, static_cast<int>(maxSamples));
+
+	glCreateFramebuffers(1, &m_frameBufferID);
+	glCreateRenderbuffers(1, &m_depthStencilID);
+	if (numSamples > 0)
+	{
+		// Multisampled color can't be sampled directly, so use a renderbuffer
+		glCreateRenderbuffers(1, &m_colorID);
+		glNamedRenderbufferStorageMultisample(m_colorID, numSamples, GL_RGBA8, width, height);
+		glNamedFramebufferRenderbuffer(m_frameBufferID, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorID);
+		glNamedRenderbufferStorageMultisample(m_depthStencilID, numSamples, GL_DEPTH24_STENCIL8, width, height);
+		// Single sample target to resolve into
+		glCreateFramebuffers(1, &m_resolveFrameBufferID);
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_resolveColorID);
+		glTextureStorage2D(m_resolveColorID, 1, GL_RGBA8, width, height);
+		glTextureParameteri(m_resolveColorID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_resolveColorID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glNamedFramebufferTexture(m_resolveFrameBufferID, GL_COLOR_ATTACHMENT0, m_resolveColorID, 0);
+	}
+	else
+	{
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_colorID);
+		glTextureStorage2D(m_colorID, 1, GL_RGBA8, width, height);
+		glTextureParameteri(m_colorID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_colorID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(m_colorID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(m_colorID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glNamedFramebufferTexture(m_frameBufferID, GL_COLOR_ATTACHMENT0, m_colorID, 0);
+		glNamedRenderbufferStorage(m_depthStencilID, GL_DEPTH24_STENCIL8, width, height);
+	}
+	glNamedFramebufferRenderbuffer(m_frameBufferID, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthStencilID);
+
+	m_width = width;
+	m_height = height;
+	m_numSamples = numSamples;
+
+	if (glCheckNamedFramebufferStatus(m_frameBufferID, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE ||
+		(m_resolveFrameBufferID != 0 &&
+		 glCheckNamedFramebufferStatus(m_resolveFrameBufferID, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE))
+	{
+		BGE_ERROR("FrameBuffer::Create Failure: Framebuffer is incomplete (%dx%d, %d samples)!",
+				  width, height, numSamples);
+		Destroy();
+		return false;
+	}
+	return true;
+}
+
+void BGE::FrameBuffer::Destroy(void)
+{
+	// Deleting the name 0 is silently ignored
+	glDeleteFramebuffers(1, &m_resolveFrameBufferID);
+	glDeleteTextures(1, &m_resolveColorID);
+	if (m_numSamples > 0)
+		glDeleteRenderbuffers(1, &m_colorID);
+	else
+		glDeleteTextures(1, &m_colorID);
+	glDeleteRenderbuffers(1, &m_depthStencilID);
+	glDeleteFramebuffers(1, &m_frameBufferID);
+
+	m_frameBufferID = m_colorID = m_depthStencilID = 0;
+	m_resolveFrameBufferID = m_resolveColorID = 0;
+	m_width = m_height = m_numSamples = 0;
+}
+
+void BGE::FrameBuffer::Bind(void) const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferID);
+	glViewport(0, 0, m_width, m_height);
+}
+
+void BGE::FrameBuffer::BindDefault(void)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void BGE::FrameBuffer::BlitTo(GLuint dstFrameBufferID, int dstWidth, int dstHeight, GLenum filter) const
+{
+	GLuint srcFrameBufferID = m_frameBufferID;
+	// A multisampled blit can't scale; resolve at the same size first
+	if (m_numSamples > 0)
+	{
+		glBlitNamedFramebuffer(m_frameBufferID, m_resolveFrameBufferID, 0, 0, m_width, m_height,
+							   0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		srcFrameBufferID = m_resolveFrameBufferID;
+	}
+	glBlitNamedFramebuffer(srcFrameBufferID, dstFrameBufferID, 0, 0, m_width, m_height,
+						   0, 0, dstWidth, dstHeight, GL_COLOR_BUFFER_BIT, filter);
+}
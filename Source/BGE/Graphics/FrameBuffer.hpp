@@ -0,0 +1,72 @@
+/*=============================================================================*
+ * FrameBuffer.hpp - Offscreen framebuffer utilities.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_FRAMEBUFFER_HPP_
+#define _BGE_FRAMEBUFFER_HPP_
+
+namespace BGE
+{
+	/**
+	 * FrameBuffer is an offscreen render target with a color and depth/stencil
+	 * attachment. When multisampled, it resolves into an internal single sample
+	 * target before being blitted (and scaled) to another framebuffer.
+	 */
+	class FrameBuffer
+	{
+	private:
+		GLuint m_frameBufferID;
+		GLuint m_colorID; // Texture, or renderbuffer when multisampled
+		GLuint m_depthStencilID; // Renderbuffer
+		GLuint m_resolveFrameBufferID; // Only when multisampled
+		GLuint m_resolveColorID;
+		int m_width;
+		int m_height;
+		int m_numSamples;
+	public:
+		FrameBuffer(void);
+		~FrameBuffer(void);
+		FrameBuffer(const FrameBuffer &) = delete;
+		FrameBuffer &operator=(const FrameBuffer &) = delete;
+
+		// (Re)create the attachments; NUMSAMPLES of 0 disables multisampling.
+		bool Create(int width, int height, int numSamples);
+		void Destroy(void);
+		bool IsValid(void) const { return m_frameBufferID != 0; }
+		void Bind(void) const;
+		static void BindDefault(void);
+		// Resolve and scale the color attachment into DSTFRAMEBUFFERID (0 is the window).
+		void BlitTo(GLuint dstFrameBufferID, int dstWidth, int dstHeight, GLenum filter = GL_LINEAR) const;
+		GLuint GetID(void) const { return m_frameBufferID; }
+		// Single sample color texture (the resolve target when multisampled)
+		GLuint GetColorTexture(void) const { return (m_numSamples > 0) ? m_resolveColorID : m_colorID; }
+		int GetWidth(void) const { return m_width; }
+		int GetHeight(void) const { return m_height; }
+		int GetNumSamples(void) const { return m_numSamples; }
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_FRAMEBUFFER_HPP_ */
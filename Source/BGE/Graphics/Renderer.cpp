@@ -28,6 +28,97 @@
 #include "Engine/EngineStd.hpp"
 #include "Renderer.hpp"
 
+BGE::OpenGLRenderer::OpenGLRenderer(void)
+	: m_sceneTarget(),
+	  m_renderScale(1.0f),
+	  m_numSamples(0),
+	  m_outputWidth(0),
+	  m_outputHeight(0),
+	  m_isTargetDirty(true),
+	  m_isUsingTarget(false)
+{
+}
+
+BGE::OpenGLRenderer::~OpenGLRenderer(void)
+{
+	VShutdown();
+}
+
+bool BGE::OpenGLRenderer::VInit(int numSamples)
+{
+	VSetMultisampling(numSamples);
+	return true;
+}
+
+void BGE::OpenGLRenderer::VShutdown(void)
+{
+	m_sceneTarget.Destroy();
+	m_isTargetDirty = true;
+}
+
+bool BGE::OpenGLRenderer::VPreRender(void)
+{
+	int outputWidth = 0, outputHeight = 0;
+	SDL_GL_GetDrawableSize(BGUTGetWindowPtr(), &outputWidth, &outputHeight);
+	if (outputWidth <= 0 || outputHeight <= 0) // Minimized
+		return false;
+
+	m_isUsingTarget = (m_renderScale < 1.0f || m_numSamples > 0);
+	if (!m_isUsingTarget)
+	{
+		m_outputWidth = outputWidth;
+		m_outputHeight = outputHeight;
+		FrameBuffer::BindDefault();
+		glViewport(0, 0, m_outputWidth, m_outputHeight);
+		return true;
+	}
+	// Recreate the target when the window or the quality settings changed
+	const int kTargetWidth = std::max(1, static_cast<int>(std::lround(outputWidth * m_renderScale)));
+	const int kTargetHeight = std::max(1, static_cast<int>(std::lround(outputHeight * m_renderScale)));
+	if (m_isTargetDirty || !m_sceneTarget.IsValid() || kTargetWidth != m_sceneTarget.GetWidth() ||
+		kTargetHeight != m_sceneTarget.GetHeight())
+	{
+		if (!m_sceneTarget.Create(kTargetWidth, kTargetHeight, m_numSamples))
+		{
+			m_isUsingTarget = false;
+			FrameBuffer::BindDefault();
+			return false;
+		}
+		m_isTargetDirty = false;
+	}
+	m_outputWidth = outputWidth;
+	m_outputHeight = outputHeight;
+	m_sceneTarget.Bind();
+	return true;
+}
+
+void BGE::OpenGLRenderer::VPostRender(void)
+{
+	if (!m_isUsingTarget)
+		return;
+	FrameBuffer::BindDefault();
+	m_sceneTarget.BlitTo(0, m_outputWidth, m_outputHeight, GL_LINEAR);
+	glViewport(0, 0, m_outputWidth, m_outputHeight);
+}
+
+void BGE::OpenGLRenderer::VSetRenderScale(float renderScale)
+{
+	renderScale = std::clamp(renderScale, 0.1f, 1.0f);
+	if (renderScale == m_renderScale)
+		return;
+	m_renderScale = renderScale;
+	m_isTargetDirty = true;
+}
+
+void BGE::OpenGLRenderer::VSetMultisampling(int numSamples)
+{
+	numSamples = std::max(numSamples, 0);
+	if (numSamples == m_numSamples)
+		return;
+	m_numSamples = numSamples;
+	m_isTargetDirty = true;
+}
+
 int BGE::GetMaxVertexAttribs(void)
 {
 	GLint numAttribs = 0;
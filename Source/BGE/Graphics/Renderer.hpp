@@ -28,6 +28,8 @@
 #ifndef _BGE_RENDERER_HPP_
 #define _BGE_RENDERER_HPP_
 
+#include "Graphics/FrameBuffer.hpp"
+
 namespace BGE
 {
 	class IStringable;
@@ -39,8 +41,17 @@ namespace BGE
 	public:
 		virtual ~IRenderer(void) = default;
 		//virtual void VSetBackgroundColor(float r, float g, float b, float a) = 0;
-		//virtual void VShutdown(void) = 0;
-		//virtual bool VPreRender(void) = 0;
+		virtual bool VInit(int numSamples) = 0;
+		virtual void VShutdown(void) = 0;
+		// Bind the scene target; draw the scene between these two calls.
+		virtual bool VPreRender(void) = 0;
+		// Present the scene target to the window (UI is drawn after, at full resolution).
+		virtual void VPostRender(void) = 0;
+		// Fraction of the window resolution the scene is rendered at.
+		virtual void VSetRenderScale(float renderScale) = 0;
+		virtual float VGetRenderScale(void) const = 0;
+		virtual void VSetMultisampling(int numSamples) = 0;
+		virtual int VGetMultisampling(void) const = 0;
 	protected:
 	private:
 	};
@@ -51,9 +62,34 @@ namespace BGE
 		virtual ~IRenderState(void) = default;
 		std::string VToString(void) const = 0;
 	};
-
+	/**
+	 * OpenGLRenderer draws the scene into an offscreen FrameBuffer sized by the
+	 * render scale, then resolves and upscales it into the window. At full scale
+	 * without multisampling the scene is drawn straight to the window, which should
+	 * be single sample (see BGUTSetRendererMultisampling()).
+	 */
 	class OpenGLRenderer : public IRenderer
 	{
+	private:
+		FrameBuffer m_sceneTarget;
+		float m_renderScale;
+		int m_numSamples;
+		int m_outputWidth; // Window drawable size
+		int m_outputHeight;
+		bool m_isTargetDirty; // Scale or samples changed since the target was created
+		bool m_isUsingTarget; // False when rendering straight to the window
+	public:
+		OpenGLRenderer(void);
+		virtual ~OpenGLRenderer(void);
+
+		virtual bool VInit(int numSamples) override;
+		virtual void VShutdown(void) override;
+		virtual bool VPreRender(void) override;
+		virtual void VPostRender(void) override;
+		virtual void VSetRenderScale(float renderScale) override;
+		virtual float VGetRenderScale(void) const override { return m_renderScale; }
+		virtual void VSetMultisampling(int numSamples) override;
+		virtual int VGetMultisampling(void) const override { return m_numSamples; }
 	};
 
 	int GetMaxVertexAttribs(void);
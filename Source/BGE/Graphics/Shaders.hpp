@@ -108,23 +108,39 @@ namespace BGE
 			//if (result) glProgramUniform4f(m_programID, *result, vec4);
 		}
 
-		template <Math::Numeric Type>
+		// Matrices are stored column-major like GL expects, so they upload in place.
+		template <Math::FloatingPoint Type>
 		void SetMat2x2(std::string_view uniformName, const Math::Mat2x2<Type> &mat2x2)
 		{
 			auto result = GetShaderUniformLocation(m_programID, uniformName);
-			BGE_ASSERT(!result.has_value());
+			BGE_ASSERT(result.has_value());
+			if (!result) return;
+			if constexpr (std::is_same_v<Type, double>)
+				glProgramUniformMatrix2dv(m_programID, *result, 1, GL_FALSE, mat2x2.GetData());
+			else
+				glProgramUniformMatrix2fv(m_programID, *result, 1, GL_FALSE, mat2x2.GetData());
 		}
-		template <Math::Numeric Type>
+		template <Math::FloatingPoint Type>
 		void SetMat3x3(std::string_view uniformName, const Math::Mat3x3<Type> &mat3x3)
 		{
 			auto result = GetShaderUniformLocation(m_programID, uniformName);
-			BGE_ASSERT(!result.has_value());
+			BGE_ASSERT(result.has_value());
+			if (!result) return;
+			if constexpr (std::is_same_v<Type, double>)
+				glProgramUniformMatrix3dv(m_programID, *result, 1, GL_FALSE, mat3x3.GetData());
+			else
+				glProgramUniformMatrix3fv(m_programID, *result, 1, GL_FALSE, mat3x3.GetData());
 		}
-		template <Math::Numeric Type>
+		template <Math::FloatingPoint Type>
 		void SetMat4x4(std::string_view uniformName, const Math::Mat4x4<Type> &mat4x4)
 		{
 			auto result = GetShaderUniformLocation(m_programID, uniformName);
-			BGE_ASSERT(!result.has_value());
+			BGE_ASSERT(result.has_value());
+			if (!result) return;
+			if constexpr (std::is_same_v<Type, double>)
+				glProgramUniformMatrix4dv(m_programID, *result, 1, GL_FALSE, mat4x4.GetData());
+			else
+				glProgramUniformMatrix4fv(m_programID, *result, 1, GL_FALSE, mat4x4.GetData());
 		}
 	};
 	
@@ -0,0 +1,163 @@
+/*=============================================================================*
+ * InputEventQueue.cpp - Batched SDL event queue.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "InputEventQueue.hpp"
+
+BGE::InputEventQueue::InputEventQueue(std::size_t capacity)
+	: m_events(),
+	  m_groupedEvents(),
+	  m_categoryOffsets(),
+	  m_toCoalesceMotion(true),
+	  m_stats()
+{
+	// Reserve up front so a typical frame never allocates
+	m_events.reserve(capacity);
+	m_groupedEvents.reserve(capacity);
+}
+
+std::span<const SDL_Event> BGE::InputEventQueue::Poll(void)
+{
+	m_events.clear();
+	m_stats = {};
+
+	SDL_PumpEvents(); // Gather events from the OS once
+	std::array<SDL_Event, kBATCH_SIZE> batch;
+	int numPeeped = 0;
+	do
+	{
+		numPeeped = SDL_PeepEvents(batch.data(), static_cast<int>(batch.size()), SDL_GETEVENT,
+								   SDL_FIRSTEVENT, SDL_LASTEVENT);
+		if (numPeeped < 0)
+		{
+			BGE_ERROR("InputEventQueue::Poll Failure: Couldn't peep events (%s).", SDL_GetError());
+			break;
+		}
+
+		for (int index = 0; index < numPeeped; ++index)
+			Append(batch[index]);
+		m_stats.numReceived += static_cast<std::size_t>(numPeeped);
+	} while (numPeeped == static_cast<int>(batch.size())); // A full batch means more may be waiting
+
+	GroupByCategory();
+	return m_events;
+}
+
+void BGE::InputEventQueue::Push(const SDL_Event &event)
+{
+	Append(event);
+	GroupByCategory();
+}
+
+void BGE::InputEventQueue::Assign(std::span<const SDL_Event> events)
+{
+	m_events.assign(events.begin(), events.end());
+	m_stats = {};
+	m_stats.numReceived = events.size();
+	GroupByCategory();
+}
+
+void BGE::InputEventQueue::Clear(void)
+{
+	m_events.clear();
+	m_groupedEvents.clear();
+	m_categoryOffsets = {};
+	m_stats = {};
+}
+
+std::span<const SDL_Event> BGE::InputEventQueue::GetEvents(InputEventCategory category) const
+{
+	const auto kIndex = static_cast<std::size_t>(category);
+	BGE_ASSERT(kIndex < kNUM_CATEGORIES);
+	const std::span<const SDL_Event> kGrouped(m_groupedEvents);
+	return kGrouped.subspan(m_categoryOffsets[kIndex], m_categoryOffsets[kIndex + 1] - m_categoryOffsets[kIndex]);
+}
+
+void BGE::InputEventQueue::SetEventTypeEnabled(Uint32 eventType, bool isEnabled)
+{
+	SDL_EventState(eventType, (isEnabled) ? SDL_ENABLE : SDL_IGNORE);
+}
+
+BGE::InputEventCategory BGE::InputEventQueue::GetCategory(Uint32 eventType)
+{
+	// SDL event types are grouped in ranges of 0x100 (see SDL_events.h)
+	if (eventType >= SDL_QUIT && eventType < SDL_WINDOWEVENT)
+		return InputEventCategory::Application;
+	if (eventType >= SDL_WINDOWEVENT && eventType < SDL_KEYDOWN)
+		return InputEventCategory::Window;
+	if (eventType >= SDL_KEYDOWN && eventType < SDL_MOUSEMOTION)
+		return InputEventCategory::Keyboard;
+	if (eventType >= SDL_MOUSEMOTION && eventType < SDL_JOYAXISMOTION)
+		return InputEventCategory::Mouse;
+	if (eventType >= SDL_JOYAXISMOTION && eventType < SDL_CONTROLLERAXISMOTION)
+		return InputEventCategory::Joystick;
+	if (eventType >= SDL_CONTROLLERAXISMOTION && eventType < SDL_FINGERDOWN)
+		return InputEventCategory::Gamepad;
+	if (eventType >= SDL_FINGERDOWN && eventType < SDL_FINGERDOWN + 0x200) // Fingers and gestures
+		return InputEventCategory::Touch;
+	return InputEventCategory::Other;
+}
+
+void BGE::InputEventQueue::Append(const SDL_Event &event)
+{
+	if (m_toCoalesceMotion && event.type == SDL_MOUSEMOTION && !m_events.empty())
+	{
+		auto &prevEvent = m_events.back();
+		// Only merge adjacent motion so ordering against clicks is preserved
+		if (prevEvent.type == SDL_MOUSEMOTION && prevEvent.motion.windowID == event.motion.windowID &&
+			prevEvent.motion.which == event.motion.which)
+		{
+			// Keep the latest position and state, accumulate relative motion
+			const Sint32 kXRel = prevEvent.motion.xrel + event.motion.xrel;
+			const Sint32 kYRel = prevEvent.motion.yrel + event.motion.yrel;
+			prevEvent = event;
+			prevEvent.motion.xrel = kXRel;
+			prevEvent.motion.yrel = kYRel;
+			++m_stats.numCoalesced;
+			return;
+		}
+	}
+	m_events.push_back(event);
+}
+
+void BGE::InputEventQueue::GroupByCategory(void)
+{
+	// Counting sort: stable, linear, and reuses the reserved storage
+	std::array<std::size_t, kNUM_CATEGORIES> counts{};
+	for (const auto &kEvent : m_events)
+		++counts[static_cast<std::size_t>(GetCategory(kEvent.type))];
+
+	m_categoryOffsets[0] = 0;
+	for (std::size_t index = 0; index < kNUM_CATEGORIES; ++index)
+		m_categoryOffsets[index + 1] = m_categoryOffsets[index] + counts[index];
+
+	m_groupedEvents.resize(m_events.size());
+	std::array<std::size_t, kNUM_CATEGORIES> cursors;
+	std::copy_n(m_categoryOffsets.begin(), kNUM_CATEGORIES, cursors.begin());
+	for (const auto &kEvent : m_events)
+		m_groupedEvents[cursors[static_cast<std::size_t>(GetCategory(kEvent.type))]++] = kEvent;
+}
@@ -0,0 +1,94 @@
+/*=============================================================================*
+ * InputEventQueue.hpp - Batched SDL event queue.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_INPUTEVENTQUEUE_HPP_
+#define _BGE_INPUTEVENTQUEUE_HPP_
+
+#include <array>
+
+namespace BGE
+{
+	// Groups of SDL event types, each stored contiguously by InputEventQueue.
+	enum class InputEventCategory : int
+	{
+		Application, // Quit, app lifecycle, display
+		Window,
+		Keyboard, // Keys and text input
+		Mouse,
+		Joystick,
+		Gamepad,
+		Touch, // Fingers, gestures
+		Other, // Drop, audio device, sensor, user events...
+		Count
+	};
+	/**
+	 * InputEventQueue pulls pending SDL events in batches with SDL_PeepEvents
+	 * into preallocated storage once per frame. Runs of mouse motion are
+	 * coalesced into a single event. Consumers read spans, either in arrival
+	 * order or grouped by category.
+	 */
+	class InputEventQueue : public INonCopyable
+	{
+	public:
+		static constexpr std::size_t kDEFAULT_CAPACITY = 256;
+		static constexpr std::size_t kBATCH_SIZE = 64; // Events per SDL_PeepEvents call
+		struct Stats
+		{
+			std::size_t numReceived = 0; // Events pulled from SDL last poll
+			std::size_t numCoalesced = 0; // Events merged into a previous one last poll
+		};
+	private:
+		static constexpr std::size_t kNUM_CATEGORIES = static_cast<std::size_t>(InputEventCategory::Count);
+
+		std::vector<SDL_Event> m_events; // Arrival order
+		std::vector<SDL_Event> m_groupedEvents; // Stable sorted by category
+		std::array<std::size_t, kNUM_CATEGORIES + 1> m_categoryOffsets; // Into m_groupedEvents
+		bool m_toCoalesceMotion;
+		Stats m_stats;
+	public:
+		explicit InputEventQueue(std::size_t capacity = kDEFAULT_CAPACITY);
+		// Pump SDL and drain every pending event, replacing the previous frame's events.
+		std::span<const SDL_Event> Poll(void);
+		// Append an event from outside SDL (e.g. replays); visible until the next Poll().
+		void Push(const SDL_Event &event);
+		// Replace the frame's events with EVENTS as given, without coalescing.
+		void Assign(std::span<const SDL_Event> events);
+		void Clear(void);
+		std::span<const SDL_Event> GetEvents(void) const { return m_events; }
+		std::span<const SDL_Event> GetEvents(InputEventCategory category) const;
+		void SetCoalesceMouseMotion(bool toCoalesce) { m_toCoalesceMotion = toCoalesce; }
+		const Stats &GetStats(void) const { return m_stats; }
+		// Drop an event type inside SDL so it is never queued.
+		static void SetEventTypeEnabled(Uint32 eventType, bool isEnabled);
+		static InputEventCategory GetCategory(Uint32 eventType);
+	private:
+		void Append(const SDL_Event &event);
+		void GroupByCategory(void);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_INPUTEVENTQUEUE_HPP_ */
@@ -0,0 +1,147 @@
+/*=============================================================================*
+ * FrameLimiter.cpp - Precise frame rate limiter.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "FrameLimiter.hpp"
+
+#if BGE_PLATFORM_LINUX
+#include <time.h>
+#include <cerrno>
+#endif
+
+#include <thread>
+
+namespace ch = std::chrono;
+
+BGE::FrameLimiter::FrameLimiter(double targetRateHz, double spinMicros)
+	: m_period(),
+	  m_spinTime(),
+	  m_deadline(Clock::now()),
+	  m_stats(),
+	  m_errorM2(0.0)
+{
+	SetTargetRate(targetRateHz);
+	SetSpinTime(spinMicros);
+}
+
+void BGE::FrameLimiter::SetTargetRate(double targetRateHz)
+{
+	// Protect from divide by zero UB
+	if (targetRateHz <= 0.0)
+		targetRateHz = 60.0;
+	m_period = ch::duration_cast<Nanoseconds>(ch::duration<double>(1.0 / targetRateHz));
+}
+
+double BGE::FrameLimiter::GetTargetRate(void) const
+{
+	return 1.0 / ch::duration<double>(m_period).count();
+}
+
+void BGE::FrameLimiter::SetSpinTime(double spinMicros)
+{
+	m_spinTime = ch::duration_cast<Nanoseconds>(ch::duration<double, std::micro>(std::max(spinMicros, 0.0)));
+}
+
+void BGE::FrameLimiter::Reset(void)
+{
+	m_deadline = Clock::now() + m_period;
+}
+
+void BGE::FrameLimiter::Wait(void)
+{
+	const auto kNow = Clock::now();
+	if (kNow >= m_deadline)
+	{
+		// The frame overran its budget; resync instead of bursting to catch up
+		++m_stats.numLateFrames;
+		m_deadline = kNow + m_period;
+		return;
+	}
+	// Sleep for the bulk of the wait, then spin the remainder
+	if (m_deadline - kNow > m_spinTime)
+		SleepUntil(m_deadline - m_spinTime);
+	auto wakeTime = Clock::now();
+	while (wakeTime < m_deadline)
+		wakeTime = Clock::now();
+
+	RecordError(ch::duration<double, std::micro>(wakeTime - m_deadline).count());
+	// Advance from the deadline (not the wake time) so errors don't accumulate
+	m_deadline += m_period;
+}
+
+void BGE::FrameLimiter::ResetStats(void)
+{
+	m_stats = {};
+	m_errorM2 = 0.0;
+}
+
+void BGE::FrameLimiter::LogStats(void) const
+{
+	BGE_INFO("Frame pacing: target %.2f Hz, %llu frames, %llu late frames",
+			 GetTargetRate(), static_cast<unsigned long long>(m_stats.numFrames),
+			 static_cast<unsigned long long>(m_stats.numLateFrames));
+	BGE_INFO("Frame pacing error (us): mean %.2f, std dev %.2f, min %.2f, max %.2f",
+			 m_stats.meanErrorMicros, m_stats.stdDevErrorMicros, m_stats.minErrorMicros, m_stats.maxErrorMicros);
+}
+
+void BGE::FrameLimiter::SleepUntil(Clock::time_point wakeTime) const
+{
+#if BGE_PLATFORM_LINUX
+	// steady_clock is CLOCK_MONOTONIC on Linux, so the time points are comparable
+	const auto kSinceEpoch = ch::duration_cast<Nanoseconds>(wakeTime.time_since_epoch()).count();
+	timespec wakeSpec;
+	wakeSpec.tv_sec = static_cast<time_t>(kSinceEpoch / 1'000'000'000);
+	wakeSpec.tv_nsec = static_cast<long>(kSinceEpoch % 1'000'000'000);
+	// An absolute deadline is immune to drift when interrupted by signals
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeSpec, nullptr) == EINTR)
+	{
+	}
+#else
+	std::this_thread::sleep_until(wakeTime);
+#endif
+}
+
+void BGE::FrameLimiter::RecordError(double errorMicros)
+{
+	if (m_stats.numFrames == 0)
+	{
+		m_stats.minErrorMicros = errorMicros;
+		m_stats.maxErrorMicros = errorMicros;
+	}
+	else
+	{
+		m_stats.minErrorMicros = std::min(m_stats.minErrorMicros, errorMicros);
+		m_stats.maxErrorMicros = std::max(m_stats.maxErrorMicros, errorMicros);
+	}
+	// Welford's online mean and variance
+	++m_stats.numFrames;
+	const double kDelta = errorMicros - m_stats.meanErrorMicros;
+	m_stats.meanErrorMicros += kDelta / static_cast<double>(m_stats.numFrames);
+	m_errorM2 += kDelta * (errorMicros - m_stats.meanErrorMicros);
+	m_stats.stdDevErrorMicros = (m_stats.numFrames > 1)
+		? std::sqrt(m_errorM2 / static_cast<double>(m_stats.numFrames - 1)) : 0.0;
+}
@@ -0,0 +1,78 @@
+/*=============================================================================*
+ * FrameLimiter.hpp - Precise frame rate limiter.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_FRAMELIMITER_HPP_
+#define _BGE_FRAMELIMITER_HPP_
+
+namespace BGE
+{
+	/**
+	 * Paces frames to a fixed period. The bulk of the wait is spent asleep
+	 * (clock_nanosleep on Linux) and only the last m_spinTime (see SetSpinTime()) is spun, so
+	 * wakeups land close to the deadline without pegging a core.
+	 */
+	class FrameLimiter
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		using Nanoseconds = std::chrono::nanoseconds;
+		// Wake-up error relative to each deadline (positive is late)
+		struct Stats
+		{
+			std::uint64_t numFrames = 0; // Frames that waited
+			std::uint64_t numLateFrames = 0; // Frames that overran the period before waiting
+			double meanErrorMicros = 0.0;
+			double stdDevErrorMicros = 0.0;
+			double minErrorMicros = 0.0;
+			double maxErrorMicros = 0.0;
+		};
+	private:
+		Nanoseconds m_period;
+		Nanoseconds m_spinTime;
+		Clock::time_point m_deadline;
+		Stats m_stats;
+		double m_errorM2; // Running sum of squared differences (Welford)
+	public:
+		explicit FrameLimiter(double targetRateHz = 60.0, double spinMicros = 200.0);
+
+		void SetTargetRate(double targetRateHz);
+		double GetTargetRate(void) const;
+		void SetSpinTime(double spinMicros);
+		// Start pacing from the current time.
+		void Reset(void);
+		// Block until the end of the current frame period.
+		void Wait(void);
+		const Stats &GetStats(void) const { return m_stats; }
+		void ResetStats(void);
+		void LogStats(void) const;
+	private:
+		void SleepUntil(Clock::time_point wakeTime) const;
+		void RecordError(double errorMicros);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_FRAMELIMITER_HPP_ */
@@ -44,11 +44,11 @@
 
 namespace fs = std::filesystem;
 
-std::span<std::string_view> BGE::GetArguments(int numArgs, char *pArgs[])
+std::vector<std::string_view> BGE::GetArguments(int numArgs, char *pArgs[])
 {
-	// From C++ Weekly - Ep 361
+	// From C++ Weekly - Ep 361 (returned by value; a span would dangle once argsVec is destroyed)
 	std::vector<std::string_view> argsVec(pArgs, std::next(pArgs, static_cast<std::ptrdiff_t>(numArgs)));
-	return std::span(argsVec.data(), argsVec.size());
+	return argsVec;
 }
 
 std::string_view BGE::GetPlatform(void)
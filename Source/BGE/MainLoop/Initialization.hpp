@@ -36,7 +36,7 @@
 namespace BGE
 {
 	//! Retrieve cmdline args as a string container.
-	[[nodiscard]] std::span<std::string_view> GetArguments(int numArgs, char *pArgs[]);
+	[[nodiscard]] std::vector<std::string_view> GetArguments(int numArgs, char *pArgs[]);
 	//! Get runtime platform string.
 	std::string_view GetPlatform(void);
 	//! Ensure available disk space in MiB.
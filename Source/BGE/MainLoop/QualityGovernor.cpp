@@ -0,0 +1,214 @@
+/*=============================================================================*
+ * QualityGovernor.cpp - Adaptive quality governor.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "QualityGovernor.hpp"
+
+#include "Graphics/Renderer.hpp"
+
+BGE::QualityGovernor::QualityGovernor(void)
+	: QualityGovernor(Settings())
+{
+}
+
+BGE::QualityGovernor::QualityGovernor(const Settings &settings)
+	: m_settings(),
+	  m_knobs(),
+	  m_samples(),
+	  m_scratch(),
+	  m_lastPercentileMillis(0.0),
+	  m_numGoodWindows(0),
+	  m_nextHandle(kINVALID_QUALITY_KNOB_HANDLE + 1),
+	  m_isEnabled(true)
+{
+	SetSettings(settings);
+}
+
+void BGE::QualityGovernor::SetSettings(const Settings &settings)
+{
+	m_settings = settings;
+	m_settings.windowSize = std::max<std::size_t>(m_settings.windowSize, 1);
+	m_settings.percentile = std::clamp(m_settings.percentile, 0.0, 1.0);
+	m_samples.clear();
+	m_samples.reserve(m_settings.windowSize);
+	m_scratch.reserve(m_settings.windowSize);
+	m_numGoodWindows = 0;
+}
+
+BGE::QualityKnobHandle BGE::QualityGovernor::AddKnob(QualityKnob knob)
+{
+	if (knob.numLevels < 1 || !knob.applyLevel)
+	{
+		BGE_ERROR("QualityGovernor::AddKnob Failure: Knob (%s) needs levels and an apply function!", knob.name.c_str());
+		return kINVALID_QUALITY_KNOB_HANDLE;
+	}
+	knob.applyLevel(0);
+
+	const QualityKnobHandle kHandle = m_nextHandle++;
+	m_knobs.push_back({ kHandle, std::move(knob), 0 });
+	// Keep degrade order: lowest priority first, registration order breaks ties
+	std::stable_sort(m_knobs.begin(), m_knobs.end(),
+					 [](const Knob &lhs, const Knob &rhs) { return lhs.desc.priority < rhs.desc.priority; });
+	return kHandle;
+}
+
+bool BGE::QualityGovernor::RemoveKnob(QualityKnobHandle handle)
+{
+	return std::erase_if(m_knobs, [handle](const Knob &knob) { return knob.handle == handle; }) > 0;
+}
+
+std::optional<int> BGE::QualityGovernor::GetKnobLevel(QualityKnobHandle handle) const
+{
+	for (const auto &kKnob : m_knobs)
+	{
+		if (kKnob.handle == handle)
+			return kKnob.level;
+	}
+	return std::nullopt;
+}
+
+void BGE::QualityGovernor::AddFrameTime(double frameMillis)
+{
+	if (!m_isEnabled)
+		return;
+	m_samples.push_back(frameMillis);
+	if (m_samples.size() >= m_settings.windowSize)
+		Evaluate();
+}
+
+void BGE::QualityGovernor::Evaluate(void)
+{
+	// Select the percentile without fully sorting
+	m_scratch.assign(m_samples.begin(), m_samples.end());
+	const auto kIndex = static_cast<std::size_t>(m_settings.percentile * static_cast<double>(m_scratch.size() - 1));
+	std::nth_element(m_scratch.begin(), m_scratch.begin() + static_cast<std::ptrdiff_t>(kIndex), m_scratch.end());
+	m_lastPercentileMillis = m_scratch[kIndex];
+	m_samples.clear();
+
+	const double kTarget = m_settings.targetFrameMillis;
+	if (m_lastPercentileMillis > kTarget * m_settings.degradeRatio)
+	{
+		m_numGoodWindows = 0;
+		if (Degrade())
+			BGE_INFO("QualityGovernor: p%.0f %.2f ms over %.2f ms budget, lowering quality.",
+					 m_settings.percentile * 100.0, m_lastPercentileMillis, kTarget);
+	}
+	else if (m_lastPercentileMillis < kTarget * m_settings.upgradeRatio)
+	{
+		if (++m_numGoodWindows >= m_settings.numUpgradeWindows)
+		{
+			m_numGoodWindows = 0;
+			if (Upgrade())
+				BGE_INFO("QualityGovernor: p%.0f %.2f ms under %.2f ms budget, raising quality.",
+						 m_settings.percentile * 100.0, m_lastPercentileMillis, kTarget);
+		}
+	}
+	else
+	{
+		m_numGoodWindows = 0; // Inside the dead band
+	}
+}
+
+bool BGE::QualityGovernor::Degrade(void)
+{
+	for (auto &knob : m_knobs)
+	{
+		if (knob.level + 1 < knob.desc.numLevels)
+		{
+			knob.desc.applyLevel(++knob.level);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool BGE::QualityGovernor::Upgrade(void)
+{
+	// Reverse order restores the most important knobs first
+	for (auto iter = m_knobs.rbegin(); iter != m_knobs.rend(); ++iter)
+	{
+		if (iter->level > 0)
+		{
+			iter->desc.applyLevel(--iter->level);
+			return true;
+		}
+	}
+	return false;
+}
+
+BGE::QualityKnob BGE::MakeRenderScaleKnob(IRenderer &renderer, std::vector<float> renderScales, int priority)
+{
+	if (renderScales.empty())
+		renderScales.push_back(renderer.VGetRenderScale());
+
+	QualityKnob knob;
+	knob.name = "RenderScale";
+	knob.numLevels = static_cast<int>(renderScales.size());
+	knob.priority = priority;
+	knob.applyLevel = [&renderer, kScales = std::move(renderScales)](int level)
+	{
+		renderer.VSetRenderScale(kScales[static_cast<std::size_t>(level)]);
+	};
+	return knob;
+}
+
+BGE::QualityKnob BGE::MakeMultisamplingKnob(IRenderer &renderer, int maxSamples, int priority)
+{
+	std::vector<int> sampleLevels;
+	for (int numSamples = maxSamples; numSamples > 1; numSamples /= 2)
+		sampleLevels.push_back(numSamples);
+	sampleLevels.push_back(0);
+
+	QualityKnob knob;
+	knob.name = "Multisampling";
+	knob.numLevels = static_cast<int>(sampleLevels.size());
+	knob.priority = priority;
+	knob.applyLevel = [&renderer, kLevels = std::move(sampleLevels)](int level)
+	{
+		renderer.VSetMultisampling(kLevels[static_cast<std::size_t>(level)]);
+	};
+	return knob;
+}
+
+BGE::QualityKnob BGE::MakeSystemRateKnob(Scheduler &scheduler, SchedulerHandle handle, std::vector<double> ratesHz,
+										 int priority)
+{
+	QualityKnob knob;
+	const auto kStats = scheduler.GetStats(handle);
+	knob.name = (kStats) ? kStats->name + "Rate" : std::string("SystemRate");
+	if (ratesHz.empty() && kStats)
+		ratesHz.push_back(kStats->currentRateHz);
+	knob.numLevels = static_cast<int>(ratesHz.size());
+	knob.priority = priority;
+	// The governor runs on the main thread, so the change waits for the system's own phase
+	const SchedulerPhase kPhase = (kStats) ? kStats->phase : SchedulerPhase::Update;
+	knob.applyLevel = [&scheduler, handle, kPhase, kRates = std::move(ratesHz)](int level)
+	{
+		scheduler.RequestRate(handle, kPhase, kRates[static_cast<std::size_t>(level)]);
+	};
+	return knob;
+}
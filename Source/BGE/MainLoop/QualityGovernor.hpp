@@ -0,0 +1,114 @@
+/*=============================================================================*
+ * QualityGovernor.hpp - Adaptive quality governor.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_QUALITYGOVERNOR_HPP_
+#define _BGE_QUALITYGOVERNOR_HPP_
+
+#include <functional>
+
+namespace BGE
+{
+	class IRenderer;
+	class Scheduler;
+
+	using QualityKnobHandle = std::uint32_t;
+	inline constexpr QualityKnobHandle kINVALID_QUALITY_KNOB_HANDLE = 0;
+	// A setting with discrete quality levels; level 0 is the highest quality.
+	struct QualityKnob
+	{
+		std::string name;
+		int numLevels = 1;
+		int priority = 0; // Lower priority knobs are degraded first and restored last
+		std::function<void(int)> applyLevel; // Called with the new level
+	};
+	/**
+	 * QualityGovernor collects frame times and, once per window of frames,
+	 * compares a percentile against the frame budget. Over budget, one knob is
+	 * degraded by a level. Well under budget for several windows in a row, one
+	 * knob is restored. The gap between the two thresholds, and the extra
+	 * windows needed to upgrade, keep quality from oscillating.
+	 */
+	class QualityGovernor
+	{
+	public:
+		struct Settings
+		{
+			double targetFrameMillis = 1000.0 / 60.0;
+			std::size_t windowSize = 90; // Frames per evaluation
+			double percentile = 0.9; // Of the window compared to the target
+			double degradeRatio = 1.0; // Degrade when the percentile exceeds target * ratio
+			double upgradeRatio = 0.7; // Upgrade candidate below target * ratio
+			int numUpgradeWindows = 3; // Consecutive good windows before upgrading
+		};
+	private:
+		struct Knob
+		{
+			QualityKnobHandle handle;
+			QualityKnob desc;
+			int level;
+		};
+
+		Settings m_settings;
+		std::vector<Knob> m_knobs;
+		std::vector<double> m_samples; // Current window
+		std::vector<double> m_scratch; // For percentile selection
+		double m_lastPercentileMillis;
+		int m_numGoodWindows;
+		QualityKnobHandle m_nextHandle;
+		bool m_isEnabled;
+	public:
+		QualityGovernor(void);
+		explicit QualityGovernor(const Settings &settings);
+
+		void SetSettings(const Settings &settings);
+		const Settings &GetSettings(void) const { return m_settings; }
+		void SetTargetFrameMillis(double targetFrameMillis) { m_settings.targetFrameMillis = targetFrameMillis; }
+		void SetEnabled(bool isEnabled) { m_isEnabled = isEnabled; }
+		bool IsEnabled(void) const { return m_isEnabled; }
+		// The knob is applied at level 0 when added.
+		QualityKnobHandle AddKnob(QualityKnob knob);
+		bool RemoveKnob(QualityKnobHandle handle);
+		std::optional<int> GetKnobLevel(QualityKnobHandle handle) const;
+		// Record the time spent on one frame; evaluates once the window is full.
+		void AddFrameTime(double frameMillis);
+		// Percentile of the last evaluated window.
+		double GetLastPercentileMillis(void) const { return m_lastPercentileMillis; }
+	private:
+		void Evaluate(void);
+		bool Degrade(void);
+		bool Upgrade(void);
+	};
+	// Render scale levels (e.g. 1.0, 0.85, 0.7, 0.5); RENDERER must outlive the governor.
+	QualityKnob MakeRenderScaleKnob(IRenderer &renderer, std::vector<float> renderScales, int priority = 0);
+	// Halves the sample count per level down to 0 (e.g. 4, 2, 0).
+	QualityKnob MakeMultisamplingKnob(IRenderer &renderer, int maxSamples, int priority = 0);
+	// Update rate levels for a scheduler system (e.g. 30, 15, 10 Hz), applied when its phase next runs.
+	QualityKnob MakeSystemRateKnob(Scheduler &scheduler, SchedulerHandle handle, std::vector<double> ratesHz,
+								   int priority = 0);
+} // End namespace (BGE)
+
+#endif /* !_BGE_QUALITYGOVERNOR_HPP_ */
@@ -0,0 +1,134 @@
+/*=============================================================================*
+ * RenderPipeline.cpp - Two stage update/render pipeline.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "RenderPipeline.hpp"
+
+BGE::RenderPipeline::RenderPipeline(void)
+	: m_slots(),
+	  m_slotAlphas(),
+	  m_workerSlot(0),
+	  m_renderSlot(1),
+	  m_events(),
+	  m_frameMillis(0.0),
+	  m_stage(),
+	  m_worker(),
+	  m_mutex(),
+	  m_condition(),
+	  m_hasJob(false),
+	  m_isJobDone(false),
+	  m_isJobInFlight(false),
+	  m_toStop(false)
+{
+}
+
+BGE::RenderPipeline::~RenderPipeline(void)
+{
+	Stop();
+}
+
+bool BGE::RenderPipeline::Start(UniqueIRenderSnapshotPtr pFirst, UniqueIRenderSnapshotPtr pSecond, StageFunc stage)
+{
+	if (IsRunning())
+	{
+		BGE_ERROR("RenderPipeline Failure: Already started!");
+		return false;
+	}
+
+	if (!pFirst || !pSecond || !stage)
+	{
+		BGE_ERROR("RenderPipeline Failure: Two snapshots and a stage function are required!");
+		return false;
+	}
+	m_slots = { std::move(pFirst), std::move(pSecond) };
+	m_slotAlphas = {};
+	m_stage = std::move(stage);
+	m_hasJob = m_isJobDone = m_isJobInFlight = m_toStop = false;
+	m_worker = std::thread(&RenderPipeline::WorkerMain, this);
+	return true;
+}
+
+void BGE::RenderPipeline::Stop(void)
+{
+	if (!IsRunning())
+		return;
+	{
+		std::lock_guard lock(m_mutex);
+		m_toStop = true;
+	}
+	m_condition.notify_all();
+	m_worker.join(); // Worker drains any pending job before exiting
+	m_isJobInFlight = false;
+}
+
+BGE::RenderPipeline::Frame BGE::RenderPipeline::WaitForFrame(void)
+{
+	BGE_ASSERT(m_isJobInFlight && "WaitForFrame called without a job in flight!");
+	std::unique_lock lock(m_mutex);
+	m_condition.wait(lock, [this]() { return m_isJobDone; });
+	m_isJobDone = false;
+	m_isJobInFlight = false;
+	// The finished slot now belongs to the main thread
+	m_renderSlot = m_workerSlot;
+	return { *m_slots[m_renderSlot], m_slotAlphas[m_renderSlot] };
+}
+
+void BGE::RenderPipeline::Kick(std::vector<SDL_Event> &events, double frameMillis)
+{
+	BGE_ASSERT(!m_isJobInFlight && "Kick called while a job is in flight!");
+	{
+		std::lock_guard lock(m_mutex);
+		// The worker writes the slot the main thread isn't reading
+		m_workerSlot = (m_renderSlot + 1) % kNUM_SLOTS;
+		m_events.swap(events); // Reuse both buffers; no per frame allocation
+		m_frameMillis = frameMillis;
+		m_hasJob = true;
+	}
+	events.clear();
+	m_isJobInFlight = true;
+	m_condition.notify_all();
+}
+
+void BGE::RenderPipeline::WorkerMain(void)
+{
+	std::unique_lock lock(m_mutex);
+	while (true)
+	{
+		m_condition.wait(lock, [this]() { return m_hasJob || m_toStop; });
+		if (!m_hasJob) // Only stop once pending work is done
+			break;
+		m_hasJob = false;
+		// Everything the stage touches is owned by the worker until m_isJobDone is set
+		const std::size_t kSlot = m_workerSlot;
+		lock.unlock();
+		const float kInterpAlpha = m_stage(*m_slots[kSlot], m_events, m_frameMillis);
+		lock.lock();
+		m_slotAlphas[kSlot] = kInterpAlpha;
+		m_isJobDone = true;
+		m_condition.notify_all();
+	}
+}
@@ -0,0 +1,94 @@
+/*=============================================================================*
+ * RenderPipeline.hpp - Two stage update/render pipeline.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_RENDERPIPELINE_HPP_
+#define _BGE_RENDERPIPELINE_HPP_
+
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace BGE
+{
+	/**
+	 * RenderPipeline runs the update stage for frame N+1 on a worker thread while
+	 * the main thread renders frame N.
+	 *
+	 * Two snapshot slots are exchanged between the threads. At any time one slot
+	 * is owned by the worker (being written) and the other by the main thread
+	 * (being read). Ownership only changes inside WaitForFrame() and Kick(), under
+	 * the mutex, while the worker is idle.
+	 */
+	class RenderPipeline : public INonCopyable, public INonMoveable
+	{
+	public:
+		// Runs on the worker: consumes the frame's events and time, writes the snapshot,
+		// and returns the interpolation alpha to render it with.
+		using StageFunc = std::function<float(IRenderSnapshot &, std::span<const SDL_Event>, double)>;
+		// A completed frame; valid until the Kick() after the next WaitForFrame().
+		struct Frame
+		{
+			const IRenderSnapshot &snapshot;
+			float interpAlpha;
+		};
+	private:
+		static constexpr std::size_t kNUM_SLOTS = 2;
+
+		std::array<UniqueIRenderSnapshotPtr, kNUM_SLOTS> m_slots;
+		std::array<float, kNUM_SLOTS> m_slotAlphas;
+		std::size_t m_workerSlot; // Written by the worker while a job is in flight
+		std::size_t m_renderSlot; // Read by the main thread
+		std::vector<SDL_Event> m_events; // Input for the in-flight job
+		double m_frameMillis;
+		StageFunc m_stage;
+		std::thread m_worker;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		bool m_hasJob; // Job waiting to be picked up by the worker
+		bool m_isJobDone; // Job finished, slot ready to be rendered
+		bool m_isJobInFlight; // Main thread side: Kick() without matching WaitForFrame()
+		bool m_toStop;
+	public:
+		RenderPipeline(void);
+		~RenderPipeline(void);
+
+		bool Start(UniqueIRenderSnapshotPtr pFirst, UniqueIRenderSnapshotPtr pSecond, StageFunc stage);
+		// Finish the in-flight job and join the worker.
+		void Stop(void);
+		bool IsRunning(void) const { return m_worker.joinable(); }
+		// Main thread: block until the in-flight job completes and take ownership of its slot.
+		Frame WaitForFrame(void);
+		// Main thread: hand the other slot to the worker. EVENTS is swapped out, not copied.
+		void Kick(std::vector<SDL_Event> &events, double frameMillis);
+	private:
+		void WorkerMain(void);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_RENDERPIPELINE_HPP_ */
@@ -0,0 +1,356 @@
+/*=============================================================================*
+ * Replay.cpp - Main loop input capture and playback.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace
+{
+	constexpr char kMAGIC[4] = { 'B', 'G', 'E', 'R' };
+	constexpr std::uint16_t kVERSION = 1;
+	constexpr std::uint32_t kUNKNOWN_NUM_FRAMES = ~0u;
+	constexpr std::size_t kNUM_FRAMES_OFFSET = sizeof(kMAGIC) + sizeof(kVERSION) + 4 + 3 * sizeof(std::uint32_t);
+	constexpr std::size_t kFLUSH_SIZE = 64 * 1024;
+	constexpr std::uint8_t kFLAG_FIXED_TIMESTEP = 0x01;
+	// Bytes of the SDL_Event union used by TYPE, or 0 when it can't be replayed.
+	std::size_t GetEventSize(Uint32 type)
+	{
+		switch (type)
+		{
+		case SDL_QUIT:
+			return sizeof(SDL_QuitEvent);
+		case SDL_WINDOWEVENT:
+			return sizeof(SDL_WindowEvent);
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+			return sizeof(SDL_KeyboardEvent);
+		case SDL_TEXTEDITING:
+			return sizeof(SDL_TextEditingEvent);
+		case SDL_TEXTINPUT:
+			return sizeof(SDL_TextInputEvent);
+		case SDL_MOUSEMOTION:
+			return sizeof(SDL_MouseMotionEvent);
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			return sizeof(SDL_MouseButtonEvent);
+		case SDL_MOUSEWHEEL:
+			return sizeof(SDL_MouseWheelEvent);
+		case SDL_JOYAXISMOTION:
+			return sizeof(SDL_JoyAxisEvent);
+		case SDL_JOYHATMOTION:
+			return sizeof(SDL_JoyHatEvent);
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+			return sizeof(SDL_JoyButtonEvent);
+		case SDL_CONTROLLERAXISMOTION:
+			return sizeof(SDL_ControllerAxisEvent);
+		case SDL_CONTROLLERBUTTONDOWN:
+		case SDL_CONTROLLERBUTTONUP:
+			return sizeof(SDL_ControllerButtonEvent);
+		case SDL_FINGERDOWN:
+		case SDL_FINGERUP:
+		case SDL_FINGERMOTION:
+			return sizeof(SDL_TouchFingerEvent);
+		// These carry pointers that are meaningless in another process
+		case SDL_SYSWMEVENT:
+		case SDL_DROPFILE:
+		case SDL_DROPTEXT:
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+		case SDL_TEXTEDITING_EXT:
+#endif
+			return 0;
+		default:
+			return (type >= SDL_USEREVENT) ? 0 : sizeof(SDL_Event);
+		}
+	}
+
+	template <typename Type>
+	void Append(std::vector<std::uint8_t> &buffer, const Type &value)
+	{
+		const auto *pBytes = reinterpret_cast<const std::uint8_t *>(&value);
+		buffer.insert(buffer.end(), pBytes, pBytes + sizeof(Type));
+	}
+	// Unsigned LEB128; event counts almost always fit in one byte
+	void AppendVarint(std::vector<std::uint8_t> &buffer, std::uint32_t value)
+	{
+		while (value >= 0x80)
+		{
+			buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		buffer.push_back(static_cast<std::uint8_t>(value));
+	}
+} // End namespace
+
+BGE::ReplayRecorder::ReplayRecorder(void)
+	: m_numFrames(0),
+	  m_numSkippedEvents(0)
+{
+}
+
+BGE::ReplayRecorder::~ReplayRecorder(void)
+{
+	if (IsOpen())
+		Close();
+}
+
+bool BGE::ReplayRecorder::Open(std::string_view filename, const ReplayTimingSettings &settings)
+{
+	if (IsOpen())
+		Close();
+
+	m_file.open(std::string(filename), std::ios::binary | std::ios::trunc);
+	if (!m_file)
+	{
+		BGE_ERROR("ReplayRecorder::Open Failure: Couldn't create \"%s\".", std::string(filename).c_str());
+		return false;
+	}
+
+	m_buffer.clear();
+	m_buffer.reserve(kFLUSH_SIZE * 2);
+	m_numFrames = 0;
+	m_numSkippedEvents = 0;
+	// Event structs are stored raw, so the SDL build has to match on playback
+	SDL_version version;
+	SDL_VERSION(&version);
+	m_buffer.insert(m_buffer.end(), std::begin(kMAGIC), std::end(kMAGIC));
+	Append(m_buffer, kVERSION);
+	Append(m_buffer, version.major);
+	Append(m_buffer, version.minor);
+	Append(m_buffer, version.patch);
+	Append(m_buffer, static_cast<std::uint8_t>(settings.fixedTimestepEnabled ? kFLAG_FIXED_TIMESTEP : 0));
+	Append(m_buffer, settings.fixedUpdateRate);
+	Append(m_buffer, settings.maxStepsPerFrame);
+	Append(m_buffer, settings.minFrames);
+	BGE_ASSERT(m_buffer.size() == kNUM_FRAMES_OFFSET);
+	Append(m_buffer, kUNKNOWN_NUM_FRAMES);
+	return true;
+}
+
+void BGE::ReplayRecorder::RecordFrame(double frameMillis, std::span<const SDL_Event> events)
+{
+	BGE_ASSERT(IsOpen());
+	Append(m_buffer, frameMillis);
+	const auto kNumReplayable = std::count_if(events.begin(), events.end(),
+											  [](const SDL_Event &event) { return GetEventSize(event.type) != 0; });
+	AppendVarint(m_buffer, static_cast<std::uint32_t>(kNumReplayable));
+	for (const SDL_Event &kEvent : events)
+	{
+		const std::size_t kSize = GetEventSize(kEvent.type);
+		if (kSize == 0)
+		{
+			++m_numSkippedEvents;
+			continue;
+		}
+		const auto *pBytes = reinterpret_cast<const std::uint8_t *>(&kEvent);
+		m_buffer.insert(m_buffer.end(), pBytes, pBytes + kSize);
+	}
+	++m_numFrames;
+
+	if (m_buffer.size() >= kFLUSH_SIZE)
+		Flush();
+}
+
+bool BGE::ReplayRecorder::Close(void)
+{
+	if (!IsOpen())
+		return false;
+
+	Flush();
+	// Patch the frame count now that it is known
+	m_file.seekp(kNUM_FRAMES_OFFSET);
+	m_file.write(reinterpret_cast<const char *>(&m_numFrames), sizeof(m_numFrames));
+	const bool kIsGood = m_file.good();
+	m_file.close();
+	BGE_ERROR_IF(!kIsGood, "ReplayRecorder::Close Failure: Couldn't finish writing the replay.");
+	BGE_INFO("Replay recorded: %u frames.", m_numFrames);
+	BGE_WARNING_IF(m_numSkippedEvents > 0, "Replay left out %zu events that can't be replayed.",
+				   m_numSkippedEvents);
+	return kIsGood;
+}
+
+void BGE::ReplayRecorder::Flush(void)
+{
+	m_file.write(reinterpret_cast<const char *>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	m_buffer.clear();
+}
+
+BGE::ReplayPlayer::ReplayPlayer(void)
+	: m_offset(0),
+	  m_numFrames(0),
+	  m_frameIndex(0)
+{
+}
+
+bool BGE::ReplayPlayer::Open(std::string_view filename)
+{
+	Close();
+	m_measuredMillis.clear();
+	std::ifstream file(std::string(filename), std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		BGE_ERROR("ReplayPlayer::Open Failure: Couldn't open \"%s\".", std::string(filename).c_str());
+		return false;
+	}
+	// Recordings are small enough to load whole
+	m_data.resize(static_cast<std::size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(reinterpret_cast<char *>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+
+	char magic[sizeof(kMAGIC)];
+	std::uint16_t version = 0;
+	SDL_version sdlVersion;
+	std::uint8_t flags = 0;
+	if (!file || !Read(magic, sizeof(magic)) || std::memcmp(magic, kMAGIC, sizeof(kMAGIC)) != 0 ||
+		!Read(&version, sizeof(version)) || version != kVERSION)
+	{
+		BGE_ERROR("ReplayPlayer::Open Failure: \"%s\" isn't a replay of version %u.",
+				  std::string(filename).c_str(), kVERSION);
+		Close();
+		return false;
+	}
+	if (!Read(&sdlVersion.major, 1) || !Read(&sdlVersion.minor, 1) || !Read(&sdlVersion.patch, 1) ||
+		!Read(&flags, sizeof(flags)) || !Read(&m_settings.fixedUpdateRate, sizeof(m_settings.fixedUpdateRate)) ||
+		!Read(&m_settings.maxStepsPerFrame, sizeof(m_settings.maxStepsPerFrame)) ||
+		!Read(&m_settings.minFrames, sizeof(m_settings.minFrames)) || !Read(&m_numFrames, sizeof(m_numFrames)))
+	{
+		BGE_ERROR("ReplayPlayer::Open Failure: Truncated header.");
+		Close();
+		return false;
+	}
+	m_settings.fixedTimestepEnabled = (flags & kFLAG_FIXED_TIMESTEP) != 0;
+
+	SDL_version compiledVersion;
+	SDL_VERSION(&compiledVersion);
+	BGE_WARNING_IF(std::memcmp(&sdlVersion, &compiledVersion, sizeof(SDL_version)) != 0,
+				   "Replay was recorded with SDL %u.%u.%u; events may not decode correctly.",
+				   sdlVersion.major, sdlVersion.minor, sdlVersion.patch);
+	BGE_WARNING_IF(m_numFrames == kUNKNOWN_NUM_FRAMES, "Replay wasn't closed; playing until the data ends.");
+	return true;
+}
+
+void BGE::ReplayPlayer::Close(void)
+{
+	m_data.clear();
+	m_data.shrink_to_fit();
+	m_offset = 0;
+	m_settings = {};
+	m_numFrames = 0;
+	m_frameIndex = 0;
+	m_events.clear();
+}
+
+bool BGE::ReplayPlayer::NextFrame(double &outFrameMillis, std::span<const SDL_Event> &outEvents)
+{
+	if (!IsOpen() || m_frameIndex == m_numFrames || m_offset == m_data.size())
+		return false;
+
+	if (!Read(&outFrameMillis, sizeof(outFrameMillis)))
+		return false;
+
+	std::uint32_t numEvents = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		std::uint8_t byte = 0;
+		if (shift > 28 || !Read(&byte, 1))
+			return false;
+		numEvents |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+			break;
+	}
+
+	m_events.clear();
+	for (std::uint32_t index = 0; index < numEvents; ++index)
+	{
+		SDL_Event event;
+		std::memset(&event, 0, sizeof(event));
+		// The type leads every event struct and tells how much follows
+		if (!Read(&event.type, sizeof(event.type)))
+			return false;
+		const std::size_t kSize = GetEventSize(event.type);
+		if (kSize < sizeof(event.type) ||
+			!Read(reinterpret_cast<std::uint8_t *>(&event) + sizeof(event.type), kSize - sizeof(event.type)))
+		{
+			BGE_ERROR("ReplayPlayer::NextFrame Failure: Corrupt event in frame %u.", m_frameIndex);
+			return false;
+		}
+		m_events.push_back(event);
+	}
+	outEvents = m_events;
+	++m_frameIndex;
+	return true;
+}
+
+void BGE::ReplayPlayer::AddMeasuredFrameTime(double frameMillis)
+{
+	m_measuredMillis.push_back(frameMillis);
+}
+
+bool BGE::ReplayPlayer::WriteMeasuredFrameTimes(std::string_view filename) const
+{
+	std::ofstream file{ std::string(filename) };
+	if (!file)
+	{
+		BGE_ERROR("ReplayPlayer::WriteMeasuredFrameTimes Failure: Couldn't create \"%s\".",
+				  std::string(filename).c_str());
+		return false;
+	}
+	file << "frame,millis\n";
+	for (std::size_t index = 0; index < m_measuredMillis.size(); ++index)
+		file << index << ',' << m_measuredMillis[index] << '\n';
+	return file.good();
+}
+
+void BGE::ReplayPlayer::LogMeasuredFrameTimes(void) const
+{
+	if (m_measuredMillis.empty())
+		return;
+
+	std::vector<double> sorted = m_measuredMillis;
+	std::sort(sorted.begin(), sorted.end());
+	const auto kPercentile = [&sorted](double fraction)
+	{
+		return sorted[static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1))];
+	};
+	const double kMean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+	BGE_INFO("Replay frame times over %zu frames: mean %.3fms, p50 %.3fms, p95 %.3fms, p99 %.3fms, max %.3fms",
+			 sorted.size(), kMean, kPercentile(0.5), kPercentile(0.95), kPercentile(0.99), sorted.back());
+}
+
+bool BGE::ReplayPlayer::Read(void *pDest, std::size_t numBytes)
+{
+	if (m_data.size() - m_offset < numBytes)
+		return false;
+
+	std::memcpy(pDest, m_data.data() + m_offset, numBytes);
+	m_offset += numBytes;
+	return true;
+}
@@ -0,0 +1,107 @@
+/*=============================================================================*
+ * Replay.hpp - Main loop input capture and playback.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_REPLAY_HPP_
+#define _BGE_REPLAY_HPP_
+
+#include <fstream>
+
+namespace BGE
+{
+	// Main loop settings that change how frame times turn into simulation steps.
+	// Stored in the replay header and restored on playback.
+	struct ReplayTimingSettings
+	{
+		bool fixedTimestepEnabled = false;
+		std::int32_t fixedUpdateRate = 60;
+		std::int32_t maxStepsPerFrame = 5;
+		std::uint32_t minFrames = 6;
+	};
+	/**
+	 * ReplayRecorder streams each frame's delta time and input events to a binary file.
+	 *
+	 * Layout (native byte order, meant for runs on the same platform and SDL build):
+	 *   Header: "BGER", u16 version, SDL version (3 x u8), u8 flags, timing settings,
+	 *           u32 frame count (patched by Close(), ~0u when the file wasn't closed)
+	 *   Frame:  f64 delta milliseconds, varint event count, then each event as its
+	 *           SDL event struct only (not the whole SDL_Event union)
+	 * Events holding pointers (drops, user and system window manager events) can't be
+	 * replayed and are left out.
+	 */
+	class ReplayRecorder : public INonCopyable
+	{
+		std::ofstream m_file;
+		std::vector<std::uint8_t> m_buffer; // Written to the file in large blocks
+		std::uint32_t m_numFrames;
+		std::size_t m_numSkippedEvents;
+	public:
+		ReplayRecorder(void);
+		~ReplayRecorder(void);
+
+		bool Open(std::string_view filename, const ReplayTimingSettings &settings);
+		void RecordFrame(double frameMillis, std::span<const SDL_Event> events);
+		bool Close(void);
+		bool IsOpen(void) const { return m_file.is_open(); }
+		std::uint32_t GetNumFrames(void) const { return m_numFrames; }
+	private:
+		void Flush(void);
+	};
+	/**
+	 * ReplayPlayer reads a file written by ReplayRecorder and hands back one frame at a
+	 * time. It also collects the frame times measured while replaying, so two builds can
+	 * be compared on identical input.
+	 */
+	class ReplayPlayer : public INonCopyable
+	{
+		std::vector<std::uint8_t> m_data;
+		std::size_t m_offset; // Read position in m_data
+		ReplayTimingSettings m_settings;
+		std::uint32_t m_numFrames; // ~0u when unknown
+		std::uint32_t m_frameIndex;
+		std::vector<SDL_Event> m_events; // Current frame's events
+		std::vector<double> m_measuredMillis; // One sample per replayed frame
+	public:
+		ReplayPlayer(void);
+
+		bool Open(std::string_view filename);
+		void Close(void);
+		bool IsOpen(void) const { return !m_data.empty(); }
+		// Advance to the next frame; returns false once the recording is exhausted.
+		bool NextFrame(double &outFrameMillis, std::span<const SDL_Event> &outEvents);
+		const ReplayTimingSettings &GetTimingSettings(void) const { return m_settings; }
+		std::uint32_t GetFrameIndex(void) const { return m_frameIndex; }
+
+		void AddMeasuredFrameTime(double frameMillis);
+		// One line per frame: index, milliseconds.
+		bool WriteMeasuredFrameTimes(std::string_view filename) const;
+		void LogMeasuredFrameTimes(void) const;
+	private:
+		bool Read(void *pDest, std::size_t numBytes);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_REPLAY_HPP_ */
@@ -0,0 +1,321 @@
+/*=============================================================================*
+ * Scheduler.cpp - Phase and priority ordered system scheduler.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "Scheduler.hpp"
+
+#include <utility>
+
+namespace ch = std::chrono;
+
+BGE::Scheduler::Scheduler(void)
+	: m_phases(),
+	  m_nextHandle(kINVALID_SCHEDULER_HANDLE + 1),
+	  m_isBudgetAdaptationEnabled(true)
+{
+}
+
+BGE::SchedulerHandle BGE::Scheduler::Register(SchedulerSystemDesc desc)
+{
+	const auto kPhaseIndex = static_cast<std::size_t>(desc.phase);
+	if (kPhaseIndex >= kNUM_PHASES || !desc.tickFunc)
+	{
+		BGE_ERROR("Scheduler::Register Failure: System (%s) needs a valid phase and tick function!", desc.name.c_str());
+		return kINVALID_SCHEDULER_HANDLE;
+	}
+
+	System system{};
+	system.handle = m_nextHandle++;
+	system.isEnabled = true;
+	system.isRemoved = false;
+	system.currentRateHz = std::max(desc.rateHz, 0.0);
+	system.desc = std::move(desc);
+
+	auto &phaseData = m_phases[kPhaseIndex];
+	const SchedulerHandle kHandle = system.handle;
+	// Don't disturb the list being iterated
+	if (phaseData.isRunning)
+		phaseData.pending.push_back(std::move(system));
+	else
+		InsertSorted(phaseData.systems, std::move(system));
+	return kHandle;
+}
+
+bool BGE::Scheduler::Unregister(SchedulerHandle handle)
+{
+	for (auto &phaseData : m_phases)
+	{
+		for (auto *pSystems : { &phaseData.systems, &phaseData.pending })
+		{
+			auto iter = std::find_if(pSystems->begin(), pSystems->end(),
+									 [handle](const System &system) { return system.handle == handle; });
+			if (iter == pSystems->end() || iter->isRemoved)
+				continue;
+
+			if (phaseData.isRunning && pSystems == &phaseData.systems)
+			{
+				// Erase once the phase finishes
+				iter->isRemoved = true;
+				phaseData.hasRemovals = true;
+			}
+			else
+			{
+				pSystems->erase(iter);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+bool BGE::Scheduler::SetEnabled(SchedulerHandle handle, bool isEnabled)
+{
+	auto *pSystem = FindSystem(handle);
+	if (!pSystem)
+		return false;
+	pSystem->isEnabled = isEnabled;
+	return true;
+}
+
+bool BGE::Scheduler::SetRate(SchedulerHandle handle, double rateHz)
+{
+	auto *pSystem = FindSystem(handle);
+	if (!pSystem)
+		return false;
+	pSystem->desc.rateHz = std::max(rateHz, 0.0);
+	pSystem->currentRateHz = pSystem->desc.rateHz;
+	pSystem->accumulatorMillis = 0.0;
+	return true;
+}
+
+void BGE::Scheduler::RequestRate(SchedulerHandle handle, SchedulerPhase phase, double rateHz)
+{
+	const auto kPhaseIndex = static_cast<std::size_t>(phase);
+	BGE_ASSERT(kPhaseIndex < kNUM_PHASES);
+	std::scoped_lock lock(m_rateRequestMutex);
+	m_phases[kPhaseIndex].rateRequests.push_back({ handle, rateHz });
+}
+
+bool BGE::Scheduler::IsRegistered(SchedulerHandle handle) const
+{
+	return FindSystem(handle) != nullptr;
+}
+
+void BGE::Scheduler::RunPhase(SchedulerPhase phase, const TickContext &context)
+{
+	const auto kPhaseIndex = static_cast<std::size_t>(phase);
+	BGE_ASSERT(kPhaseIndex < kNUM_PHASES);
+	auto &phaseData = m_phases[kPhaseIndex];
+	BGE_ASSERT(!phaseData.isRunning && "Scheduler phase is not reentrant!");
+
+	ApplyRateRequests(phaseData);
+	phaseData.isRunning = true;
+	for (auto &system : phaseData.systems)
+	{
+		if (!system.isEnabled || system.isRemoved)
+			continue;
+
+		if (system.currentRateHz <= 0.0)
+		{
+			TickSystem(system, context);
+			continue;
+		}
+		// Rate limited: run in fixed periods of accumulated phase time
+		const double kPeriodMillis = 1000.0 / system.currentRateHz;
+		system.accumulatorMillis += context.deltaMillis;
+		TickContext systemContext = context;
+		systemContext.deltaMillis = static_cast<float>(kPeriodMillis);
+		// Tolerance so rates that divide the phase delta evenly don't lose a tick to rounding
+		constexpr double kEPSILON_MILLIS = 1e-3;
+		int numSteps = 0;
+		while (system.accumulatorMillis + kEPSILON_MILLIS >= kPeriodMillis && numSteps < system.desc.maxStepsPerRun)
+		{
+			TickSystem(system, systemContext);
+			system.accumulatorMillis -= kPeriodMillis;
+			++numSteps;
+		}
+		// Drop time the system can't catch up on
+		if (system.accumulatorMillis >= kPeriodMillis)
+			system.accumulatorMillis = std::fmod(system.accumulatorMillis, kPeriodMillis);
+		if (numSteps > 0)
+			AdjustRate(system);
+	}
+	FinishPhase(phaseData);
+}
+
+std::optional<BGE::Scheduler::SystemStats> BGE::Scheduler::GetStats(SchedulerHandle handle) const
+{
+	const auto *pSystem = FindSystem(handle);
+	if (!pSystem)
+		return std::nullopt;
+	return MakeStats(*pSystem);
+}
+
+std::vector<BGE::Scheduler::SystemStats> BGE::Scheduler::GetAllStats(void) const
+{
+	std::vector<SystemStats> allStats;
+	for (const auto &kPhaseData : m_phases)
+	{
+		for (const auto &kSystem : kPhaseData.systems)
+		{
+			if (!kSystem.isRemoved)
+				allStats.push_back(MakeStats(kSystem));
+		}
+	}
+	return allStats;
+}
+
+void BGE::Scheduler::LogStats(void) const
+{
+	for (const auto &kStats : GetAllStats())
+	{
+		BGE_INFO("System %s (%s): %.1f Hz, %llu ticks, avg %.3f ms, last %.3f ms, max %.3f ms",
+				 kStats.name.c_str(), GetSchedulerPhaseName(kStats.phase), kStats.currentRateHz,
+				 static_cast<unsigned long long>(kStats.numTicks), kStats.avgMillis, kStats.lastMillis,
+				 kStats.maxMillis);
+	}
+}
+
+BGE::Scheduler::System *BGE::Scheduler::FindSystem(SchedulerHandle handle)
+{
+	return const_cast<System *>(std::as_const(*this).FindSystem(handle));
+}
+
+const BGE::Scheduler::System *BGE::Scheduler::FindSystem(SchedulerHandle handle) const
+{
+	for (const auto &kPhaseData : m_phases)
+	{
+		for (const auto *pSystems : { &kPhaseData.systems, &kPhaseData.pending })
+		{
+			for (const auto &kSystem : *pSystems)
+			{
+				if (kSystem.handle == handle && !kSystem.isRemoved)
+					return &kSystem;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void BGE::Scheduler::TickSystem(System &system, const TickContext &context)
+{
+	const auto kStart = ch::steady_clock::now();
+	system.desc.tickFunc(context);
+	const double kMillis = ch::duration<double, std::milli>(ch::steady_clock::now() - kStart).count();
+
+	constexpr double kSMOOTHING = 0.1; // Weight of the newest sample
+	system.avgMillis = (system.numTicks == 0) ? kMillis : system.avgMillis + kSMOOTHING * (kMillis - system.avgMillis);
+	system.lastMillis = kMillis;
+	system.maxMillis = std::max(system.maxMillis, kMillis);
+	++system.numTicks;
+}
+
+void BGE::Scheduler::AdjustRate(System &system)
+{
+	const auto &kDesc = system.desc;
+	if (kDesc.budgetMillis <= 0.0 || !m_isBudgetAdaptationEnabled)
+		return;
+	// The gap between the two thresholds keeps the rate from oscillating
+	const double kMinRateHz = std::clamp(kDesc.minRateHz, 0.0, kDesc.rateHz);
+	if (system.avgMillis > kDesc.budgetMillis && system.currentRateHz > kMinRateHz && kMinRateHz > 0.0)
+		system.currentRateHz = std::max(kMinRateHz, system.currentRateHz * 0.5);
+	else if (system.avgMillis < kDesc.budgetMillis * 0.5 && system.currentRateHz < kDesc.rateHz)
+		system.currentRateHz = std::min(kDesc.rateHz, system.currentRateHz * 2.0);
+}
+
+void BGE::Scheduler::ApplyRateRequests(PhaseData &phaseData)
+{
+	{
+		std::scoped_lock lock(m_rateRequestMutex);
+		if (phaseData.rateRequests.empty())
+			return;
+		phaseData.appliedRequests.swap(phaseData.rateRequests);
+	}
+	// Only this phase's systems are touched, so other phases may run concurrently
+	for (const auto &kRequest : phaseData.appliedRequests)
+	{
+		for (auto *pSystems : { &phaseData.systems, &phaseData.pending })
+		{
+			for (auto &system : *pSystems)
+			{
+				if (system.handle != kRequest.handle || system.isRemoved)
+					continue;
+				system.desc.rateHz = std::max(kRequest.rateHz, 0.0);
+				system.currentRateHz = system.desc.rateHz;
+				system.accumulatorMillis = 0.0;
+			}
+		}
+	}
+	phaseData.appliedRequests.clear();
+}
+
+void BGE::Scheduler::FinishPhase(PhaseData &phaseData)
+{
+	phaseData.isRunning = false;
+	if (phaseData.hasRemovals)
+	{
+		std::erase_if(phaseData.systems, [](const System &system) { return system.isRemoved; });
+		phaseData.hasRemovals = false;
+	}
+
+	for (auto &system : phaseData.pending)
+		InsertSorted(phaseData.systems, std::move(system));
+	phaseData.pending.clear();
+}
+
+void BGE::Scheduler::InsertSorted(std::vector<System> &systems, System &&system)
+{
+	// After every system of higher or equal priority, so registration order breaks ties
+	auto iter = std::upper_bound(systems.begin(), systems.end(), system.desc.priority,
+								 [](int priority, const System &other) { return priority > other.desc.priority; });
+	systems.insert(iter, std::move(system));
+}
+
+BGE::Scheduler::SystemStats BGE::Scheduler::MakeStats(const System &system)
+{
+	return { system.desc.name, system.desc.phase, system.currentRateHz, system.numTicks,
+			 system.lastMillis, system.avgMillis, system.maxMillis };
+}
+
+const char *BGE::GetSchedulerPhaseName(SchedulerPhase phase)
+{
+	switch (phase)
+	{
+	case SchedulerPhase::Input:
+		return "Input";
+	case SchedulerPhase::PreUpdate:
+		return "PreUpdate";
+	case SchedulerPhase::Update:
+		return "Update";
+	case SchedulerPhase::PostUpdate:
+		return "PostUpdate";
+	case SchedulerPhase::Render:
+		return "Render";
+	default:
+		return "Unknown";
+	}
+}
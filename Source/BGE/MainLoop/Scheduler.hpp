@@ -0,0 +1,160 @@
+/*=============================================================================*
+ * Scheduler.hpp - Phase and priority ordered system scheduler.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_SCHEDULER_HPP_
+#define _BGE_SCHEDULER_HPP_
+
+#include <array>
+#include <functional>
+#include <mutex>
+
+namespace BGE
+{
+	// Phases run in this order every frame (Render is skipped when headless).
+	enum class SchedulerPhase : int
+	{
+		Input, // Consume the frame's events
+		PreUpdate,
+		Update, // Runs once per simulation step
+		PostUpdate,
+		Render,
+		Count
+	};
+	// Passed to every tick function.
+	struct TickContext
+	{
+		float deltaMillis = 0.0f; // Time since the system last ran (its period when rate limited)
+		float elapsedMillis = 0.0f; // Main loop or simulated time
+		float interpAlpha = 1.0f; // Render phase only
+		std::span<const SDL_Event> events; // Input and update phases; every step of a frame sees the same events
+		std::uint64_t frameIndex = 0;
+	};
+	using SchedulerTickFunc = std::function<void(const TickContext &)>;
+	using SchedulerHandle = std::uint32_t;
+	inline constexpr SchedulerHandle kINVALID_SCHEDULER_HANDLE = 0;
+	// Registration info for a subsystem.
+	struct SchedulerSystemDesc
+	{
+		std::string name;
+		SchedulerPhase phase = SchedulerPhase::Update;
+		int priority = 0; // Higher runs first within a phase
+		double rateHz = 0.0; // 0 runs every time the phase runs
+		// When the average tick exceeds budgetMillis the rate is halved, down to minRateHz,
+		// and doubled back once it falls under half the budget. 0 disables.
+		double budgetMillis = 0.0;
+		double minRateHz = 0.0;
+		int maxStepsPerRun = 4; // Catch up limit for rate limited systems
+		SchedulerTickFunc tickFunc;
+	};
+	/**
+	 * Scheduler runs registered subsystems per phase in priority order, each at
+	 * its own rate, and tracks the time spent in every system.
+	 *
+	 * Each phase must only be run from one thread at a time. Registering or
+	 * unregistering from inside a tick is deferred until that phase finishes;
+	 * otherwise do it from the thread that runs the phase, or while it is idle.
+	 * RequestRate is the exception: it may be called from any thread.
+	 */
+	class Scheduler
+	{
+	public:
+		struct SystemStats
+		{
+			std::string name;
+			SchedulerPhase phase;
+			double currentRateHz; // May be lowered by the budget
+			std::uint64_t numTicks;
+			double lastMillis;
+			double avgMillis; // Exponential moving average
+			double maxMillis;
+		};
+	private:
+		struct System
+		{
+			SchedulerHandle handle;
+			SchedulerSystemDesc desc;
+			bool isEnabled;
+			bool isRemoved; // Pending removal (deferred while the phase runs)
+			double currentRateHz;
+			double accumulatorMillis;
+			std::uint64_t numTicks;
+			double lastMillis;
+			double avgMillis;
+			double maxMillis;
+		};
+		struct RateRequest
+		{
+			SchedulerHandle handle;
+			double rateHz;
+		};
+		struct PhaseData
+		{
+			std::vector<System> systems; // Sorted by priority
+			std::vector<System> pending; // Registered while running
+			std::vector<RateRequest> rateRequests; // Guarded by m_rateRequestMutex
+			std::vector<RateRequest> appliedRequests; // Swapped with rateRequests when applied
+			bool isRunning = false;
+			bool hasRemovals = false;
+		};
+		static constexpr std::size_t kNUM_PHASES = static_cast<std::size_t>(SchedulerPhase::Count);
+
+		std::array<PhaseData, kNUM_PHASES> m_phases;
+		SchedulerHandle m_nextHandle;
+		bool m_isBudgetAdaptationEnabled;
+		std::mutex m_rateRequestMutex;
+	public:
+		Scheduler(void);
+
+		SchedulerHandle Register(SchedulerSystemDesc desc);
+		bool Unregister(SchedulerHandle handle);
+		bool SetEnabled(SchedulerHandle handle, bool isEnabled);
+		bool SetRate(SchedulerHandle handle, double rateHz);
+		// Thread safe SetRate for a system of PHASE, applied when that phase next runs.
+		void RequestRate(SchedulerHandle handle, SchedulerPhase phase, double rateHz);
+		bool IsRegistered(SchedulerHandle handle) const;
+		// Budgets react to measured time, so deterministic runs (e.g. replays) turn them off.
+		void SetBudgetAdaptationEnabled(bool isEnabled) { m_isBudgetAdaptationEnabled = isEnabled; }
+		// Run every due system of PHASE. Systems see CONTEXT with their own delta.
+		void RunPhase(SchedulerPhase phase, const TickContext &context);
+		std::optional<SystemStats> GetStats(SchedulerHandle handle) const;
+		std::vector<SystemStats> GetAllStats(void) const;
+		void LogStats(void) const;
+	private:
+		System *FindSystem(SchedulerHandle handle);
+		const System *FindSystem(SchedulerHandle handle) const;
+		void TickSystem(System &system, const TickContext &context);
+		void AdjustRate(System &system);
+		void ApplyRateRequests(PhaseData &phaseData);
+		void FinishPhase(PhaseData &phaseData);
+		static void InsertSorted(std::vector<System> &systems, System &&system);
+		static SystemStats MakeStats(const System &system);
+	};
+
+	const char *GetSchedulerPhaseName(SchedulerPhase phase);
+} // End namespace (BGE)
+
+#endif /* !_BGE_SCHEDULER_HPP_ */
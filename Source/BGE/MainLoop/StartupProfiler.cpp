@@ -0,0 +1,131 @@
+/*=============================================================================*
+ * StartupProfiler.cpp - Startup phase timing.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "StartupProfiler.hpp"
+
+#include <algorithm>
+
+// Constructed during static initialization so the clock starts before main()
+static BGE::StartupProfiler s_startupProfiler;
+
+BGE::StartupProfiler::ScopedPhase::ScopedPhase(std::string_view name)
+	: m_index(s_startupProfiler.BeginPhase(name))
+{
+}
+
+BGE::StartupProfiler::ScopedPhase::~ScopedPhase(void)
+{
+	s_startupProfiler.EndPhase(m_index);
+}
+
+BGE::StartupProfiler::StartupProfiler(void)
+	: m_start(Clock::now()),
+	  m_mainThreadID(std::this_thread::get_id()),
+	  m_firstFrameMillis(-1.0)
+{
+}
+
+BGE::StartupProfiler &BGE::StartupProfiler::Get(void)
+{
+	return s_startupProfiler;
+}
+
+std::size_t BGE::StartupProfiler::BeginPhase(std::string_view name)
+{
+	const double kStartMillis = GetMillisSinceStart();
+	const bool kIsMainThread = (std::this_thread::get_id() == m_mainThreadID);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_phases.push_back({ std::string(name), kStartMillis, -1.0, kIsMainThread });
+	return m_phases.size() - 1;
+}
+
+void BGE::StartupProfiler::EndPhase(std::size_t index)
+{
+	const double kEndMillis = GetMillisSinceStart();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	BGE_ASSERT(index < m_phases.size());
+	m_phases[index].durationMillis = kEndMillis - m_phases[index].startMillis;
+}
+
+bool BGE::StartupProfiler::MarkFirstFrame(void)
+{
+	const double kNowMillis = GetMillisSinceStart();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_firstFrameMillis >= 0.0)
+		return false;
+
+	m_firstFrameMillis = kNowMillis;
+	return true;
+}
+
+bool BGE::StartupProfiler::HasFirstFrame(void) const
+{
+	return GetFirstFrameMillis() >= 0.0;
+}
+
+double BGE::StartupProfiler::GetFirstFrameMillis(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_firstFrameMillis;
+}
+
+double BGE::StartupProfiler::GetMillisSinceStart(void) const
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+}
+
+std::vector<BGE::StartupProfiler::Phase> BGE::StartupProfiler::GetPhases(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_phases;
+}
+
+void BGE::StartupProfiler::LogReport(void) const
+{
+	std::vector<Phase> phases = GetPhases();
+	std::stable_sort(phases.begin(), phases.end(),
+					 [](const Phase &lhs, const Phase &rhs) { return lhs.startMillis < rhs.startMillis; });
+
+	double mainThreadMillis = 0.0, workerMillis = 0.0;
+	BGE_INFO("Startup phases (start / duration):");
+	for (const Phase &kPhase : phases)
+	{
+		if (kPhase.durationMillis < 0.0)
+		{
+			BGE_INFO("  %8.2fms  (unfinished)  %s", kPhase.startMillis, kPhase.name.c_str());
+			continue;
+		}
+		BGE_INFO("  %8.2fms  %8.2fms  %s%s", kPhase.startMillis, kPhase.durationMillis,
+				 kPhase.name.c_str(), kPhase.isMainThread ? "" : " [worker]");
+		(kPhase.isMainThread ? mainThreadMillis : workerMillis) += kPhase.durationMillis;
+	}
+	BGE_INFO("Startup: %.2fms on the main thread, %.2fms on workers.", mainThreadMillis, workerMillis);
+	const double kFirstFrameMillis = GetFirstFrameMillis();
+	if (kFirstFrameMillis >= 0.0)
+		BGE_INFO("Startup: cold start to first frame %.2fms.", kFirstFrameMillis);
+}
@@ -0,0 +1,86 @@
+/*=============================================================================*
+ * StartupProfiler.hpp - Startup phase timing.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_STARTUPPROFILER_HPP_
+#define _BGE_STARTUPPROFILER_HPP_
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace BGE
+{
+	/**
+	 * StartupProfiler records named phases from process start to the first presented
+	 * frame. Phases may be recorded from any thread; the report marks which ones ran
+	 * on the main thread, since those make up the critical path.
+	 * Phases on the same thread should not nest, as the report sums them.
+	 */
+	class StartupProfiler : public INonCopyable, public INonMoveable
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Phase
+		{
+			std::string name;
+			double startMillis; // Relative to process start
+			double durationMillis; // Negative while the phase is open
+			bool isMainThread;
+		};
+		// Times the enclosing scope as one phase.
+		class ScopedPhase : public INonCopyable, public INonMoveable
+		{
+			std::size_t m_index;
+		public:
+			explicit ScopedPhase(std::string_view name);
+			~ScopedPhase(void);
+		};
+	private:
+		Clock::time_point m_start;
+		std::thread::id m_mainThreadID;
+		mutable std::mutex m_mutex;
+		std::vector<Phase> m_phases;
+		double m_firstFrameMillis; // Negative until MarkFirstFrame()
+	public:
+		StartupProfiler(void);
+
+		static StartupProfiler &Get(void);
+
+		std::size_t BeginPhase(std::string_view name);
+		void EndPhase(std::size_t index);
+		// Returns true only for the first call.
+		bool MarkFirstFrame(void);
+		bool HasFirstFrame(void) const;
+		double GetFirstFrameMillis(void) const;
+		double GetMillisSinceStart(void) const;
+		std::vector<Phase> GetPhases(void) const;
+		void LogReport(void) const;
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_STARTUPPROFILER_HPP_ */
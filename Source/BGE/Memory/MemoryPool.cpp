@@ -45,20 +45,54 @@ BGE::MemoryPool::~MemoryPool(void)
 
 bool BGE::MemoryPool::Init(std::size_t chunkSize, std::size_t numChunks)
 {
-	return false;
+	// release any existing memory before re-initializing
+	if (m_ppRawMemoryArray)
+		Destroy();
+
+	m_chunkSize = chunkSize;
+	m_numChunks = numChunks;
+	// attempt to allocate the first memory block
+	return GrowMemoryArray();
 }
 
 void BGE::MemoryPool::Destroy(void)
 {
+	// free each memory block, then the array holding them
+	for (std::size_t index = 0; index < m_memArraySize; ++index)
+	{
+		std::free(m_ppRawMemoryArray[index]);
+	}
+	std::free(m_ppRawMemoryArray);
+
+	Reset();
 }
 
 void *BGE::MemoryPool::Alloc(void)
 {
-	return nullptr;
+	// grow the pool when there are no chunks left (if allowed)
+	if (!m_pHead)
+	{
+		if (!m_toAllowResize)
+			return nullptr;
+
+		if (!GrowMemoryArray())
+			return nullptr; // couldn't allocate more memory
+	}
+	// pop the front chunk off of the linked list
+	unsigned char *pRet = m_pHead;
+	m_pHead = GetNext(m_pHead);
+	return (pRet + kCHUNK_HEADER_SIZE); // skip the chunk header
 }
 
 void BGE::MemoryPool::Free(void *pMem)
 {
+	if (!pMem) // Calling Free with nullptr is valid
+		return;
+	// the chunk header precedes the memory handed out by Alloc
+	unsigned char *pBlock = static_cast<unsigned char *>(pMem) - kCHUNK_HEADER_SIZE;
+	// push the chunk onto the front of the list
+	SetNext(pBlock, m_pHead);
+	m_pHead = pBlock;
 }
 
 std::size_t BGE::MemoryPool::GetChunkSize(void) const noexcept
@@ -78,6 +112,11 @@ void BGE::MemoryPool::SetAllowResize(bool toAllowResize) noexcept
 
 void BGE::MemoryPool::Reset(void)
 {
+	m_ppRawMemoryArray = nullptr;
+	m_pHead = nullptr;
+	m_chunkSize = 0;
+	m_numChunks = 0;
+	m_memArraySize = 0;
 }
 
 bool BGE::MemoryPool::GrowMemoryArray(void)
@@ -100,6 +139,11 @@ bool BGE::MemoryPool::GrowMemoryArray(void)
 	 * been incremented yet to reflect the new size.
 	 */
 	ppNewMemArray[m_memArraySize] = AllocateNewMemoryBlock();
+	if (!ppNewMemArray[m_memArraySize])
+	{
+		std::free(ppNewMemArray);
+		return false; // failure
+	}
 
 	// attach the block to the end of the current memory list
 	if (m_pHead) // if not NULL
@@ -131,14 +175,33 @@ bool BGE::MemoryPool::GrowMemoryArray(void)
 
 unsigned char *BGE::MemoryPool::AllocateNewMemoryBlock(void)
 {
-	return nullptr;
+	// each chunk is prefixed by a header holding the next pointer
+	const std::size_t kBlockSize = m_chunkSize + kCHUNK_HEADER_SIZE;
+	const std::size_t kTrueSize = kBlockSize * m_numChunks;
+
+	unsigned char *pNewMem = static_cast<unsigned char *>(std::malloc(kTrueSize));
+	if (!pNewMem)
+		return nullptr;
+	// turn the memory block into a linked list of chunks
+	unsigned char *pEnd = pNewMem + kTrueSize;
+	unsigned char *pCurr = pNewMem;
+	while (pCurr < pEnd)
+	{
+		unsigned char *pNext = pCurr + kBlockSize;
+		SetNext(pCurr, (pNext < pEnd) ? pNext : nullptr);
+		pCurr = pNext;
+	}
+	return pNewMem;
 }
 
 unsigned char *BGE::MemoryPool::GetNext(unsigned char *pBlock)
 {
-	return nullptr;
+	unsigned char **ppChunkHeader = reinterpret_cast<unsigned char **>(pBlock);
+	return ppChunkHeader[0];
 }
 
 void BGE::MemoryPool::SetNext(unsigned char *pBlockToChange, unsigned char *pRawNext)
 {
+	unsigned char **ppChunkHeader = reinterpret_cast<unsigned char **>(pBlockToChange);
+	ppChunkHeader[0] = pRawNext;
 }
@@ -35,6 +35,9 @@ namespace BGE
 	 */
 	class MemoryPool
 	{
+		// Size of the header preceding each chunk (holds the next pointer)
+		static constexpr std::size_t kCHUNK_HEADER_SIZE = sizeof(unsigned char *);
+
 		unsigned char **m_ppRawMemoryArray; // Array of memory blocks, each split into chunks
 		unsigned char *m_pHead; // Front of the memory chunk linked list
 		std::size_t m_chunkSize, m_numChunks; // Size of each chunk & number of chunks per array
@@ -0,0 +1,115 @@
+/*=============================================================================*
+ * JobSystem.cpp - Data parallel jobs on top of the thread pool.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "JobSystem.hpp"
+
+#include <atomic>
+#include <exception>
+
+namespace
+{
+	// Shared with the helper tasks, which may start after ParallelFor() has returned.
+	struct ForState
+	{
+		std::atomic<std::size_t> nextChunk{ 0 };
+		std::atomic<std::size_t> numDone{ 0 };
+		std::size_t numChunks = 0;
+		std::size_t count = 0;
+		std::size_t grainSize = 0;
+		const BGE::JobSystem::RangeFunc *pFunc = nullptr; // Only valid while chunks remain
+		std::mutex errorMutex;
+		std::exception_ptr pError;
+	};
+
+	void RunChunks(ForState &state)
+	{
+		while (true)
+		{
+			const std::size_t kChunk = state.nextChunk.fetch_add(1, std::memory_order_relaxed);
+			if (kChunk >= state.numChunks)
+				return;
+
+			const std::size_t kBegin = kChunk * state.grainSize;
+			const std::size_t kEnd = std::min(kBegin + state.grainSize, state.count);
+			try
+			{
+				(*state.pFunc)(kBegin, kEnd);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(state.errorMutex);
+				if (!state.pError)
+					state.pError = std::current_exception();
+			}
+			// Release pairs with the caller's acquire, publishing the chunk's writes
+			if (state.numDone.fetch_add(1, std::memory_order_acq_rel) + 1 == state.numChunks)
+				state.numDone.notify_all();
+		}
+	}
+} // End anonymous namespace
+
+BGE::JobSystem::JobSystem(int numWorkers)
+	: m_pool(numWorkers)
+{
+}
+
+void BGE::JobSystem::ParallelFor(std::size_t count, std::size_t grainSize, const RangeFunc &func)
+{
+	if (count == 0)
+		return;
+
+	grainSize = std::max<std::size_t>(grainSize, 1);
+	const std::size_t kNumChunks = (count + grainSize - 1) / grainSize;
+	if (kNumChunks == 1)
+	{
+		func(0, count);
+		return;
+	}
+
+	auto pState = std::make_shared<ForState>();
+	pState->numChunks = kNumChunks;
+	pState->count = count;
+	pState->grainSize = grainSize;
+	pState->pFunc = &func;
+	// The caller takes a share of the chunks, so one helper fewer is enough
+	const std::size_t kNumHelpers = std::min<std::size_t>(m_pool.GetNumThreads(), kNumChunks - 1);
+	for (std::size_t index = 0; index < kNumHelpers; ++index)
+		m_pool.Submit([pState](void) { RunChunks(*pState); });
+
+	RunChunks(*pState);
+	// Wait for chunks still running on the helpers
+	std::size_t numDone = pState->numDone.load(std::memory_order_acquire);
+	while (numDone != kNumChunks)
+	{
+		pState->numDone.wait(numDone, std::memory_order_acquire);
+		numDone = pState->numDone.load(std::memory_order_acquire);
+	}
+
+	if (pState->pError)
+		std::rethrow_exception(pState->pError);
+}
@@ -0,0 +1,64 @@
+/*=============================================================================*
+ * JobSystem.hpp - Data parallel jobs on top of the thread pool.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_JOBSYSTEM_HPP_
+#define _BGE_JOBSYSTEM_HPP_
+
+#include "Multicore/ThreadPool.hpp"
+
+#include <functional>
+
+namespace BGE
+{
+	/**
+	 * JobSystem splits a range of work into fixed size chunks and runs them on a
+	 * ThreadPool. The calling thread claims chunks too, so a job may start another
+	 * ParallelFor from inside a chunk without deadlocking the pool.
+	 *
+	 * Chunk boundaries depend only on the count and grain size, never on timing,
+	 * so per-chunk results are reproducible.
+	 */
+	class JobSystem : public INonCopyable, public INonMoveable
+	{
+	public:
+		// Processes the half-open index range [begin, end).
+		using RangeFunc = std::function<void(std::size_t, std::size_t)>;
+	private:
+		ThreadPool m_pool;
+	public:
+		// NUMWORKERS excludes the calling thread.
+		explicit JobSystem(int numWorkers = ThreadPool::GetDefaultNumThreads());
+
+		// Call FUNC over [0, count) in chunks of GRAINSIZE and return once all are done.
+		// The first exception thrown by a chunk is rethrown here.
+		void ParallelFor(std::size_t count, std::size_t grainSize, const RangeFunc &func);
+		// Worker threads plus the calling thread.
+		int GetConcurrency(void) const { return m_pool.GetNumThreads() + 1; }
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_JOBSYSTEM_HPP_ */
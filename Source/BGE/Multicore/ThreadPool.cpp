@@ -0,0 +1,97 @@
+/*=============================================================================*
+ * ThreadPool.cpp - Fixed size worker thread pool.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "ThreadPool.hpp"
+
+#include "MainLoop/Initialization.hpp"
+
+#include <algorithm>
+
+BGE::ThreadPool::ThreadPool(int numThreads)
+	: m_numBusy(0),
+	  m_toStop(false)
+{
+	numThreads = std::max(numThreads, 1);
+	m_workers.reserve(numThreads);
+	for (int index = 0; index < numThreads; ++index)
+		m_workers.emplace_back(&ThreadPool::WorkerMain, this);
+}
+
+BGE::ThreadPool::~ThreadPool(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_toStop = true;
+	}
+	m_taskCondition.notify_all();
+	for (auto &worker : m_workers)
+		worker.join();
+}
+
+void BGE::ThreadPool::WaitIdle(void)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idleCondition.wait(lock, [this](void) { return m_tasks.empty() && m_numBusy == 0; });
+}
+
+int BGE::ThreadPool::GetDefaultNumThreads(void)
+{
+	return std::max(ReadLogicalCPUCores() - 1, 1);
+}
+
+void BGE::ThreadPool::Enqueue(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		BGE_ASSERT(!m_toStop && "Task submitted to a stopping pool!");
+		m_tasks.push_back(std::move(task));
+	}
+	m_taskCondition.notify_one();
+}
+
+void BGE::ThreadPool::WorkerMain(void)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_taskCondition.wait(lock, [this](void) { return m_toStop || !m_tasks.empty(); });
+		// Drain the queue before honoring a stop request
+		if (m_tasks.empty())
+			return;
+
+		Task task = std::move(m_tasks.front());
+		m_tasks.pop_front();
+		++m_numBusy;
+		lock.unlock();
+		task(); // Exceptions are captured by the packaged task
+		lock.lock();
+		--m_numBusy;
+		if (m_tasks.empty() && m_numBusy == 0)
+			m_idleCondition.notify_all();
+	}
+}
@@ -0,0 +1,85 @@
+/*=============================================================================*
+ * ThreadPool.hpp - Fixed size worker thread pool.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_THREADPOOL_HPP_
+#define _BGE_THREADPOOL_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace BGE
+{
+	/**
+	 * ThreadPool runs submitted tasks on a fixed set of worker threads in FIFO order.
+	 * The destructor finishes every queued task before joining the workers.
+	 */
+	class ThreadPool : public INonCopyable, public INonMoveable
+	{
+		using Task = std::function<void(void)>;
+
+		std::vector<std::thread> m_workers;
+		std::deque<Task> m_tasks;
+		std::mutex m_mutex;
+		std::condition_variable m_taskCondition; // Signaled when a task is queued
+		std::condition_variable m_idleCondition; // Signaled when a worker runs out of tasks
+		int m_numBusy; // Workers currently running a task
+		bool m_toStop;
+	public:
+		explicit ThreadPool(int numThreads = GetDefaultNumThreads());
+		~ThreadPool(void);
+		// Queue a callable; the future carries its result or exception.
+		template <typename Func>
+		auto Submit(Func &&func) -> std::future<std::invoke_result_t<std::decay_t<Func>>>;
+		// Block until the queue is empty and no worker is busy.
+		void WaitIdle(void);
+		int GetNumThreads(void) const { return static_cast<int>(m_workers.size()); }
+		// One worker per logical core, leaving one for the main thread.
+		static int GetDefaultNumThreads(void);
+	private:
+		void Enqueue(Task task);
+		void WorkerMain(void);
+	};
+
+	template <typename Func>
+	auto ThreadPool::Submit(Func &&func) -> std::future<std::invoke_result_t<std::decay_t<Func>>>
+	{
+		using Result = std::invoke_result_t<std::decay_t<Func>>;
+		// std::function requires a copyable target, so share the packaged task
+		auto pTask = std::make_shared<std::packaged_task<Result(void)>>(std::forward<Func>(func));
+		std::future<Result> future = pTask->get_future();
+		Enqueue([pTask](void) { (*pTask)(); });
+		return future;
+	}
+} // End namespace (BGE)
+
+#endif /* !_BGE_THREADPOOL_HPP_ */
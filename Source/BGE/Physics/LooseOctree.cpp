@@ -0,0 +1,372 @@
+/*=============================================================================*
+ * LooseOctree.cpp - Loose octree of actor bounding spheres.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "LooseOctree.hpp"
+
+#include <queue>
+
+namespace
+{
+	// Node keys pack the depth in the top 4 bits and 20 bits per cell coordinate.
+	constexpr std::uint64_t kCOORD_MASK = 0xFFFFF;
+	constexpr std::uint64_t kROOT_KEY = 0;
+
+	constexpr std::uint64_t MakeKey(std::uint32_t depth, std::uint64_t x, std::uint64_t y, std::uint64_t z)
+	{
+		return (std::uint64_t(depth) << 60) | (x << 40) | (y << 20) | z;
+	}
+	constexpr std::uint32_t GetDepth(std::uint64_t key) { return static_cast<std::uint32_t>(key >> 60); }
+	constexpr std::uint64_t GetX(std::uint64_t key) { return (key >> 40) & kCOORD_MASK; }
+	constexpr std::uint64_t GetY(std::uint64_t key) { return (key >> 20) & kCOORD_MASK; }
+	constexpr std::uint64_t GetZ(std::uint64_t key) { return key & kCOORD_MASK; }
+	constexpr std::uint64_t GetParentKey(std::uint64_t key)
+	{
+		return MakeKey(GetDepth(key) - 1, GetX(key) >> 1, GetY(key) >> 1, GetZ(key) >> 1);
+	}
+	constexpr std::uint64_t GetChildKey(std::uint64_t key, std::uint32_t child)
+	{
+		return MakeKey(GetDepth(key) + 1, (GetX(key) << 1) | (child & 1), (GetY(key) << 1) | ((child >> 1) & 1),
+					   (GetZ(key) << 1) | ((child >> 2) & 1));
+	}
+	constexpr std::uint32_t GetChildIndex(std::uint64_t key)
+	{
+		return static_cast<std::uint32_t>((GetX(key) & 1) | ((GetY(key) & 1) << 1) | ((GetZ(key) & 1) << 2));
+	}
+	static_assert(GetParentKey(GetChildKey(MakeKey(3, 5, 6, 7), 5)) == MakeKey(3, 5, 6, 7));
+	static_assert(GetChildIndex(GetChildKey(MakeKey(3, 5, 6, 7), 6)) == 6);
+
+	float DistanceSqToBox(const BGE::Math::Vec3f &point, const BGE::Math::Vec3f &min, const BGE::Math::Vec3f &max)
+	{
+		const float kDX = std::max({ min.x - point.x, 0.0f, point.x - max.x });
+		const float kDY = std::max({ min.y - point.y, 0.0f, point.y - max.y });
+		const float kDZ = std::max({ min.z - point.z, 0.0f, point.z - max.z });
+		return kDX * kDX + kDY * kDY + kDZ * kDZ;
+	}
+	// Distance along RAY to the sphere's surface (0 if it starts inside), or a negative value on a miss.
+	float IntersectRaySphere(const BGE::SpatialRay3D &ray, const BGE::Math::Vec3f &center, float radius)
+	{
+		const BGE::Math::Vec3f kOffset = ray.origin - center;
+		const float kB = kOffset.Dot(ray.direction);
+		const float kC = kOffset.Dot(kOffset) - radius * radius;
+		if (kC <= 0.0f)
+			return 0.0f;
+		if (kB > 0.0f)
+			return -1.0f;
+		const float kDiscriminant = kB * kB - kC;
+		return (kDiscriminant < 0.0f) ? -1.0f : -kB - std::sqrt(kDiscriminant);
+	}
+	// Slab test; the entry distance of RAY into the box, or a negative value on a miss.
+	float IntersectRayBox(const BGE::SpatialRay3D &ray, const BGE::Math::Vec3f &invDirection,
+						  const BGE::Math::Vec3f &min, const BGE::Math::Vec3f &max)
+	{
+		const BGE::Math::Vec3f kT0 = (min - ray.origin) * invDirection;
+		const BGE::Math::Vec3f kT1 = (max - ray.origin) * invDirection;
+		const float kEnter = std::max({ std::min(kT0.x, kT1.x), std::min(kT0.y, kT1.y), std::min(kT0.z, kT1.z), 0.0f });
+		const float kExit = std::min({ std::max(kT0.x, kT1.x), std::max(kT0.y, kT1.y), std::max(kT0.z, kT1.z) });
+		return (kEnter <= kExit) ? kEnter : -1.0f;
+	}
+	// Sorts a max-heap of the best hits so far, worst on top
+	bool IsCloser(const BGE::SpatialHit &lhs, const BGE::SpatialHit &rhs) { return lhs.distance < rhs.distance; }
+} // End anonymous namespace
+
+BGE::LooseOctree::LooseOctree(const Math::Vec3f &origin, float worldSize, std::uint32_t maxDepth)
+	: m_origin(origin),
+	  m_worldSize(worldSize),
+	  m_maxDepth(std::min(maxDepth, kMAX_DEPTH_LIMIT)),
+	  m_numEntries(0)
+{
+	BGE_ASSERT(worldSize > 0.0f);
+	FindOrCreateNode(kROOT_KEY);
+}
+
+BGE::SpatialHandle BGE::LooseOctree::Insert(ActorID aID, const Math::Vec3f &center, float radius)
+{
+	BGE_ASSERT(aID != kINVALID_ACTOR_ID && radius >= 0.0f);
+	SpatialHandle handle;
+	if (m_freeHandles.empty())
+	{
+		handle = static_cast<SpatialHandle>(m_entries.size());
+		m_entries.emplace_back();
+	}
+	else
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	m_entries[handle] = Entry{ aID, center, radius, kNO_NODE, 0 };
+	Link(handle, LocateNode(center, radius));
+	++m_numEntries;
+	return handle;
+}
+
+void BGE::LooseOctree::Remove(SpatialHandle handle)
+{
+	BGE_ASSERT(IsValid(handle));
+	Unlink(handle);
+	m_entries[handle].aID = kINVALID_ACTOR_ID;
+	m_freeHandles.push_back(handle);
+	--m_numEntries;
+}
+
+void BGE::LooseOctree::Move(SpatialHandle handle, const Math::Vec3f &center, float radius)
+{
+	BGE_ASSERT(IsValid(handle));
+	Entry &entry = m_entries[handle];
+	const std::uint64_t kKey = LocateNode(center, radius);
+	entry.center = center;
+	entry.radius = radius;
+	if (kKey == m_nodes[entry.node].key)
+		return;
+	Unlink(handle);
+	Link(handle, kKey);
+}
+
+void BGE::LooseOctree::QuerySphere(const Math::Vec3f &center, float radius, std::vector<ActorID> &outActorIDs) const
+{
+	if (m_numEntries != 0)
+		QuerySphere(kROOT_NODE, center, radius, outActorIDs);
+}
+
+void BGE::LooseOctree::QuerySpheres(std::span<const Math::Vec3f> centers, float radius, SpatialBatchResult &outResult) const
+{
+	outResult.Clear();
+	outResult.offsets.reserve(centers.size() + 1);
+	for (const auto &kCenter : centers)
+	{
+		QuerySphere(kCenter, radius, outResult.actorIDs);
+		outResult.offsets.push_back(static_cast<std::uint32_t>(outResult.actorIDs.size()));
+	}
+}
+
+bool BGE::LooseOctree::Raycast(const SpatialRay3D &ray, SpatialHit &outHit) const
+{
+	outHit = SpatialHit{ kINVALID_ACTOR_ID, ray.maxDistance };
+	if (m_numEntries == 0)
+		return false;
+	// Infinite components are fine: the slab test only compares them
+	const Math::Vec3f kInvDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+	Raycast(kROOT_NODE, ray, kInvDirection, outHit);
+	return outHit.aID != kINVALID_ACTOR_ID;
+}
+
+void BGE::LooseOctree::Raycasts(std::span<const SpatialRay3D> rays, std::span<SpatialHit> outHits) const
+{
+	BGE_ASSERT(outHits.size() >= rays.size());
+	for (std::size_t index = 0; index < rays.size(); ++index)
+		Raycast(rays[index], outHits[index]);
+}
+
+void BGE::LooseOctree::QueryNearest(const Math::Vec3f &point, std::size_t k, std::vector<SpatialHit> &outHits) const
+{
+	outHits.clear();
+	if (k == 0 || m_numEntries == 0)
+		return;
+	// Best first: visit nodes by distance, stop once none can beat the K-th hit
+	using NodeDistance = std::pair<float, std::uint32_t>;
+	std::priority_queue<NodeDistance, std::vector<NodeDistance>, std::greater<NodeDistance>> nodes;
+	nodes.emplace(0.0f, kROOT_NODE);
+	while (!nodes.empty())
+	{
+		const auto [kDistanceSq, kNodeIndex] = nodes.top();
+		nodes.pop();
+		if (outHits.size() == k && kDistanceSq > outHits.front().distance * outHits.front().distance)
+			break;
+
+		const Node &kNode = m_nodes[kNodeIndex];
+		for (const SpatialHandle kHandle : kNode.entries)
+		{
+			const Entry &kEntry = m_entries[kHandle];
+			const Math::Vec3f kOffset = kEntry.center - point;
+			const float kDistance = std::max(std::sqrt(kOffset.Dot(kOffset)) - kEntry.radius, 0.0f);
+			if (outHits.size() == k)
+			{
+				if (kDistance >= outHits.front().distance)
+					continue;
+				std::pop_heap(outHits.begin(), outHits.end(), IsCloser);
+				outHits.pop_back();
+			}
+			outHits.push_back(SpatialHit{ kEntry.aID, kDistance });
+			std::push_heap(outHits.begin(), outHits.end(), IsCloser);
+		}
+		for (std::uint32_t child = 0; child < 8; ++child)
+		{
+			if (kNode.children[child] == kNO_NODE)
+				continue;
+			Math::Vec3f min(0.0f), max(0.0f);
+			GetChildLooseBounds(kNode, child, min, max);
+			nodes.emplace(DistanceSqToBox(point, min, max), kNode.children[child]);
+		}
+	}
+	std::sort_heap(outHits.begin(), outHits.end(), IsCloser);
+}
+
+std::uint64_t BGE::LooseOctree::LocateNode(const Math::Vec3f &center, float radius) const
+{
+	const Math::Vec3f kLocal = center - m_origin;
+	if (kLocal.x < 0.0f || kLocal.y < 0.0f || kLocal.z < 0.0f
+		|| kLocal.x >= m_worldSize || kLocal.y >= m_worldSize || kLocal.z >= m_worldSize)
+		return kROOT_KEY;
+	// Deepest depth whose cells are at least as wide as the sphere
+	std::uint32_t depth = 0;
+	float cellSize = m_worldSize;
+	while (depth < m_maxDepth && cellSize * 0.5f >= radius * 2.0f)
+	{
+		cellSize *= 0.5f;
+		++depth;
+	}
+	const std::uint64_t kMaxCoord = (std::uint64_t(1) << depth) - 1;
+	const auto ToCell = [&](float coord)
+	{
+		return std::min(static_cast<std::uint64_t>(coord / cellSize), kMaxCoord);
+	};
+	return MakeKey(depth, ToCell(kLocal.x), ToCell(kLocal.y), ToCell(kLocal.z));
+}
+
+std::uint32_t BGE::LooseOctree::FindOrCreateNode(std::uint64_t key)
+{
+	const auto kFindIter = m_nodeIndices.find(key);
+	if (kFindIter != m_nodeIndices.end())
+		return kFindIter->second;
+
+	const std::uint32_t kDepth = GetDepth(key);
+	const std::uint32_t kParent = (kDepth != 0) ? FindOrCreateNode(GetParentKey(key)) : kNO_NODE;
+	std::uint32_t index;
+	if (m_freeNodes.empty())
+	{
+		index = static_cast<std::uint32_t>(m_nodes.size());
+		m_nodes.emplace_back();
+	}
+	else
+	{
+		index = m_freeNodes.back();
+		m_freeNodes.pop_back();
+	}
+
+	Node &node = m_nodes[index];
+	node.key = key;
+	node.parent = kParent;
+	node.subtreeCount = 0;
+	node.children.fill(kNO_NODE);
+	node.cellSize = m_worldSize / static_cast<float>(std::uint64_t(1) << kDepth);
+	node.cellMin = m_origin + Math::Vec3f(static_cast<float>(GetX(key)), static_cast<float>(GetY(key)),
+										  static_cast<float>(GetZ(key))) * node.cellSize;
+	if (kParent != kNO_NODE)
+		m_nodes[kParent].children[GetChildIndex(key)] = index;
+	m_nodeIndices.emplace(key, index);
+	return index;
+}
+
+void BGE::LooseOctree::Link(SpatialHandle handle, std::uint64_t key)
+{
+	const std::uint32_t kNodeIndex = FindOrCreateNode(key);
+	Entry &entry = m_entries[handle];
+	Node &node = m_nodes[kNodeIndex];
+	entry.node = kNodeIndex;
+	entry.nodeSlot = static_cast<std::uint32_t>(node.entries.size());
+	node.entries.push_back(handle);
+	for (std::uint32_t index = kNodeIndex; index != kNO_NODE; index = m_nodes[index].parent)
+		++m_nodes[index].subtreeCount;
+}
+
+void BGE::LooseOctree::Unlink(SpatialHandle handle)
+{
+	const Entry &kEntry = m_entries[handle];
+	Node &node = m_nodes[kEntry.node];
+	const SpatialHandle kMoved = node.entries.back();
+	node.entries[kEntry.nodeSlot] = kMoved;
+	m_entries[kMoved].nodeSlot = kEntry.nodeSlot;
+	node.entries.pop_back();
+	// Free nodes whose subtree empties; the root stays
+	for (std::uint32_t index = kEntry.node; index != kNO_NODE; )
+	{
+		Node &current = m_nodes[index];
+		const std::uint32_t kParent = current.parent;
+		if (--current.subtreeCount == 0 && kParent != kNO_NODE)
+		{
+			m_nodes[kParent].children[GetChildIndex(current.key)] = kNO_NODE;
+			m_nodeIndices.erase(current.key);
+			m_freeNodes.push_back(index);
+		}
+		index = kParent;
+	}
+}
+
+void BGE::LooseOctree::GetChildLooseBounds(const Node &parent, std::uint32_t child, Math::Vec3f &outMin, Math::Vec3f &outMax)
+{
+	const float kChildSize = parent.cellSize * 0.5f;
+	const Math::Vec3f kChildMin = parent.cellMin + Math::Vec3f(static_cast<float>(child & 1), static_cast<float>((child >> 1) & 1),
+															   static_cast<float>((child >> 2) & 1)) * kChildSize;
+	outMin = kChildMin - Math::Vec3f(kChildSize * 0.5f);
+	outMax = kChildMin + Math::Vec3f(kChildSize * 1.5f);
+}
+
+void BGE::LooseOctree::QuerySphere(std::uint32_t nodeIndex, const Math::Vec3f &center, float radius,
+								   std::vector<ActorID> &outActorIDs) const
+{
+	const Node &kNode = m_nodes[nodeIndex];
+	for (const SpatialHandle kHandle : kNode.entries)
+	{
+		const Entry &kEntry = m_entries[kHandle];
+		const Math::Vec3f kOffset = kEntry.center - center;
+		const float kReach = radius + kEntry.radius;
+		if (kOffset.Dot(kOffset) <= kReach * kReach)
+			outActorIDs.push_back(kEntry.aID);
+	}
+	for (std::uint32_t child = 0; child < 8; ++child)
+	{
+		if (kNode.children[child] == kNO_NODE)
+			continue;
+		Math::Vec3f min(0.0f), max(0.0f);
+		GetChildLooseBounds(kNode, child, min, max);
+		if (DistanceSqToBox(center, min, max) <= radius * radius)
+			QuerySphere(kNode.children[child], center, radius, outActorIDs);
+	}
+}
+
+void BGE::LooseOctree::Raycast(std::uint32_t nodeIndex, const SpatialRay3D &ray, const Math::Vec3f &invDirection,
+							   SpatialHit &hit) const
+{
+	const Node &kNode = m_nodes[nodeIndex];
+	for (const SpatialHandle kHandle : kNode.entries)
+	{
+		const Entry &kEntry = m_entries[kHandle];
+		const float kDistance = IntersectRaySphere(ray, kEntry.center, kEntry.radius);
+		if (kDistance >= 0.0f && kDistance <= hit.distance)
+			hit = SpatialHit{ kEntry.aID, kDistance };
+	}
+	for (std::uint32_t child = 0; child < 8; ++child)
+	{
+		if (kNode.children[child] == kNO_NODE)
+			continue;
+		Math::Vec3f min(0.0f), max(0.0f);
+		GetChildLooseBounds(kNode, child, min, max);
+		const float kEnter = IntersectRayBox(ray, invDirection, min, max);
+		if (kEnter >= 0.0f && kEnter <= hit.distance)
+			Raycast(kNode.children[child], ray, invDirection, hit);
+	}
+}
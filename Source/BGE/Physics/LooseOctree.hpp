@@ -0,0 +1,122 @@
+/*=============================================================================*
+ * LooseOctree.hpp - Loose octree of actor bounding spheres.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_LOOSEOCTREE_HPP_
+#define _BGE_LOOSEOCTREE_HPP_
+
+#include "Physics/SpatialTypes.hpp"
+
+#include <array>
+#include <unordered_map>
+
+namespace BGE
+{
+	/**
+	 * LooseOctree indexes bounding spheres in 3D. Each node's bounds are its cell
+	 * grown by half a cell on every side, so a sphere no wider than a cell fits the
+	 * node its center falls in. That fixes an entry's node from its center and radius
+	 * alone: insertion needs no descent, and a moving entry only changes node when its
+	 * center crosses a cell, which for most moves it does not.
+	 *
+	 * Nodes are pooled and linked by index; a hash map from depth and cell to node
+	 * is only consulted to place entries. Nodes are created on demand and freed once
+	 * their subtree is empty. Entries outside the world cube go in the root, whose
+	 * bounds are unlimited.
+	 */
+	class LooseOctree : public INonCopyable
+	{
+		static constexpr std::uint32_t kMAX_DEPTH_LIMIT = 15;
+		static constexpr std::uint32_t kNO_NODE = 0xFFFFFFFF;
+		static constexpr std::uint32_t kROOT_NODE = 0;
+
+		struct Entry
+		{
+			ActorID aID;
+			Math::Vec3f center{ 0.0f };
+			float radius;
+			std::uint32_t node;
+			std::uint32_t nodeSlot; // Index in the node's entry list
+		};
+		struct Node
+		{
+			Math::Vec3f cellMin{ 0.0f }; // Loose bounds are the cell grown by half its size
+			float cellSize = 0.0f;
+			std::uint64_t key = 0;
+			std::uint32_t parent = kNO_NODE;
+			std::uint32_t subtreeCount = 0; // Entries in this node and below
+			std::array<std::uint32_t, 8> children;
+			std::vector<SpatialHandle> entries;
+		};
+
+		Math::Vec3f m_origin; // Minimum corner of the world cube
+		float m_worldSize;
+		std::uint32_t m_maxDepth;
+		std::vector<Entry> m_entries; // By handle; free ones have kINVALID_ACTOR_ID
+		std::vector<SpatialHandle> m_freeHandles;
+		std::vector<Node> m_nodes;
+		std::vector<std::uint32_t> m_freeNodes;
+		std::unordered_map<std::uint64_t, std::uint32_t> m_nodeIndices; // By key
+		std::size_t m_numEntries;
+	public:
+		// The world cube spans ORIGIN to ORIGIN + WORLDSIZE on each axis; the smallest
+		// cells are WORLDSIZE / 2^MAXDEPTH wide.
+		LooseOctree(const Math::Vec3f &origin, float worldSize, std::uint32_t maxDepth);
+
+		SpatialHandle Insert(ActorID aID, const Math::Vec3f &center, float radius);
+		void Remove(SpatialHandle handle);
+		// Cheap when the entry stays in its cell, which is the common case.
+		void Move(SpatialHandle handle, const Math::Vec3f &center, float radius);
+		void Move(SpatialHandle handle, const Math::Vec3f &center) { Move(handle, center, m_entries[handle].radius); }
+		bool IsValid(SpatialHandle handle) const
+		{
+			return handle < m_entries.size() && m_entries[handle].aID != kINVALID_ACTOR_ID;
+		}
+		std::size_t GetSize(void) const noexcept { return m_numEntries; }
+		std::size_t GetNumNodes(void) const noexcept { return m_nodes.size() - m_freeNodes.size(); }
+
+		// Append the actors whose spheres overlap the query sphere to OUTACTORIDS.
+		void QuerySphere(const Math::Vec3f &center, float radius, std::vector<ActorID> &outActorIDs) const;
+		void QuerySpheres(std::span<const Math::Vec3f> centers, float radius, SpatialBatchResult &outResult) const;
+		// Nearest sphere hit by RAY; false if none within its maxDistance.
+		bool Raycast(const SpatialRay3D &ray, SpatialHit &outHit) const;
+		void Raycasts(std::span<const SpatialRay3D> rays, std::span<SpatialHit> outHits) const;
+		// The K nearest entries to POINT, closest first.
+		void QueryNearest(const Math::Vec3f &point, std::size_t k, std::vector<SpatialHit> &outHits) const;
+	private:
+		std::uint64_t LocateNode(const Math::Vec3f &center, float radius) const;
+		// Index of the node with KEY, creating it and any missing ancestors.
+		std::uint32_t FindOrCreateNode(std::uint64_t key);
+		void Link(SpatialHandle handle, std::uint64_t key);
+		void Unlink(SpatialHandle handle);
+		// Children are culled from the parent's cell, without touching their nodes.
+		static void GetChildLooseBounds(const Node &parent, std::uint32_t child, Math::Vec3f &outMin, Math::Vec3f &outMax);
+		void QuerySphere(std::uint32_t node, const Math::Vec3f &center, float radius, std::vector<ActorID> &outActorIDs) const;
+		void Raycast(std::uint32_t node, const SpatialRay3D &ray, const Math::Vec3f &invDirection, SpatialHit &hit) const;
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_LOOSEOCTREE_HPP_ */
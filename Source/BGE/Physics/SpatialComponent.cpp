@@ -0,0 +1,88 @@
+/*=============================================================================*
+ * SpatialComponent.cpp - Actor component tracking its owner in a spatial index.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "SpatialComponent.hpp"
+#include "Actors/Actor.hpp"
+#include "Actors/ActorArchetype.hpp"
+#include "Actors/TransformComponent.hpp"
+
+BGE::SpatialComponent::SpatialComponent(TransformOctree &index)
+	: m_index(index),
+	  m_transform(kINVALID_TRANSFORM_HANDLE),
+	  m_radius(0.5f)
+{
+}
+
+BGE::SpatialComponent::~SpatialComponent(void)
+{
+	Untrack();
+}
+
+bool BGE::SpatialComponent::VInit(tinyxml2::XMLElement *pData)
+{
+	pData->QueryFloatAttribute("radius", &m_radius);
+	return m_radius >= 0.0f;
+}
+
+void BGE::SpatialComponent::VPostInit(void)
+{
+	const auto *pTransform = m_pOwner->FindComponent<TransformComponent>();
+	if (!pTransform)
+	{
+		BGE_WARNING("SpatialComponent of actor %u needs a TransformComponent", m_pOwner->GetID());
+		return;
+	}
+	m_transform = pTransform->GetHandle();
+	m_index.Track(m_transform, m_pOwner->GetID(), m_radius);
+}
+
+tinyxml2::XMLElement *BGE::SpatialComponent::VGenerateXML(tinyxml2::XMLDocument &doc)
+{
+	tinyxml2::XMLElement *pElem = doc.NewElement(kNAME.data());
+	pElem->SetAttribute("radius", m_radius);
+	return pElem;
+}
+
+bool BGE::SpatialComponent::VWriteBlob(BlobWriter &writer) const
+{
+	writer.Write(m_radius);
+	return true;
+}
+
+bool BGE::SpatialComponent::VInitFromBlob(BlobReader &reader)
+{
+	return reader.Read(m_radius);
+}
+
+void BGE::SpatialComponent::Untrack(void)
+{
+	if (m_transform == kINVALID_TRANSFORM_HANDLE)
+		return;
+	m_index.Untrack(m_transform);
+	m_transform = kINVALID_TRANSFORM_HANDLE;
+}
@@ -0,0 +1,66 @@
+/*=============================================================================*
+ * SpatialComponent.hpp - Actor component tracking its owner in a spatial index.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_SPATIALCOMPONENT_HPP_
+#define _BGE_SPATIALCOMPONENT_HPP_
+
+#include "Actors/ActorComponent.hpp"
+#include "Physics/TransformSpatialIndex.hpp"
+
+namespace BGE
+{
+	/**
+	 * SpatialComponent makes its owner findable through a TransformOctree, at the
+	 * world position of the owner's TransformComponent.
+	 *
+	 * XML: <SpatialComponent radius=""/>
+	 */
+	class SpatialComponent final : public ActorComponent
+	{
+		BGE_ACTOR_COMPONENT(SpatialComponent)
+	private:
+		TransformOctree &m_index;
+		TransformHandle m_transform; // Tracked node, if any
+		float m_radius;
+	public:
+		explicit SpatialComponent(TransformOctree &index);
+		virtual ~SpatialComponent(void);
+
+		virtual bool VInit(tinyxml2::XMLElement *pData) override;
+		virtual void VPostInit(void) override;
+		virtual void VOnRecycled(void) override { Untrack(); }
+		virtual tinyxml2::XMLElement *VGenerateXML(tinyxml2::XMLDocument &doc) override;
+		virtual bool VWriteBlob(BlobWriter &writer) const override;
+		virtual bool VInitFromBlob(BlobReader &reader) override;
+
+		float GetRadius(void) const noexcept { return m_radius; }
+	private:
+		void Untrack(void);
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_SPATIALCOMPONENT_HPP_ */
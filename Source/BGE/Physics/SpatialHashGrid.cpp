@@ -0,0 +1,296 @@
+/*=============================================================================*
+ * SpatialHashGrid.cpp - Uniform hash grid of actor bounding circles.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "SpatialHashGrid.hpp"
+
+namespace
+{
+	// Distance along RAY to the circle's edge (0 if it starts inside), or a negative value on a miss.
+	float IntersectRayCircle(const BGE::SpatialRay2D &ray, const BGE::Math::Vec2f &center, float radius)
+	{
+		const BGE::Math::Vec2f kOffset = ray.origin - center;
+		const float kB = kOffset.Dot(ray.direction);
+		const float kC = kOffset.Dot(kOffset) - radius * radius;
+		if (kC <= 0.0f)
+			return 0.0f;
+		if (kB > 0.0f)
+			return -1.0f;
+		const float kDiscriminant = kB * kB - kC;
+		return (kDiscriminant < 0.0f) ? -1.0f : -kB - std::sqrt(kDiscriminant);
+	}
+	// Sorts a max-heap of the best hits so far, worst on top
+	bool IsCloser(const BGE::SpatialHit &lhs, const BGE::SpatialHit &rhs) { return lhs.distance < rhs.distance; }
+} // End anonymous namespace
+
+BGE::SpatialHashGrid::SpatialHashGrid(float cellSize)
+	: m_cellSize(cellSize),
+	  m_invCellSize(1.0f / cellSize),
+	  m_maxRadius(0.0f),
+	  m_numEntries(0)
+{
+	BGE_ASSERT(cellSize > 0.0f);
+}
+
+BGE::SpatialHandle BGE::SpatialHashGrid::Insert(ActorID aID, const Math::Vec2f &center, float radius)
+{
+	BGE_ASSERT(aID != kINVALID_ACTOR_ID && radius >= 0.0f);
+	SpatialHandle handle;
+	if (m_freeHandles.empty())
+	{
+		handle = static_cast<SpatialHandle>(m_entries.size());
+		m_entries.emplace_back();
+	}
+	else
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	m_entries[handle] = Entry{ aID, center, radius, MakeKey(ToCell(center.x), ToCell(center.y)), 0 };
+	m_maxRadius = std::max(m_maxRadius, radius);
+	Link(handle);
+	++m_numEntries;
+	return handle;
+}
+
+void BGE::SpatialHashGrid::Remove(SpatialHandle handle)
+{
+	BGE_ASSERT(IsValid(handle));
+	Unlink(handle);
+	m_entries[handle].aID = kINVALID_ACTOR_ID;
+	m_freeHandles.push_back(handle);
+	--m_numEntries;
+}
+
+void BGE::SpatialHashGrid::Move(SpatialHandle handle, const Math::Vec2f &center, float radius)
+{
+	BGE_ASSERT(IsValid(handle));
+	Entry &entry = m_entries[handle];
+	const std::uint64_t kKey = MakeKey(ToCell(center.x), ToCell(center.y));
+	entry.center = center;
+	entry.radius = radius;
+	m_maxRadius = std::max(m_maxRadius, radius);
+	if (kKey == entry.cellKey)
+		return;
+	Unlink(handle);
+	entry.cellKey = kKey;
+	Link(handle);
+}
+
+void BGE::SpatialHashGrid::QueryCircle(const Math::Vec2f &center, float radius, std::vector<ActorID> &outActorIDs) const
+{
+	const auto TestEntry = [&](const Entry &entry)
+	{
+		const Math::Vec2f kOffset = entry.center - center;
+		const float kReach = radius + entry.radius;
+		if (kOffset.Dot(kOffset) <= kReach * kReach)
+			outActorIDs.push_back(entry.aID);
+	};
+	const float kSearch = radius + m_maxRadius;
+	const std::int32_t kMinX = ToCell(center.x - kSearch), kMaxX = ToCell(center.x + kSearch);
+	const std::int32_t kMinY = ToCell(center.y - kSearch), kMaxY = ToCell(center.y + kSearch);
+	// Huge queries are cheaper over the occupied cells than over the covered ones
+	const double kNumCovered = (double(kMaxX) - kMinX + 1) * (double(kMaxY) - kMinY + 1);
+	if (kNumCovered > static_cast<double>(m_cells.size()))
+	{
+		for (const auto &[kKey, kHandles] : m_cells)
+		{
+			for (const SpatialHandle kHandle : kHandles)
+				TestEntry(m_entries[kHandle]);
+		}
+		return;
+	}
+	for (std::int32_t y = kMinY; y <= kMaxY; ++y)
+	{
+		for (std::int32_t x = kMinX; x <= kMaxX; ++x)
+			ForEachInCell(x, y, TestEntry);
+	}
+}
+
+void BGE::SpatialHashGrid::QueryCircles(std::span<const Math::Vec2f> centers, float radius, SpatialBatchResult &outResult) const
+{
+	outResult.Clear();
+	outResult.offsets.reserve(centers.size() + 1);
+	for (const auto &kCenter : centers)
+	{
+		QueryCircle(kCenter, radius, outResult.actorIDs);
+		outResult.offsets.push_back(static_cast<std::uint32_t>(outResult.actorIDs.size()));
+	}
+}
+
+bool BGE::SpatialHashGrid::Raycast(const SpatialRay2D &ray, SpatialHit &outHit) const
+{
+	BGE_ASSERT(std::isfinite(ray.maxDistance));
+	outHit = SpatialHit{ kINVALID_ACTOR_ID, ray.maxDistance };
+	if (m_numEntries == 0)
+		return false;
+
+	// Walk the cells under the ray (DDA). Entries reach up to m_maxRadius out of their
+	// cell, so each step also covers the cells within RING of it; a cell is tested at
+	// the first step that covers it, as later steps covering it follow directly.
+	const auto kRing = static_cast<std::int32_t>(std::ceil(m_maxRadius * m_invCellSize));
+	const float kMargin = static_cast<float>(kRing + 1) * m_cellSize * 1.4142136f + m_maxRadius;
+	std::int32_t x = ToCell(ray.origin.x), y = ToCell(ray.origin.y);
+	const std::int32_t kStepX = (ray.direction.x > 0.0f) ? 1 : ((ray.direction.x < 0.0f) ? -1 : 0);
+	const std::int32_t kStepY = (ray.direction.y > 0.0f) ? 1 : ((ray.direction.y < 0.0f) ? -1 : 0);
+	constexpr float kINFINITY = std::numeric_limits<float>::infinity();
+	const float kDeltaX = (kStepX != 0) ? m_cellSize / std::abs(ray.direction.x) : kINFINITY;
+	const float kDeltaY = (kStepY != 0) ? m_cellSize / std::abs(ray.direction.y) : kINFINITY;
+	float nextX = (kStepX != 0) ? ((x + (kStepX > 0)) * m_cellSize - ray.origin.x) / ray.direction.x : kINFINITY;
+	float nextY = (kStepY != 0) ? ((y + (kStepY > 0)) * m_cellSize - ray.origin.y) / ray.direction.y : kINFINITY;
+
+	const auto TestEntry = [&](const Entry &entry)
+	{
+		const float kDistance = IntersectRayCircle(ray, entry.center, entry.radius);
+		if (kDistance >= 0.0f && kDistance <= outHit.distance)
+			outHit = SpatialHit{ entry.aID, kDistance };
+	};
+	bool hasPrevious = false;
+	std::int32_t previousX = 0, previousY = 0;
+	for (float enter = 0.0f; enter <= outHit.distance + kMargin; )
+	{
+		for (std::int32_t cellY = y - kRing; cellY <= y + kRing; ++cellY)
+		{
+			for (std::int32_t cellX = x - kRing; cellX <= x + kRing; ++cellX)
+			{
+				if (hasPrevious && std::abs(cellX - previousX) <= kRing && std::abs(cellY - previousY) <= kRing)
+					continue;
+				ForEachInCell(cellX, cellY, TestEntry);
+			}
+		}
+		hasPrevious = true;
+		previousX = x;
+		previousY = y;
+		if (kStepX == 0 && kStepY == 0)
+			break;
+		if (nextX < nextY)
+		{
+			enter = nextX;
+			nextX += kDeltaX;
+			x += kStepX;
+		}
+		else
+		{
+			enter = nextY;
+			nextY += kDeltaY;
+			y += kStepY;
+		}
+	}
+	return outHit.aID != kINVALID_ACTOR_ID;
+}
+
+void BGE::SpatialHashGrid::Raycasts(std::span<const SpatialRay2D> rays, std::span<SpatialHit> outHits) const
+{
+	BGE_ASSERT(outHits.size() >= rays.size());
+	for (std::size_t index = 0; index < rays.size(); ++index)
+		Raycast(rays[index], outHits[index]);
+}
+
+void BGE::SpatialHashGrid::QueryNearest(const Math::Vec2f &point, std::size_t k, std::vector<SpatialHit> &outHits) const
+{
+	outHits.clear();
+	if (k == 0 || m_numEntries == 0)
+		return;
+
+	const auto TestEntry = [&](const Entry &entry)
+	{
+		const Math::Vec2f kOffset = entry.center - point;
+		const float kDistance = std::max(std::sqrt(kOffset.Dot(kOffset)) - entry.radius, 0.0f);
+		if (outHits.size() == k)
+		{
+			if (kDistance >= outHits.front().distance)
+				return;
+			std::pop_heap(outHits.begin(), outHits.end(), IsCloser);
+			outHits.pop_back();
+		}
+		outHits.push_back(SpatialHit{ entry.aID, kDistance });
+		std::push_heap(outHits.begin(), outHits.end(), IsCloser);
+	};
+	// Search square rings of cells outwards. Centers in ring R are at least R - 1
+	// cells from POINT, which bounds how close anything further out can be.
+	const std::int32_t kX = ToCell(point.x), kY = ToCell(point.y);
+	std::size_t numVisited = 0;
+	for (std::int32_t ring = 0; numVisited < m_numEntries; ++ring)
+	{
+		if (outHits.size() == k && static_cast<float>(ring - 1) * m_cellSize - m_maxRadius >= outHits.front().distance)
+			break;
+		const auto VisitCell = [&](std::int32_t x, std::int32_t y)
+		{
+			ForEachInCell(x, y, [&](const Entry &entry) { ++numVisited; TestEntry(entry); });
+		};
+		if (ring == 0)
+		{
+			VisitCell(kX, kY);
+			continue;
+		}
+		// Once rings hold more cells than are occupied, finish with a pass over the rest
+		if (std::size_t(8) * static_cast<std::size_t>(ring) > m_cells.size())
+		{
+			for (const auto &[kKey, kHandles] : m_cells)
+			{
+				const auto kCellX = static_cast<std::int32_t>(kKey >> 32), kCellY = static_cast<std::int32_t>(kKey & 0xFFFFFFFF);
+				if (std::max(std::abs(kCellX - kX), std::abs(kCellY - kY)) < ring)
+					continue;
+				for (const SpatialHandle kHandle : kHandles)
+					TestEntry(m_entries[kHandle]);
+			}
+			break;
+		}
+		for (std::int32_t offset = -ring; offset <= ring; ++offset)
+		{
+			VisitCell(kX + offset, kY - ring);
+			VisitCell(kX + offset, kY + ring);
+		}
+		for (std::int32_t offset = -ring + 1; offset < ring; ++offset)
+		{
+			VisitCell(kX - ring, kY + offset);
+			VisitCell(kX + ring, kY + offset);
+		}
+	}
+	std::sort_heap(outHits.begin(), outHits.end(), IsCloser);
+}
+
+void BGE::SpatialHashGrid::Link(SpatialHandle handle)
+{
+	Entry &entry = m_entries[handle];
+	auto &cell = m_cells[entry.cellKey];
+	entry.cellSlot = static_cast<std::uint32_t>(cell.size());
+	cell.push_back(handle);
+}
+
+void BGE::SpatialHashGrid::Unlink(SpatialHandle handle)
+{
+	const Entry &kEntry = m_entries[handle];
+	const auto kFindIter = m_cells.find(kEntry.cellKey);
+	auto &cell = kFindIter->second;
+	const SpatialHandle kMoved = cell.back();
+	cell[kEntry.cellSlot] = kMoved;
+	m_entries[kMoved].cellSlot = kEntry.cellSlot;
+	cell.pop_back();
+	if (cell.empty())
+		m_cells.erase(kFindIter);
+}
@@ -0,0 +1,108 @@
+/*=============================================================================*
+ * SpatialHashGrid.hpp - Uniform hash grid of actor bounding circles.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_SPATIALHASHGRID_HPP_
+#define _BGE_SPATIALHASHGRID_HPP_
+
+#include "Physics/SpatialTypes.hpp"
+
+#include <unordered_map>
+
+namespace BGE
+{
+	/**
+	 * SpatialHashGrid indexes bounding circles in 2D (top-down games use x/z) in an
+	 * unbounded grid of square cells, stored sparsely in a hash map. Each entry lives
+	 * in the cell holding its center, so moving within a cell only updates the
+	 * entry, and queries widen their search by the largest radius inserted.
+	 *
+	 * Works best with a cell size around the typical query radius and entries no
+	 * wider than a cell.
+	 */
+	class SpatialHashGrid : public INonCopyable
+	{
+		struct Entry
+		{
+			ActorID aID;
+			Math::Vec2f center{ 0.0f };
+			float radius;
+			std::uint64_t cellKey;
+			std::uint32_t cellSlot; // Index in the cell's entry list
+		};
+
+		float m_cellSize;
+		float m_invCellSize;
+		float m_maxRadius; // Largest radius ever inserted; never shrinks
+		std::vector<Entry> m_entries; // By handle; free ones have kINVALID_ACTOR_ID
+		std::vector<SpatialHandle> m_freeHandles;
+		std::unordered_map<std::uint64_t, std::vector<SpatialHandle>> m_cells;
+		std::size_t m_numEntries;
+	public:
+		explicit SpatialHashGrid(float cellSize);
+
+		SpatialHandle Insert(ActorID aID, const Math::Vec2f &center, float radius);
+		void Remove(SpatialHandle handle);
+		// Cheap when the entry stays in its cell, which is the common case.
+		void Move(SpatialHandle handle, const Math::Vec2f &center, float radius);
+		void Move(SpatialHandle handle, const Math::Vec2f &center) { Move(handle, center, m_entries[handle].radius); }
+		bool IsValid(SpatialHandle handle) const
+		{
+			return handle < m_entries.size() && m_entries[handle].aID != kINVALID_ACTOR_ID;
+		}
+		std::size_t GetSize(void) const noexcept { return m_numEntries; }
+		float GetCellSize(void) const noexcept { return m_cellSize; }
+
+		// Append the actors whose circles overlap the query circle to OUTACTORIDS.
+		void QueryCircle(const Math::Vec2f &center, float radius, std::vector<ActorID> &outActorIDs) const;
+		void QueryCircles(std::span<const Math::Vec2f> centers, float radius, SpatialBatchResult &outResult) const;
+		// Nearest circle hit by RAY; false if none within its maxDistance.
+		bool Raycast(const SpatialRay2D &ray, SpatialHit &outHit) const;
+		void Raycasts(std::span<const SpatialRay2D> rays, std::span<SpatialHit> outHits) const;
+		// The K nearest entries to POINT, closest first.
+		void QueryNearest(const Math::Vec2f &point, std::size_t k, std::vector<SpatialHit> &outHits) const;
+	private:
+		std::int32_t ToCell(float coord) const { return static_cast<std::int32_t>(std::floor(coord * m_invCellSize)); }
+		static std::uint64_t MakeKey(std::int32_t x, std::int32_t y)
+		{
+			return (std::uint64_t(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+		}
+		void Link(SpatialHandle handle);
+		void Unlink(SpatialHandle handle);
+		// Call FUNC(const Entry &) for every entry in cell (X, Y).
+		template <typename Func>
+		void ForEachInCell(std::int32_t x, std::int32_t y, Func &&func) const
+		{
+			const auto kFindIter = m_cells.find(MakeKey(x, y));
+			if (kFindIter == m_cells.end())
+				return;
+			for (const SpatialHandle kHandle : kFindIter->second)
+				func(m_entries[kHandle]);
+		}
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_SPATIALHASHGRID_HPP_ */
@@ -0,0 +1,69 @@
+/*=============================================================================*
+ * SpatialTypes.hpp - Types shared by the spatial indices.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_SPATIALTYPES_HPP_
+#define _BGE_SPATIALTYPES_HPP_
+
+namespace BGE
+{
+	// Stable reference to an entry in a spatial index.
+	using SpatialHandle = std::uint32_t;
+	inline constexpr SpatialHandle kINVALID_SPATIAL_HANDLE = 0xFFFFFFFF;
+
+	template <typename VecType>
+	struct SpatialRay
+	{
+		VecType origin;
+		VecType direction; // Normalized
+		float maxDistance;
+	};
+	using SpatialRay2D = SpatialRay<Math::Vec2f>;
+	using SpatialRay3D = SpatialRay<Math::Vec3f>;
+	// Result of a ray or nearest neighbour query. DISTANCE is to the entry's surface,
+	// 0 when inside it; AID is kINVALID_ACTOR_ID for a miss.
+	struct SpatialHit
+	{
+		ActorID aID = kINVALID_ACTOR_ID;
+		float distance = 0.0f;
+	};
+	// Results of a batch query: the matches of query I are
+	// actorIDs[offsets[I]] up to actorIDs[offsets[I + 1]].
+	struct SpatialBatchResult
+	{
+		std::vector<std::uint32_t> offsets;
+		std::vector<ActorID> actorIDs;
+
+		std::span<const ActorID> operator[](std::size_t index) const
+		{
+			return std::span<const ActorID>(actorIDs).subspan(offsets[index], offsets[index + 1] - offsets[index]);
+		}
+		std::size_t GetNumQueries(void) const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+		void Clear(void) { offsets.assign(1, 0); actorIDs.clear(); }
+	};
+} // End namespace (BGE)
+
+#endif /* !_BGE_SPATIALTYPES_HPP_ */
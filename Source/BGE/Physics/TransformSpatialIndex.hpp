@@ -0,0 +1,101 @@
+/*=============================================================================*
+ * TransformSpatialIndex.hpp - Spatial index kept in step with a TransformHierarchy.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_TRANSFORMSPATIALINDEX_HPP_
+#define _BGE_TRANSFORMSPATIALINDEX_HPP_
+
+#include "Actors/TransformHierarchy.hpp"
+#include "Physics/LooseOctree.hpp"
+#include "Physics/SpatialHashGrid.hpp"
+
+namespace BGE
+{
+	/**
+	 * TransformSpatialIndex places tracked transform nodes in a spatial index
+	 * (LooseOctree, or SpatialHashGrid using the x/z plane) at their world
+	 * translation. Sync() after TransformHierarchy::Update() moves only the nodes
+	 * that update recomputed, so the cost follows what moved, not what exists.
+	 */
+	template <typename IndexType>
+	class TransformSpatialIndex : public INonCopyable
+	{
+		const TransformHierarchy &m_transforms;
+		IndexType m_index;
+		std::vector<SpatialHandle> m_spatialHandles; // By TransformHandle
+	public:
+		template <typename... ArgTypes>
+		explicit TransformSpatialIndex(const TransformHierarchy &transforms, ArgTypes &&...args)
+			: m_transforms(transforms),
+			  m_index(std::forward<ArgTypes>(args)...)
+		{
+		}
+
+		// Track TRANSFORM as actor AID with a bounding RADIUS; tracking again updates both.
+		void Track(TransformHandle transform, ActorID aID, float radius)
+		{
+			if (transform >= m_spatialHandles.size())
+				m_spatialHandles.resize(transform + 1, kINVALID_SPATIAL_HANDLE);
+			if (m_spatialHandles[transform] != kINVALID_SPATIAL_HANDLE)
+				m_index.Remove(m_spatialHandles[transform]);
+			m_spatialHandles[transform] = m_index.Insert(aID, GetPosition(transform), radius);
+		}
+		void Untrack(TransformHandle transform)
+		{
+			if (!IsTracked(transform))
+				return;
+			m_index.Remove(m_spatialHandles[transform]);
+			m_spatialHandles[transform] = kINVALID_SPATIAL_HANDLE;
+		}
+		bool IsTracked(TransformHandle transform) const
+		{
+			return transform < m_spatialHandles.size() && m_spatialHandles[transform] != kINVALID_SPATIAL_HANDLE;
+		}
+		// Re-insert the tracked nodes moved by the last TransformHierarchy::Update().
+		void Sync(void)
+		{
+			for (const TransformHandle kTransform : m_transforms.GetUpdatedHandles())
+			{
+				if (IsTracked(kTransform))
+					m_index.Move(m_spatialHandles[kTransform], GetPosition(kTransform));
+			}
+		}
+		const IndexType &GetIndex(void) const noexcept { return m_index; }
+	private:
+		auto GetPosition(TransformHandle transform) const
+		{
+			const Math::Vec3f kPosition = m_transforms.GetWorld(transform).GetTranslation();
+			if constexpr (std::is_same_v<IndexType, SpatialHashGrid>)
+				return Math::Vec2f(kPosition.x, kPosition.z);
+			else
+				return kPosition;
+		}
+	};
+	using TransformOctree = TransformSpatialIndex<LooseOctree>;
+	using TransformGrid = TransformSpatialIndex<SpatialHashGrid>;
+} // End namespace (BGE)
+
+#endif /* !_BGE_TRANSFORMSPATIALINDEX_HPP_ */
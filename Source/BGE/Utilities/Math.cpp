@@ -27,3 +27,86 @@
  *============================================================================*/
 #include "Engine/EngineStd.hpp"
 #include "Math.hpp"
+
+// Compile-time checks that the Math types work in constant expressions.
+namespace
+{
+	using namespace BGE::Math;
+
+	template <FloatingPoint Type>
+	constexpr bool IsNear(Type lhs, Type rhs, Type tolerance = static_cast<Type>(1E-9))
+	{
+		return Abs(lhs - rhs) <= tolerance;
+	}
+	template <typename Matrix>
+	constexpr bool IsMatrixNear(const Matrix &lhs, const Matrix &rhs)
+	{
+		for (std::size_t index = 0; index < Matrix::kARRAY_LENGTH; ++index)
+		{
+			if (!IsNear(lhs.AsArray()[index], rhs.AsArray()[index]))
+				return false;
+		}
+		return true;
+	}
+
+	// Helpers
+	static_assert(Abs(-3) == 3 && Abs(2.5) == 2.5);
+	static_assert(Sqrt(16.0) == 4.0 && Sqrt(0.0f) == 0.0f && Sqrt(9) == 3.0);
+	static_assert(IsNear(Sqrt(2.0), std::numbers::sqrt2, 1E-15) && IsNear(Sqrt(1E-10), 1E-5, 1E-20));
+	static_assert(Sqrt(-1.0) != Sqrt(-1.0)); // NaN
+	static_assert(IsNear(Sin(kPI / 6), 0.5) && IsNear(Cos(kPI / 3), 0.5) && IsNear(Tan(kPI / 4), 1.0));
+	static_assert(IsNear(Sin(100.0), -0.50636564110975879)); // Past the range reduction
+	static_assert(Trunc(2.75) == 2.0 && Trunc(-2.75f) == -2.0f && Trunc(1E300) == 1E300);
+	static_assert(Sin(std::numeric_limits<double>::infinity()) != Sin(std::numeric_limits<double>::infinity())); // NaN
+	static_assert(Abs(Sin(1E30)) <= 1.0); // Too large for an integer cast
+
+	// Vectors
+	static_assert(Vec3f(1.0f, 2.0f, 3.0f) + Vec3f(1.0f) == Vec3f(2.0f, 3.0f, 4.0f));
+	static_assert(Vec3i(1, 0, 0).Cross(Vec3i(0, 1, 0)) == Vec3i(0, 0, 1));
+	static_assert(Vec3f(3.0f, 0.0f, 4.0f).Magnitude() == 5.0f && Vec2i(3, -4).Magnitude() == 5);
+	static_assert(Vec2d(3.0, 4.0).Distance(Vec2d(0.0)) == 5.0);
+	static_assert(IsNear(Vec3d(1.0, 2.0, 2.0).Normalized().x, 1.0 / 3.0));
+	static_assert(Vec3d(0.0).Normalized() == Vec3d(0.0)); // Zero vectors are left alone
+	static_assert(Vec4f(Vec3f(1.0f, 2.0f, 3.0f), 4.0f) - Vec4f(1.0f) == Vec4f(0.0f, 1.0f, 2.0f, 3.0f));
+	static_assert(Vec4d(1.0, 1.0, 1.0, 1.0).Magnitude() == 2.0 && Vec4i(1, 2, 3, 4).Summation() == 10);
+	static_assert(Vec4i(1, 0, 0, 0).IsOrthogonal(Vec4i(0, 0, 0, 1)) && Vec4i(-1, 2, -3, 4).Product() == 24);
+	static_assert([] { Vec4i vec(1, -2, 3, -4); vec++; vec.AbsoluteValue(); return vec; }() == Vec4i(2, 1, 4, 3));
+
+	// Quaternions, a quarter turn about +Y maps +X onto -Z
+	constexpr Quatd kQUARTER_TURN_Y(0.0, Sin(kPI / 4), 0.0, Cos(kPI / 4));
+	static_assert(IsNear(kQUARTER_TURN_Y.Magnitude(), 1.0));
+	static_assert(IsNear((kQUARTER_TURN_Y * kQUARTER_TURN_Y).y, 1.0)); // Half turn
+	static_assert(IsNear(Mat4x4d::Rotation(kQUARTER_TURN_Y).TransformPoint(Vec3d(1.0, 0.0, 0.0)).z, -1.0));
+	static_assert(IsNear((kQUARTER_TURN_Y * [] { auto inverse = kQUARTER_TURN_Y; inverse.Inverse(); return inverse; }()).w, 1.0));
+	static_assert(Quatd(1.0, 0.0, 0.0, 5.0).Cross(Quatd(0.0, 1.0, 0.0, 7.0)) == Quatd(0.0, 0.0, 1.0, 0.0));
+	static_assert(Quatd(1.0, 0.0, 0.0, 0.0).Distance(Quatd(0.0, 0.0, 0.0, 0.0)) == 1.0);
+	static_assert(Quatd(1.0, 2.0, 3.0, 4.0).Summation() == 10.0 && Quatd(1.0, 2.0, 3.0, 4.0).Product(1.0) == 25.0);
+	static_assert(Quatd(1.0, 0.0, 0.0, 0.0).IsOrthogonal(Quatd()) && !Quatd().IsOrthogonal(Quatd()));
+	static_assert([]
+	{
+		Quatd quat(-1.0, 2.0, -3.0, 4.0);
+		++quat;
+		quat--;
+		quat.AbsoluteValue();
+		quat.Scale(2.0);
+		quat.Translate(Quatd(1.0, 1.0, 1.0, 1.0));
+		return quat;
+	}() == Quatd(3.0, 5.0, 7.0, 9.0));
+	static_assert([] { Quatd quat(1.0, 2.0, 3.0, 4.0); quat.Scale(Quatd(2.0, 2.0, 2.0, 2.0)); return quat; }() == Quatd(2.0, 4.0, 6.0, 8.0));
+
+	// Matrices
+	constexpr auto kTRS = Mat4x4d::FromTRS(Vec3d(1.0, 2.0, 3.0), kQUARTER_TURN_Y, Vec3d(2.0));
+	static_assert(kTRS.IsAffine() && IsMatrixNear(kTRS * *kTRS.Inverse(), Mat4x4d()));
+	static_assert(IsMatrixNear(kTRS.Transposed().Transposed(), kTRS));
+	static_assert(Mat4x4f::Translation(Vec3f(1.0f)) * Mat4x4f::Translation(Vec3f(2.0f)) == Mat4x4f::Translation(Vec3f(3.0f)));
+	constexpr auto kPROJECTION = Mat4x4d::Perspective(kPI / 2, 2.0, 1.0, 10.0);
+	static_assert(IsNear(kPROJECTION(0, 0), 0.5) && !kPROJECTION.IsAffine());
+	static_assert(IsMatrixNear(kPROJECTION * *kPROJECTION.Inverse(), Mat4x4d()));
+	constexpr auto kVIEW = Mat4x4d::LookAt(Vec3d(1.0, 2.0, 3.0), Vec3d(1.0, 2.0, 0.0), Vec3d(0.0, 1.0, 0.0));
+	static_assert(IsMatrixNear(kVIEW, Mat4x4d::Translation(Vec3d(-1.0, -2.0, -3.0)))); // Already looking down -Z
+	static_assert(IsMatrixNear(Mat3x3d::Scale(Vec3d(2.0)) * *Mat3x3d::Scale(Vec3d(2.0)).Inverse(), Mat3x3d()));
+	// Uniform uploads pass the element array straight to glUniformMatrix*fv
+	static_assert(sizeof(Mat2x2f) == 4 * sizeof(float) && sizeof(Mat3x3f) == 9 * sizeof(float));
+	static_assert(!Mat2x2d::Scale(Vec2d(1.0, 0.0)).Inverse().has_value());
+	static_assert(IsNear((Mat2x2d::Rotation(kPI / 2) * Vec2d(1.0, 0.0)).y, 1.0));
+} // End anonymous namespace
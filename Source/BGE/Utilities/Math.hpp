@@ -28,6 +28,13 @@
 #ifndef _BGE_MATH_HPP_
 #define _BGE_MATH_HPP_
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define BGE_MATH_SSE 1
+#else
+#define BGE_MATH_SSE 0
+#endif
+
 namespace BGE::Math
 {
 	// Concept for use with integral types.
@@ -95,6 +102,85 @@ namespace BGE::Math
 	using Mat4x4f = Mat4x4<float>;
 	using Mat4x4d = Mat4x4<double>;
 	// Free functions:
+	// Usable in constant expressions. At runtime they forward to <cmath>, during constant
+	// evaluation they fall back to iterative approximations accurate to about an ulp.
+
+	template <Numeric Type>
+	constexpr Type Abs(Type value) { return (value < 0) ? -value : value; }
+	template <FloatingPoint Type>
+	constexpr Type Trunc(Type value)
+	{
+		if (!std::is_constant_evaluated())
+			return std::trunc(value);
+		// From 2^(digits - 1) up every value is integral, as are infinity and NaN
+		constexpr Type kINTEGRAL_LIMIT = static_cast<Type>(1ull << (std::numeric_limits<Type>::digits - 1));
+		const Type kMagnitude = Abs(value);
+		if (!(kMagnitude < kINTEGRAL_LIMIT))
+			return value;
+		// Adding the limit rounds away the fraction; step back if it rounded up
+		Type truncated = (kMagnitude + kINTEGRAL_LIMIT) - kINTEGRAL_LIMIT;
+		if (truncated > kMagnitude)
+			truncated -= 1;
+		return (value < 0) ? -truncated : truncated;
+	}
+	template <FloatingPoint Type>
+	constexpr Type Sqrt(Type value)
+	{
+		if (!std::is_constant_evaluated())
+			return std::sqrt(value);
+		if (!(value > 0) || value == std::numeric_limits<Type>::infinity())
+			return (value == 0 || value > 0) ? value : std::numeric_limits<Type>::quiet_NaN();
+		// Newton-Raphson from above the root decreases until it stops improving
+		Type estimate = (value > 1) ? value : static_cast<Type>(1);
+		while (true)
+		{
+			const Type kNext = (estimate + value / estimate) / 2;
+			if (!(kNext < estimate))
+				return estimate;
+			estimate = kNext;
+		}
+	}
+	template <Integral Type>
+	constexpr double Sqrt(Type value) { return Sqrt(static_cast<double>(value)); }
+	template <FloatingPoint Type>
+	constexpr Type Sin(Type radians)
+	{
+		if (!std::is_constant_evaluated())
+			return std::sin(radians);
+		// The series below never converges for infinity or NaN
+		if (!(Abs(radians) <= std::numeric_limits<Type>::max()))
+			return std::numeric_limits<Type>::quiet_NaN();
+		// Reduce to [-pi, pi], then sum the Taylor series until the terms vanish
+		constexpr Type kTWO_PI = static_cast<Type>(2 * kPI);
+		// Huge inputs leave a rounding error of a few ulps, so repeat until it is in range
+		while (Abs(radians) > kTWO_PI)
+			radians -= kTWO_PI * Trunc(radians / kTWO_PI);
+		if (radians > static_cast<Type>(kPI))
+			radians -= kTWO_PI;
+		else if (radians < static_cast<Type>(-kPI))
+			radians += kTWO_PI;
+		Type term = radians, sum = 0;
+		for (int index = 1; sum + term != sum; ++index)
+		{
+			sum += term;
+			term *= -(radians * radians) / static_cast<Type>((2 * index) * (2 * index + 1));
+		}
+		return sum;
+	}
+	template <FloatingPoint Type>
+	constexpr Type Cos(Type radians)
+	{
+		if (!std::is_constant_evaluated())
+			return std::cos(radians);
+		return Sin(radians + static_cast<Type>(kPI / 2));
+	}
+	template <FloatingPoint Type>
+	constexpr Type Tan(Type radians)
+	{
+		if (!std::is_constant_evaluated())
+			return std::tan(radians);
+		return Sin(radians) / Cos(radians);
+	}
 
 	/**
 	 * Vec2 class represents a two component vector. 
@@ -121,34 +207,34 @@ namespace BGE::Math
 	public:
 		// TODO: See if spaceship operator default generation is semantically correct.
 		auto operator<=>(const Vec2<Type> &) const = default;
-		Vec2<Type> operator+(void) const { return Vec2<Type>(+x, +y); } // Unary plus
-		Vec2<Type> operator+(const Vec2<Type> &rhs) const { return Vec2<Type>(x + rhs.x, y + rhs.y); } // Binary plus
-		Vec2<Type> operator+=(const Vec2<Type> &rhs) // Addition assignment
+		constexpr Vec2<Type> operator+(void) const { return Vec2<Type>(+x, +y); } // Unary plus
+		constexpr Vec2<Type> operator+(const Vec2<Type> &rhs) const { return Vec2<Type>(x + rhs.x, y + rhs.y); } // Binary plus
+		constexpr Vec2<Type> operator+=(const Vec2<Type> &rhs) // Addition assignment
 		{
 			x += rhs.x; y += rhs.y;
 			return Vec2<Type>(*this);
 		}
-		Vec2<Type> operator-(void) const { return Vec2<Type>(-x, -y); } // Unary minus (negation)
-		Vec2<Type> operator-(const Vec2<Type> &rhs) const { return Vec2<Type>(x - rhs.x, y - rhs.y); } // Binary minus
-		Vec2<Type> operator-=(const Vec2<Type> &rhs) // Subtraction assignment
+		constexpr Vec2<Type> operator-(void) const { return Vec2<Type>(-x, -y); } // Unary minus (negation)
+		constexpr Vec2<Type> operator-(const Vec2<Type> &rhs) const { return Vec2<Type>(x - rhs.x, y - rhs.y); } // Binary minus
+		constexpr Vec2<Type> operator-=(const Vec2<Type> &rhs) // Subtraction assignment
 		{
 			x -= rhs.x; y -= rhs.y;
 			return Vec2<Type>(*this);
 		}
-		Vec2<Type> operator*(const Vec2<Type> &rhs) const { return Vec2<Type>(x * rhs.x, y * rhs.y); } // Binary multiplication
-		Vec2<Type> operator*(Type scalar) const { return Vec2<Type>(x * scalar, y * scalar); } // Binary multiplication (scalar)
-		Vec2<Type> operator*=(const Vec2<Type> &rhs) // Multiplication assignment
+		constexpr Vec2<Type> operator*(const Vec2<Type> &rhs) const { return Vec2<Type>(x * rhs.x, y * rhs.y); } // Binary multiplication
+		constexpr Vec2<Type> operator*(Type scalar) const { return Vec2<Type>(x * scalar, y * scalar); } // Binary multiplication (scalar)
+		constexpr Vec2<Type> operator*=(const Vec2<Type> &rhs) // Multiplication assignment
 		{
 			x *= rhs.x; y *= rhs.y;
 			return Vec2<Type>(*this);
 		}
-		Vec2<Type> operator*=(Type scalar) // Multiplication assignment (scalar)
+		constexpr Vec2<Type> operator*=(Type scalar) // Multiplication assignment (scalar)
 		{
 			x *= scalar; y *= scalar;
 			return Vec2<Type>(*this);
 		}
 		// Division by another vector is not useful in math, scalar division is however.
-		Vec2<Type> operator/(Type scalar) const // Binary division (scalar)
+		constexpr Vec2<Type> operator/(Type scalar) const // Binary division (scalar)
 		{
 			Type newX = x, newY = y;
 			if (scalar != 0)
@@ -158,7 +244,7 @@ namespace BGE::Math
 			}
 			return Vec2<Type>(newX, newY);
 		}
-		Vec2<Type> operator/=(Type scalar) // Division assignment (scalar)
+		constexpr Vec2<Type> operator/=(Type scalar) // Division assignment (scalar)
 		{
 			if (scalar != 0)
 			{
@@ -170,31 +256,31 @@ namespace BGE::Math
 		// Remainder division doesn't really have any use.
 		//Vec2<Type> operator%(Type scalar) const; // Binary modulus (scalar)
 		//Vec2<Type> operator%=(Type scalar); // Modulus assignment (scalar)
-		Vec2<Type> &operator++(void) // Prefix addition
+		constexpr Vec2<Type> &operator++(void) // Prefix addition
 		{
 			x++; y++;
 			return *this;
 		}
-		Vec2<Type> &operator--(void) // Prefix subtraction
+		constexpr Vec2<Type> &operator--(void) // Prefix subtraction
 		{
 			x--; y--;
 			return *this;
 		}
-		Vec2<Type> operator++(int) const // Postfix addition (beware of copy!)
+		constexpr Vec2<Type> operator++(int) // Postfix addition (beware of copy!)
 		{
 			auto copyOfThis(*this);
 			operator++(); // Call the prefix increment operator
 			return copyOfThis;
 		}
-		Vec2<Type> operator--(int) const // Postfix subtraction (beware of copy!)
+		constexpr Vec2<Type> operator--(int) // Postfix subtraction (beware of copy!)
 		{
 			auto copyOfThis(*this);
 			operator--();
 			return copyOfThis;
 		}
 		// "Pseudo-cross product" or "cross product magnitude" magnitude of the cross product between the vectors
-		Type PsuedoCross(const Vec2<Type> &vec) const { return std::abs<Type>((x * vec.y) - (y * vec.x)); }
-		void Normalize(void) // Normalize vector by magnitude
+		constexpr Type PsuedoCross(const Vec2<Type> &vec) const { return Abs((x * vec.y) - (y * vec.x)); }
+		constexpr void Normalize(void) // Normalize vector by magnitude
 		{
 			const Type kMagnitude = Magnitude();
 			if (kMagnitude > 0)
@@ -203,36 +289,36 @@ namespace BGE::Math
 				y /= kMagnitude;
 			}
 		}
-		Vec2<Type> Normalized(void) const // Normalize vector by magnitude
+		constexpr Vec2<Type> Normalized(void) const // Normalize vector by magnitude
 		{
 			auto copyOfThis(*this);
 			copyOfThis.Normalize();
 			return copyOfThis;
 		}
-		Type Magnitude(void) const { return std::abs<Type>(std::sqrt<Type>((x * x) + (y * y))); } // Vector magnitude/length
-		void Inverse(void) { -(*this); } // Negate this
-		void Translate(const Vec2<Type> &vec) { (*this) = (*this) + vec; } // Add vec to this
-		void Scale(const Vec2<Type> &vec) { (*this) = (*this) * vec; } // Multiply this by vec
-		void Scale(Type scalar) { (*this) = (*this) * scalar; } // Multiply this by scalar
-		Type Distance(const Vec2<Type> &vec) const // Get the distance between this and vec
+		constexpr Type Magnitude(void) const { return static_cast<Type>(Sqrt((x * x) + (y * y))); } // Vector magnitude/length
+		constexpr void Inverse(void) { (*this) = -(*this); } // Negate this
+		constexpr void Translate(const Vec2<Type> &vec) { (*this) = (*this) + vec; } // Add vec to this
+		constexpr void Scale(const Vec2<Type> &vec) { (*this) = (*this) * vec; } // Multiply this by vec
+		constexpr void Scale(Type scalar) { (*this) = (*this) * scalar; } // Multiply this by scalar
+		constexpr Type Distance(const Vec2<Type> &vec) const // Get the distance between this and vec
 		{
 			const Type kDX = vec.x - x;
 			const Type kDY = vec.y - y;
-			return Vec2<Type>(kDX, kDY);
+			return static_cast<Type>(Sqrt((kDX * kDX) + (kDY * kDY)));
 		}
 		// Modify all elements in the vector to be absolute values
-		void AbsoluteValue(void) { x = std::abs<Type>(x); y = std::abs<Type>(y); }
+		constexpr void AbsoluteValue(void) { x = Abs(x); y = Abs(y); }
 		// Get the sum of all elements in the vector
-		Type Summation(Type startValue = 0) const { return (startValue + (x + y)); }
+		constexpr Type Summation(Type startValue = 0) const { return (startValue + (x + y)); }
 		// Get the product of all elements in the vector
-		Type Product(Type startValue = 0) const { return (startValue + (x * y)); }
-		Type Dot(const Vec2<Type> &vec) const { return ((x * vec.x) + (y * vec.y)); } // Dot product		
-		bool IsOrthogonal(const Vec2<Type> &vec) const // Check if this is orthogonal to vec
+		constexpr Type Product(Type startValue = 0) const { return (startValue + (x * y)); }
+		constexpr Type Dot(const Vec2<Type> &vec) const { return ((x * vec.x) + (y * vec.y)); } // Dot product
+		constexpr bool IsOrthogonal(const Vec2<Type> &vec) const // Check if this is orthogonal to vec
 		{
 			// The condition checks if the dot product is 0 using a floating - point tolerance value.
-			return std::abs(Dot(vec)) < 1E-6;
+			return Abs(Dot(vec)) < 1E-6;
 		}
-		TypeArray AsArray(void) const { return { x, y }; } // Convert to std::array type
+		constexpr TypeArray AsArray(void) const { return { x, y }; } // Convert to std::array type
 	};
 	
 	template <Numeric Type>
@@ -256,44 +342,44 @@ namespace BGE::Math
 	public:
 		// TODO: See if spaceship operator default generation is semantically correct.
 		auto operator<=>(const Vec3<Type> &) const = default;
-		Vec3<Type> operator+(void) const { return Vec3<Type>(+x, +y, +z); } // Unary plus
-		Vec3<Type> operator+(const Vec3<Type> &rhs) const { return Vec3<Type>(x + rhs.x, y + rhs.y, z + rhs.z); } // Binary plus
-		Vec3<Type> operator+=(const Vec3<Type> &rhs) // Addition assignment
+		constexpr Vec3<Type> operator+(void) const { return Vec3<Type>(+x, +y, +z); } // Unary plus
+		constexpr Vec3<Type> operator+(const Vec3<Type> &rhs) const { return Vec3<Type>(x + rhs.x, y + rhs.y, z + rhs.z); } // Binary plus
+		constexpr Vec3<Type> operator+=(const Vec3<Type> &rhs) // Addition assignment
 		{
 			x += rhs.x;
 			y += rhs.y;
 			z += rhs.z;
 			return *this;
 		}
-		Vec3<Type> operator-(void) const { return Vec3<Type>(-x, -y, -z); } // Unary minus (negation)
-		Vec3<Type> operator-(const Vec3<Type> &rhs) const { return Vec3<Type>(x - rhs.x, y - rhs.y, z - rhs.z); } // Binary minus
-		Vec3<Type> operator-=(const Vec3<Type> &rhs) // Subtraction assignment
+		constexpr Vec3<Type> operator-(void) const { return Vec3<Type>(-x, -y, -z); } // Unary minus (negation)
+		constexpr Vec3<Type> operator-(const Vec3<Type> &rhs) const { return Vec3<Type>(x - rhs.x, y - rhs.y, z - rhs.z); } // Binary minus
+		constexpr Vec3<Type> operator-=(const Vec3<Type> &rhs) // Subtraction assignment
 		{
 			x -= rhs.x;
 			y -= rhs.y;
 			z -= rhs.z;
 			return *this;
 		}
-		Vec3<Type> operator*(const Vec3<Type> &rhs) const // Binary multiplication
+		constexpr Vec3<Type> operator*(const Vec3<Type> &rhs) const // Binary multiplication
 		{
 			return Vec3<Type>(x * rhs.x, y * rhs.y, z * rhs.z);
 		}
-		Vec3<Type> operator*(Type scalar) const // Binary multiplication (scalar)
+		constexpr Vec3<Type> operator*(Type scalar) const // Binary multiplication (scalar)
 		{
 			return Vec3<Type>(x * scalar, y * scalar, z * scalar);
 		}
-		Vec3<Type> operator*=(const Vec3<Type> &rhs) // Multiplication assignment
+		constexpr Vec3<Type> operator*=(const Vec3<Type> &rhs) // Multiplication assignment
 		{
 			x *= rhs.x; y *= rhs.y; z *= rhs.z;
 			return *this;
 		}
-		Vec3<Type> operator*=(Type scalar) // Multiplication assignment (scalar)
+		constexpr Vec3<Type> operator*=(Type scalar) // Multiplication assignment (scalar)
 		{
 			x *= scalar; y *= scalar; z *= scalar;
 			return *this;
 		}
 		// Division by another vector is not useful in math, scalar division is however.
-		Vec3<Type> operator/(Type scalar) const // Binary division (scalar)
+		constexpr Vec3<Type> operator/(Type scalar) const // Binary division (scalar)
 		{
 			Type newX = x, newY = y, newZ = z;
 			if (scalar != 0)
@@ -304,7 +390,7 @@ namespace BGE::Math
 			}
 			return Vec3<Type>(newX, newY, newZ);
 		}
-		Vec3<Type> operator/=(Type scalar) // Division assignment (scalar)
+		constexpr Vec3<Type> operator/=(Type scalar) // Division assignment (scalar)
 		{
 			if (scalar != 0)
 			{
@@ -317,34 +403,34 @@ namespace BGE::Math
 		// Remainder division doesn't really have any use.
 		//Vec3<Type> operator%(Type scalar) const; // Binary modulus (scalar)
 		//Vec3Type> operator%=(Type scalar); // Modulus assignment (scalar)
-		Vec3<Type> &operator++(void) // Prefix addition
+		constexpr Vec3<Type> &operator++(void) // Prefix addition
 		{
 			x++; y++; z++;
 			return *this;
 		}
-		Vec3<Type> &operator--(void) // Prefix subtraction
+		constexpr Vec3<Type> &operator--(void) // Prefix subtraction
 		{
 			x--; y--; z--;
 			return *this;
 		}
-		Vec3<Type> operator++(int) const // Postfix addition (beware of copy!)
+		constexpr Vec3<Type> operator++(int) // Postfix addition (beware of copy!)
 		{
 			auto copyOfThis(*this);
 			operator++(); // Call the prefix increment operator
 			return copyOfThis;
 		}
-		Vec3<Type> operator--(int) const // Postfix subtraction (beware of copy!)
+		constexpr Vec3<Type> operator--(int) // Postfix subtraction (beware of copy!)
 		{
 			auto copyOfThis(*this);
 			operator--();
 			return copyOfThis;
 		}
 		// "Pseudo-cross product" or "cross product magnitude" magnitude of the cross product between the vectors
-		Vec3<Type> Cross(const Vec3<Type> &vec) const // Cross multiply this by vec
+		constexpr Vec3<Type> Cross(const Vec3<Type> &vec) const // Cross multiply this by vec
 		{
 			return Vec3<Type>((y * vec.z) - (z * vec.y), (z * vec.x) - (x * vec.z), (x * vec.y) - (y * vec.x));
 		}
-		void Normalize(void) // Normalize vector by magnitude
+		constexpr void Normalize(void) // Normalize vector by magnitude
 		{
 			const Type kMagnitude = Magnitude();
 			if (kMagnitude != 0)
@@ -354,54 +440,150 @@ namespace BGE::Math
 				z /= kMagnitude;
 			}
 		}
-		Vec3<Type> Normalized(void) const // Normalize vector by magnitude
+		constexpr Vec3<Type> Normalized(void) const // Normalize vector by magnitude
 		{
 			auto copyOfThis(*this);
 			copyOfThis.Normalize();
 			return copyOfThis;
 		}
-		Type Magnitude(void) const { return std::sqrt((x * x) + (y * y) + (z * z)); } // Vector magnitude/length
-		void Inverse(void) { (*this) = -(*this); } // Negate this
-		void Translate(const Vec3<Type> &vec) { (*this) = (*this) + vec; } // Add vec to this
-		void Scale(const Vec3<Type> &vec) { (*this) = (*this) * vec; } // Multiply this by vec
-		void Scale(Type scalar) { (*this) = (*this) * scalar; } // Multiply this by scalar
-		Type Distance(const Vec3<Type> &vec) const // Get the distance between this and vec
+		constexpr Type Magnitude(void) const { return static_cast<Type>(Sqrt((x * x) + (y * y) + (z * z))); } // Vector magnitude/length
+		constexpr void Inverse(void) { (*this) = -(*this); } // Negate this
+		constexpr void Translate(const Vec3<Type> &vec) { (*this) = (*this) + vec; } // Add vec to this
+		constexpr void Scale(const Vec3<Type> &vec) { (*this) = (*this) * vec; } // Multiply this by vec
+		constexpr void Scale(Type scalar) { (*this) = (*this) * scalar; } // Multiply this by scalar
+		constexpr Type Distance(const Vec3<Type> &vec) const // Get the distance between this and vec
 		{
 			const Type kDX = x - vec.x;
 			const Type kDY = y - vec.y;
 			const Type kDZ = z - vec.z;
-			return std::sqrt<Type>((kDX * kDX) + (kDY * kDY) + (kDZ * kDZ));
+			return static_cast<Type>(Sqrt((kDX * kDX) + (kDY * kDY) + (kDZ * kDZ)));
 		}
-		void AbsoluteValue(void) // Modify all elements in the vector to be absolute values
+		constexpr void AbsoluteValue(void) // Modify all elements in the vector to be absolute values
 		{
-			x = std::abs<Type>(x);
-			y = std::abs<Type>(y);
-			z = std::abs<Type>(z);
+			x = Abs(x);
+			y = Abs(y);
+			z = Abs(z);
 		}
-		Type Summation(Type startValue = 0) const // Get the sum of all elements in the vector
+		constexpr Type Summation(Type startValue = 0) const // Get the sum of all elements in the vector
 		{
 			return (startValue + (x + y + z));
 		}
-		Type Product(Type startValue = 0) const // Get the product of all elements in the vector
+		constexpr Type Product(Type startValue = 0) const // Get the product of all elements in the vector
 		{
 			return Type(startValue + (x * y * z));
 		}
-		Type Dot(const Vec3<Type> &vec) const // Dot product
+		constexpr Type Dot(const Vec3<Type> &vec) const // Dot product
 		{
 			return ((x * vec.x) + (y * vec.y) + (z * vec.z));
 		}
-		bool IsOrthogonal(const Vec3<Type> &vec) const // Check if this is orthogonal to vec
+		constexpr bool IsOrthogonal(const Vec3<Type> &vec) const // Check if this is orthogonal to vec
 		{
-			return std::abs(Dot(vec)) < 1E-6;
+			return Abs(Dot(vec)) < 1E-6;
 		}
-		TypeArray AsArray(void) const { return { x, y, z }; } // Convert to std::array type
+		constexpr TypeArray AsArray(void) const { return { x, y, z }; } // Convert to std::array type
 	};
 	
 	template <Numeric Type>
 	class Vec4
 	{
 	public:
+		static constexpr std::size_t kARRAY_LENGTH = 4;
+		using ValueType = Type;
+		using TypeArray = std::array<Type, kARRAY_LENGTH>;
+
 		Type x, y, z, w;
+	public:
+		constexpr Vec4(Type _x, Type _y, Type _z, Type _w) : x(_x), y(_y), z(_z), w(_w) { }
+		constexpr Vec4(Type singular) : x(singular), y(singular), z(singular), w(singular) { } // Initialize all to same value
+		constexpr Vec4(const Vec3<Type> &xyz, Type _w) : x(xyz.x), y(xyz.y), z(xyz.z), w(_w) { }
+		// Use array for initial values
+		constexpr Vec4(const Type (&array)[4]) : x(array[0]), y(array[1]), z(array[2]), w(array[3]) { }
+		Vec4(const Vec4<Type> &) = default;
+		Vec4 &operator=(const Vec4<Type> &) = default;
+		Vec4(Vec4<Type> &&) noexcept = default;
+		Vec4 &operator=(Vec4<Type> &&) noexcept = default;
+	public:
+		// TODO: See if spaceship operator default generation is semantically correct.
+		auto operator<=>(const Vec4<Type> &) const = default;
+		constexpr Vec4<Type> operator+(void) const { return Vec4<Type>(+x, +y, +z, +w); } // Unary plus
+		constexpr Vec4<Type> operator+(const Vec4<Type> &rhs) const // Binary plus
+		{
+			return Vec4<Type>(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
+		}
+		constexpr Vec4<Type> operator+=(const Vec4<Type> &rhs) // Addition assignment
+		{
+			x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w;
+			return *this;
+		}
+		constexpr Vec4<Type> operator-(void) const { return Vec4<Type>(-x, -y, -z, -w); } // Unary minus (negation)
+		constexpr Vec4<Type> operator-(const Vec4<Type> &rhs) const // Binary minus
+		{
+			return Vec4<Type>(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
+		}
+		constexpr Vec4<Type> operator-=(const Vec4<Type> &rhs) // Subtraction assignment
+		{
+			x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w;
+			return *this;
+		}
+		constexpr Vec4<Type> operator*(const Vec4<Type> &rhs) const // Binary multiplication
+		{
+			return Vec4<Type>(x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w);
+		}
+		constexpr Vec4<Type> operator*(Type scalar) const // Binary multiplication (scalar)
+		{
+			return Vec4<Type>(x * scalar, y * scalar, z * scalar, w * scalar);
+		}
+		constexpr Vec4<Type> operator*=(const Vec4<Type> &rhs) { return *this = *this * rhs; } // Multiplication assignment
+		constexpr Vec4<Type> operator*=(Type scalar) { return *this = *this * scalar; } // Multiplication assignment (scalar)
+		// Division by another vector is not useful in math, scalar division is however.
+		constexpr Vec4<Type> operator/(Type scalar) const // Binary division (scalar)
+		{
+			return (scalar != 0) ? Vec4<Type>(x / scalar, y / scalar, z / scalar, w / scalar) : *this;
+		}
+		constexpr Vec4<Type> operator/=(Type scalar) { return *this = *this / scalar; } // Division assignment (scalar)
+		constexpr Vec4<Type> &operator++(void) // Prefix addition
+		{
+			x++; y++; z++; w++;
+			return *this;
+		}
+		constexpr Vec4<Type> &operator--(void) // Prefix subtraction
+		{
+			x--; y--; z--; w--;
+			return *this;
+		}
+		constexpr Vec4<Type> operator++(int) // Postfix addition (beware of copy!)
+		{
+			auto copyOfThis(*this);
+			operator++();
+			return copyOfThis;
+		}
+		constexpr Vec4<Type> operator--(int) // Postfix subtraction (beware of copy!)
+		{
+			auto copyOfThis(*this);
+			operator--();
+			return copyOfThis;
+		}
+		constexpr void Normalize(void) { *this = Normalized(); } // Normalize vector by magnitude
+		constexpr Vec4<Type> Normalized(void) const { return *this / Magnitude(); } // Normalize vector by magnitude
+		constexpr Type Magnitude(void) const { return static_cast<Type>(Sqrt(Dot(*this))); } // Vector magnitude/length
+		constexpr void Inverse(void) { (*this) = -(*this); } // Negate this
+		constexpr void Translate(const Vec4<Type> &vec) { (*this) = (*this) + vec; } // Add vec to this
+		constexpr void Scale(const Vec4<Type> &vec) { (*this) = (*this) * vec; } // Multiply this by vec
+		constexpr void Scale(Type scalar) { (*this) = (*this) * scalar; } // Multiply this by scalar
+		constexpr Type Distance(const Vec4<Type> &vec) const { return (*this - vec).Magnitude(); } // Get the distance between this and vec
+		constexpr void AbsoluteValue(void) // Modify all elements in the vector to be absolute values
+		{
+			x = Abs(x); y = Abs(y); z = Abs(z); w = Abs(w);
+		}
+		constexpr Type Summation(Type startValue = 0) const { return (startValue + (x + y + z + w)); } // Get the sum of all elements
+		constexpr Type Product(Type startValue = 0) const { return (startValue + (x * y * z * w)); } // Get the product of all elements
+		constexpr Type Dot(const Vec4<Type> &vec) const // Dot product
+		{
+			return ((x * vec.x) + (y * vec.y) + (z * vec.z) + (w * vec.w));
+		}
+		constexpr bool IsOrthogonal(const Vec4<Type> &vec) const { return Abs(Dot(vec)) < 1E-6; } // Check if this is orthogonal to vec
+		constexpr Vec3<Type> GetXYZ(void) const { return Vec3<Type>(x, y, z); }
+		constexpr TypeArray AsArray(void) const { return { x, y, z, w }; } // Convert to std::array type
 	};
 	
 	template <Numeric Type>
@@ -426,27 +608,27 @@ namespace BGE::Math
 	public:
 		// TODO: See if spaceship operator default generation is semantically correct.
 		auto operator<=>(const Quat<Type>&) const = default;
-		Quat<Type> operator+(void) const { return Quat<Type>(+x, +y, +z, +w); } // Unary plus
-		Quat<Type> operator+(const Quat<Type>& rhs) const // Binary plus
+		constexpr Quat<Type> operator+(void) const { return Quat<Type>(+x, +y, +z, +w); } // Unary plus
+		constexpr Quat<Type> operator+(const Quat<Type>& rhs) const // Binary plus
 		{
 			return Quat<Type>(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
 		}
-		Quat<Type> operator+=(const Quat<Type> &rhs) // Addition assignment
+		constexpr Quat<Type> operator+=(const Quat<Type> &rhs) // Addition assignment
 		{
 			x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w;
 			return *this;
 		}
-		Quat<Type> operator-(void) const { return Quat<Type>(-x, -y, -z, -w); } // Unary minus (negation)
-		Quat<Type> operator-(const Quat<Type> &rhs) const // Binary minus
+		constexpr Quat<Type> operator-(void) const { return Quat<Type>(-x, -y, -z, -w); } // Unary minus (negation)
+		constexpr Quat<Type> operator-(const Quat<Type> &rhs) const // Binary minus
 		{
 			return Quat<Type>(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
 		}
-		Quat<Type> operator-=(const Quat<Type> &rhs) // Subtraction assignment
+		constexpr Quat<Type> operator-=(const Quat<Type> &rhs) // Subtraction assignment
 		{
 			x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w;
 			return *this;
 		}
-		Quat<Type> operator*(const Quat<Type> &rhs) const // Binary multiplication
+		constexpr Quat<Type> operator*(const Quat<Type> &rhs) const // Binary multiplication
 		{
 			const Type kX = (w * rhs.x) + (x * rhs.w) + (y * rhs.z) - (z * rhs.y);
 			const Type kY = (w * rhs.y) - (x * rhs.z) + (y * rhs.w) + (z * rhs.x);
@@ -454,84 +636,535 @@ namespace BGE::Math
 			const Type kW = (w * rhs.w) - (x * rhs.x) - (y * rhs.y) - (z * rhs.z);
 			return Quat<Type>(kX, kY, kZ, kW);
 		}
-		Quat<Type> operator*(Type scalar) const; // Binary multiplication (scalar)
-		Quat<Type> operator*=(const Quat<Type>& rhs); // Multiplication assignment
-		Quat<Type> operator*=(Type scalar); // Multiplication assignment (scalar)
+		constexpr Quat<Type> operator*(Type scalar) const // Binary multiplication (scalar)
+		{
+			return Quat<Type>(x * scalar, y * scalar, z * scalar, w * scalar);
+		}
+		constexpr Quat<Type> operator*=(const Quat<Type>& rhs) { return *this = *this * rhs; } // Multiplication assignment
+		constexpr Quat<Type> operator*=(Type scalar) { return *this = *this * scalar; } // Multiplication assignment (scalar)
 		// Division by another vector is not useful in math, scalar division is however.
-		Quat<Type> operator/(Type scalar) const; // Binary division (scalar)
-		Quat<Type> operator/=(Type scalar); // Division assignment (scalar)
+		constexpr Quat<Type> operator/(Type scalar) const // Binary division (scalar)
+		{
+			return (scalar != 0) ? Quat<Type>(x / scalar, y / scalar, z / scalar, w / scalar) : *this;
+		}
+		constexpr Quat<Type> operator/=(Type scalar) { return *this = *this / scalar; } // Division assignment (scalar)
 		// Remainder division doesn't really have any use.
 		//Quat<Type> operator%(Type scalar) const; // Binary modulus (scalar)
 		//QuatType> operator%=(Type scalar); // Modulus assignment (scalar)
-		Quat<Type>& operator++(void); // Prefix addition
-		Quat<Type>& operator--(void); // Prefix subtraction
-		Quat<Type> operator++(int) const; // Postfix addition (beware of copy!)
-		Quat<Type> operator--(int) const; // Postfix subtraction (beware of copy!)
-		// "Pseudo-cross product" or "cross product magnitude" magnitude of the cross product between the vectors
-		Quat<Type> Cross(const Quat<Type> &vec) const; // Psuedo Cross multiply this by vec
-		void Normalize(void); // Normalize vector by magnitude
-		Quat<Type> Normalized(void) const; // Normalize vector by magnitude
-		Type Magnitude(void) const; // Vector magnitude/length
-		Quat<Type> Conjugate(void) const { return Quat<Type>(-x, -y, -z, w); }
-		void Inverse(void) // Negate this
+		constexpr Quat<Type> &operator++(void) // Prefix addition
 		{
-			const Type kMagnitude = Magnitude();
-			*this = (kMagnitude != 0) ? (Conjugate() / Magnitude) : *this;
+			x++; y++; z++; w++;
+			return *this;
 		}
-		void Translate(const Vec3<Type> &vec); // Add vec to this
-		void Scale(const Quat<Type> &vec); // Multiply this by vec
-		void Scale(Type scalar); // Multiply this by scalar
-		Type Distance(const Vec3<Type> &vec) const; // Get the distance between this and vec
-		void AbsoluteValue(void); // Modify all elements in the vector to be absolute values
-		Type Summation(Type startValue = 0) const; // Get the sum of all elements in the vector
-		Type Product(Type startValue = 0) const; // Get the product of all elements in the vector
-		Type Dot(const Quat<Type> &vec) const // Dot product
+		constexpr Quat<Type> &operator--(void) // Prefix subtraction
+		{
+			x--; y--; z--; w--;
+			return *this;
+		}
+		constexpr Quat<Type> operator++(int) // Postfix addition (beware of copy!)
+		{
+			auto copyOfThis(*this);
+			operator++();
+			return copyOfThis;
+		}
+		constexpr Quat<Type> operator--(int) // Postfix subtraction (beware of copy!)
+		{
+			auto copyOfThis(*this);
+			operator--();
+			return copyOfThis;
+		}
+		// Cross product of the vector parts, the pure quaternion (this * vec - vec * this) / 2
+		constexpr Quat<Type> Cross(const Quat<Type> &vec) const
+		{
+			return Quat<Type>((y * vec.z) - (z * vec.y), (z * vec.x) - (x * vec.z), (x * vec.y) - (y * vec.x), 0);
+		}
+		constexpr void Normalize(void) { *this = *this / Magnitude(); } // Normalize vector by magnitude
+		constexpr Quat<Type> Normalized(void) const { return *this / Magnitude(); } // Normalize vector by magnitude
+		constexpr Type Magnitude(void) const { return static_cast<Type>(Sqrt(Dot(*this))); } // Vector magnitude/length
+		constexpr Quat<Type> Conjugate(void) const { return Quat<Type>(-x, -y, -z, w); }
+		constexpr void Inverse(void) { *this = Conjugate() / Dot(*this); } // Invert this, the conjugate for unit quaternions
+		constexpr void Translate(const Quat<Type> &vec) { *this += vec; } // Add vec to this
+		constexpr void Scale(const Quat<Type> &vec) // Multiply this by vec, element by element
+		{
+			x *= vec.x; y *= vec.y; z *= vec.z; w *= vec.w;
+		}
+		constexpr void Scale(Type scalar) { *this *= scalar; } // Multiply this by scalar
+		constexpr Type Distance(const Quat<Type> &vec) const { return (*this - vec).Magnitude(); } // Get the distance between this and vec
+		constexpr void AbsoluteValue(void) // Modify all elements to be absolute values
+		{
+			x = Abs(x); y = Abs(y); z = Abs(z); w = Abs(w);
+		}
+		constexpr Type Summation(Type startValue = 0) const { return (startValue + (x + y + z + w)); } // Get the sum of all elements
+		constexpr Type Product(Type startValue = 0) const { return (startValue + (x * y * z * w)); } // Get the product of all elements
+		constexpr Type Dot(const Quat<Type> &vec) const // Dot product
 		{
 			return ((x * vec.x) + (y * vec.y) + (z * vec.z) + (w * vec.w));
 		}
-		bool IsOrthogonal(const Vec3<Type> &vec) const; // Check if this is orthogonal to vec
-		TypeArray AsArray(void) const { return { x, y, z, w }; } // Convert to std::array type
-		static Quat<Type> Identity(void) { return Quat<Type>(); }
+		constexpr bool IsOrthogonal(const Quat<Type> &vec) const { return Abs(Dot(vec)) < 1E-6; } // Check if this is orthogonal to vec
+		constexpr TypeArray AsArray(void) const { return { x, y, z, w }; } // Convert to std::array type
+		static constexpr Quat<Type> Identity(void) { return Quat<Type>(); }
+		// Spherical interpolation along the shorter arc between unit quaternions START and END.
 		static Quat<Type> Slerp(const Quat<Type> &start, const Quat<Type> &end, Type interpFactor)
 		{
 			interpFactor = std::clamp(interpFactor, static_cast<Type>(0), static_cast<Type>(1));
+			Quat<Type> target = end;
 			Type cosTheta = start.Dot(end);
 			if (cosTheta < static_cast<Type>(0))
 			{
-				//end = -end;
-				//cosTheta = -cosTheta;
+				target = -end;
+				cosTheta = -cosTheta;
 			}
-			if (cosTheta > static_cast<Type>(0.9995f))
+			Type startWeight = static_cast<Type>(1) - interpFactor;
+			Type endWeight = interpFactor;
+			// Nearly parallel quaternions keep the normalized lerp weights
+			if (cosTheta <= static_cast<Type>(0.9995))
 			{
-				//Quat<Type> result = (static_cast<Type>(1) - interpFactor) * start + interpFactor * end;
-				//return result.Normalized();
+				const Type kTheta = std::acos(cosTheta);
+				const Type kSinTheta = std::sin(kTheta);
+				startWeight = std::sin(startWeight * kTheta) / kSinTheta;
+				endWeight = std::sin(endWeight * kTheta) / kSinTheta;
 			}
-			Type theta = std::acos(cosTheta);
-			Type sinTheta = std::sin(theta);
-			//const Type kA = std::sin((static_cast<Type>(1) - interpFactor) * theta) / sinTheta;
-			//const Type kB = std::sin(interpFactor * theta) / sinTheta;
-			//Quat<Type> result = kA * start + kB * end;
-			//return result.Normalized();
-			return {};
+			Quat<Type> result(startWeight * start.x + endWeight * target.x, startWeight * start.y + endWeight * target.y,
+							  startWeight * start.z + endWeight * target.z, startWeight * start.w + endWeight * target.w);
+			return result.Normalized();
 		}
 	};
 	
+	/**
+	 * Mat2x2 is a 2x2 matrix stored column-major, element (row, column) at
+	 * [column * 2 + row], which is the layout OpenGL expects.
+	 */
 	template <FloatingPoint Type>
 	class Mat2x2
 	{
 	public:
+		static constexpr std::size_t kNUM_ROWS = 2;
+		static constexpr std::size_t kNUM_COLUMNS = 2;
+		static constexpr std::size_t kARRAY_LENGTH = kNUM_ROWS * kNUM_COLUMNS;
+		using ValueType = Type;
+		using TypeArray = std::array<Type, kARRAY_LENGTH>;
+	private:
+		alignas(16) TypeArray m_elements;
+	public:
+		// Identity matrix
+		constexpr Mat2x2(void) : m_elements{ 1, 0, 0, 1 } { }
+		// Use column-major array for initial values
+		constexpr explicit Mat2x2(const TypeArray &columnMajor) : m_elements(columnMajor) { }
+		Mat2x2(const Mat2x2<Type> &) = default;
+		Mat2x2 &operator=(const Mat2x2<Type> &) = default;
+		Mat2x2(Mat2x2<Type> &&) noexcept = default;
+		Mat2x2 &operator=(Mat2x2<Type> &&) noexcept = default;
+	public:
+		bool operator==(const Mat2x2<Type> &) const = default;
+		constexpr Type &operator()(std::size_t row, std::size_t column) { return m_elements[column * kNUM_ROWS + row]; }
+		constexpr Type operator()(std::size_t row, std::size_t column) const { return m_elements[column * kNUM_ROWS + row]; }
+		constexpr Mat2x2<Type> operator*(const Mat2x2<Type> &rhs) const // Matrix multiplication
+		{
+			const auto &kA = m_elements;
+			const auto &kB = rhs.m_elements;
+			return Mat2x2<Type>(TypeArray{ kA[0] * kB[0] + kA[2] * kB[1], kA[1] * kB[0] + kA[3] * kB[1],
+										   kA[0] * kB[2] + kA[2] * kB[3], kA[1] * kB[2] + kA[3] * kB[3] });
+		}
+		constexpr Mat2x2<Type> operator*=(const Mat2x2<Type> &rhs) { return *this = *this * rhs; } // Multiplication assignment
+		constexpr Vec2<Type> operator*(const Vec2<Type> &vec) const // Transform VEC
+		{
+			return Vec2<Type>(m_elements[0] * vec.x + m_elements[2] * vec.y, m_elements[1] * vec.x + m_elements[3] * vec.y);
+		}
+		constexpr Mat2x2<Type> Transposed(void) const { return Mat2x2<Type>(TypeArray{ m_elements[0], m_elements[2], m_elements[1], m_elements[3] }); }
+		constexpr Type Determinant(void) const { return m_elements[0] * m_elements[3] - m_elements[2] * m_elements[1]; }
+		// Empty for singular matrices.
+		constexpr std::optional<Mat2x2<Type>> Inverse(void) const
+		{
+			const Type kDeterminant = Determinant();
+			if (kDeterminant == 0)
+				return std::nullopt;
+			const Type kInvDet = static_cast<Type>(1) / kDeterminant;
+			return Mat2x2<Type>(TypeArray{ m_elements[3] * kInvDet, -m_elements[1] * kInvDet,
+										   -m_elements[2] * kInvDet, m_elements[0] * kInvDet });
+		}
+		constexpr const Type *GetData(void) const noexcept { return m_elements.data(); }
+		constexpr Type *GetData(void) noexcept { return m_elements.data(); }
+		constexpr const TypeArray &AsArray(void) const noexcept { return m_elements; }
+		static constexpr Mat2x2<Type> Identity(void) { return Mat2x2<Type>(); }
+		static constexpr Mat2x2<Type> Scale(const Vec2<Type> &factors) { return Mat2x2<Type>(TypeArray{ factors.x, 0, 0, factors.y }); }
+		// Counter-clockwise rotation by RADIANS.
+		static constexpr Mat2x2<Type> Rotation(Type radians)
+		{
+			const Type kCos = Cos(radians);
+			const Type kSin = Sin(radians);
+			return Mat2x2<Type>(TypeArray{ kCos, kSin, -kSin, kCos });
+		}
 	};
 	
+	/**
+	 * Mat3x3 is a 3x3 matrix stored column-major and tightly packed, element
+	 * (row, column) at [column * 3 + row], which is the layout OpenGL expects.
+	 */
 	template <FloatingPoint Type>
 	class Mat3x3
 	{
 	public:
+		static constexpr std::size_t kNUM_ROWS = 3;
+		static constexpr std::size_t kNUM_COLUMNS = 3;
+		static constexpr std::size_t kARRAY_LENGTH = kNUM_ROWS * kNUM_COLUMNS;
+		using ValueType = Type;
+		using TypeArray = std::array<Type, kARRAY_LENGTH>;
+	private:
+		TypeArray m_elements;
+	public:
+		// Identity matrix
+		constexpr Mat3x3(void) : m_elements{ 1, 0, 0, 0, 1, 0, 0, 0, 1 } { }
+		// Use column-major array for initial values
+		constexpr explicit Mat3x3(const TypeArray &columnMajor) : m_elements(columnMajor) { }
+		Mat3x3(const Mat3x3<Type> &) = default;
+		Mat3x3 &operator=(const Mat3x3<Type> &) = default;
+		Mat3x3(Mat3x3<Type> &&) noexcept = default;
+		Mat3x3 &operator=(Mat3x3<Type> &&) noexcept = default;
+	public:
+		bool operator==(const Mat3x3<Type> &) const = default;
+		constexpr Type &operator()(std::size_t row, std::size_t column) { return m_elements[column * kNUM_ROWS + row]; }
+		constexpr Type operator()(std::size_t row, std::size_t column) const { return m_elements[column * kNUM_ROWS + row]; }
+		constexpr Mat3x3<Type> operator*(const Mat3x3<Type> &rhs) const // Matrix multiplication
+		{
+			Mat3x3<Type> result(TypeArray{});
+			for (std::size_t column = 0; column < kNUM_COLUMNS; ++column)
+			{
+				for (std::size_t row = 0; row < kNUM_ROWS; ++row)
+				{
+					result(row, column) = (*this)(row, 0) * rhs(0, column) + (*this)(row, 1) * rhs(1, column)
+						+ (*this)(row, 2) * rhs(2, column);
+				}
+			}
+			return result;
+		}
+		constexpr Mat3x3<Type> operator*=(const Mat3x3<Type> &rhs) { return *this = *this * rhs; } // Multiplication assignment
+		constexpr Vec3<Type> operator*(const Vec3<Type> &vec) const // Transform VEC
+		{
+			const auto &kE = m_elements;
+			return Vec3<Type>(kE[0] * vec.x + kE[3] * vec.y + kE[6] * vec.z,
+							  kE[1] * vec.x + kE[4] * vec.y + kE[7] * vec.z,
+							  kE[2] * vec.x + kE[5] * vec.y + kE[8] * vec.z);
+		}
+		constexpr Mat3x3<Type> Transposed(void) const
+		{
+			const auto &kE = m_elements;
+			return Mat3x3<Type>(TypeArray{ kE[0], kE[3], kE[6], kE[1], kE[4], kE[7], kE[2], kE[5], kE[8] });
+		}
+		constexpr Type Determinant(void) const
+		{
+			const Mat3x3<Type> &kM = *this;
+			return kM(0, 0) * (kM(1, 1) * kM(2, 2) - kM(1, 2) * kM(2, 1))
+				+ kM(0, 1) * (kM(1, 2) * kM(2, 0) - kM(1, 0) * kM(2, 2))
+				+ kM(0, 2) * (kM(1, 0) * kM(2, 1) - kM(1, 1) * kM(2, 0));
+		}
+		// Empty for singular matrices.
+		constexpr std::optional<Mat3x3<Type>> Inverse(void) const
+		{
+			const Mat3x3<Type> &kM = *this;
+			// Cofactors of the first row
+			const Type kC00 = kM(1, 1) * kM(2, 2) - kM(1, 2) * kM(2, 1);
+			const Type kC01 = kM(1, 2) * kM(2, 0) - kM(1, 0) * kM(2, 2);
+			const Type kC02 = kM(1, 0) * kM(2, 1) - kM(1, 1) * kM(2, 0);
+			const Type kDeterminant = kM(0, 0) * kC00 + kM(0, 1) * kC01 + kM(0, 2) * kC02;
+			if (kDeterminant == 0)
+				return std::nullopt;
+			const Type kInvDet = static_cast<Type>(1) / kDeterminant;
+			Mat3x3<Type> result(TypeArray{});
+			result(0, 0) = kC00 * kInvDet;
+			result(1, 0) = kC01 * kInvDet;
+			result(2, 0) = kC02 * kInvDet;
+			result(0, 1) = (kM(0, 2) * kM(2, 1) - kM(0, 1) * kM(2, 2)) * kInvDet;
+			result(1, 1) = (kM(0, 0) * kM(2, 2) - kM(0, 2) * kM(2, 0)) * kInvDet;
+			result(2, 1) = (kM(0, 1) * kM(2, 0) - kM(0, 0) * kM(2, 1)) * kInvDet;
+			result(0, 2) = (kM(0, 1) * kM(1, 2) - kM(0, 2) * kM(1, 1)) * kInvDet;
+			result(1, 2) = (kM(0, 2) * kM(1, 0) - kM(0, 0) * kM(1, 2)) * kInvDet;
+			result(2, 2) = (kM(0, 0) * kM(1, 1) - kM(0, 1) * kM(1, 0)) * kInvDet;
+			return result;
+		}
+		constexpr const Type *GetData(void) const noexcept { return m_elements.data(); }
+		constexpr Type *GetData(void) noexcept { return m_elements.data(); }
+		constexpr const TypeArray &AsArray(void) const noexcept { return m_elements; }
+		static constexpr Mat3x3<Type> Identity(void) { return Mat3x3<Type>(); }
+		static constexpr Mat3x3<Type> Scale(const Vec3<Type> &factors)
+		{
+			return Mat3x3<Type>(TypeArray{ factors.x, 0, 0, 0, factors.y, 0, 0, 0, factors.z });
+		}
 	};
 	
+	/**
+	 * Mat4x4 is a 4x4 matrix stored column-major, element (row, column) at
+	 * [column * 4 + row], which is the layout OpenGL expects.
+	 */
 	template <FloatingPoint Type>
 	class Mat4x4
 	{
 	public:
+		static constexpr std::size_t kNUM_ROWS = 4;
+		static constexpr std::size_t kNUM_COLUMNS = 4;
+		static constexpr std::size_t kARRAY_LENGTH = kNUM_ROWS * kNUM_COLUMNS;
+		using ValueType = Type;
+		using TypeArray = std::array<Type, kARRAY_LENGTH>;
+	private:
+		alignas(16) TypeArray m_elements;
+	public:
+		// Identity matrix
+		constexpr Mat4x4(void) : m_elements{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 } { }
+		// Use column-major array for initial values
+		constexpr explicit Mat4x4(const TypeArray &columnMajor) : m_elements(columnMajor) { }
+		// Affine matrix with LINEAR as the upper-left 3x3 and TRANSLATION as the last column
+		constexpr Mat4x4(const Mat3x3<Type> &linear, const Vec3<Type> &translation)
+			: m_elements{ linear(0, 0), linear(1, 0), linear(2, 0), 0,
+						  linear(0, 1), linear(1, 1), linear(2, 1), 0,
+						  linear(0, 2), linear(1, 2), linear(2, 2), 0,
+						  translation.x, translation.y, translation.z, 1 }
+		{
+		}
+		Mat4x4(const Mat4x4<Type> &) = default;
+		Mat4x4 &operator=(const Mat4x4<Type> &) = default;
+		Mat4x4(Mat4x4<Type> &&) noexcept = default;
+		Mat4x4 &operator=(Mat4x4<Type> &&) noexcept = default;
+	public:
+		bool operator==(const Mat4x4<Type> &) const = default;
+		constexpr Type &operator()(std::size_t row, std::size_t column) { return m_elements[column * kNUM_ROWS + row]; }
+		constexpr Type operator()(std::size_t row, std::size_t column) const { return m_elements[column * kNUM_ROWS + row]; }
+		constexpr Mat4x4<Type> operator*(const Mat4x4<Type> &rhs) const // Matrix multiplication
+		{
+			Mat4x4<Type> result(TypeArray{});
+			Multiply(*this, rhs, result);
+			return result;
+		}
+		constexpr Mat4x4<Type> operator*=(const Mat4x4<Type> &rhs) { return *this = *this * rhs; } // Multiplication assignment
+		// OUT = LHS * RHS without a temporary. OUT may not alias either input.
+		static constexpr void Multiply(const Mat4x4<Type> &lhs, const Mat4x4<Type> &rhs, Mat4x4<Type> &out)
+		{
+#if BGE_MATH_SSE
+			// Intrinsics can't run during constant evaluation
+			if constexpr (std::is_same_v<Type, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					// Each output column is the LHS columns weighted by one RHS column
+					const float *pLHS = lhs.GetData();
+					const __m128 kColumn0 = _mm_load_ps(pLHS);
+					const __m128 kColumn1 = _mm_load_ps(pLHS + 4);
+					const __m128 kColumn2 = _mm_load_ps(pLHS + 8);
+					const __m128 kColumn3 = _mm_load_ps(pLHS + 12);
+					for (std::size_t column = 0; column < kNUM_COLUMNS; ++column)
+					{
+						const float *pWeights = rhs.GetData() + column * kNUM_ROWS;
+						__m128 result = _mm_mul_ps(kColumn0, _mm_set1_ps(pWeights[0]));
+						result = _mm_add_ps(result, _mm_mul_ps(kColumn1, _mm_set1_ps(pWeights[1])));
+						result = _mm_add_ps(result, _mm_mul_ps(kColumn2, _mm_set1_ps(pWeights[2])));
+						result = _mm_add_ps(result, _mm_mul_ps(kColumn3, _mm_set1_ps(pWeights[3])));
+						_mm_store_ps(out.GetData() + column * kNUM_ROWS, result);
+					}
+					return;
+				}
+			}
+#endif
+			for (std::size_t column = 0; column < kNUM_COLUMNS; ++column)
+			{
+				for (std::size_t row = 0; row < kNUM_ROWS; ++row)
+				{
+					Type sum = 0;
+					for (std::size_t index = 0; index < kNUM_ROWS; ++index)
+						sum += lhs(row, index) * rhs(index, column);
+					out(row, column) = sum;
+				}
+			}
+		}
+		// Transform POINT as (x, y, z, 1), ignoring the projective row.
+		constexpr Vec3<Type> TransformPoint(const Vec3<Type> &point) const
+		{
+			const auto &kE = m_elements;
+			return Vec3<Type>(kE[0] * point.x + kE[4] * point.y + kE[8] * point.z + kE[12],
+							  kE[1] * point.x + kE[5] * point.y + kE[9] * point.z + kE[13],
+							  kE[2] * point.x + kE[6] * point.y + kE[10] * point.z + kE[14]);
+		}
+		// Transform direction VEC as (x, y, z, 0).
+		constexpr Vec3<Type> TransformVector(const Vec3<Type> &vec) const
+		{
+			const auto &kE = m_elements;
+			return Vec3<Type>(kE[0] * vec.x + kE[4] * vec.y + kE[8] * vec.z,
+							  kE[1] * vec.x + kE[5] * vec.y + kE[9] * vec.z,
+							  kE[2] * vec.x + kE[6] * vec.y + kE[10] * vec.z);
+		}
+		constexpr Vec3<Type> GetTranslation(void) const { return Vec3<Type>(m_elements[12], m_elements[13], m_elements[14]); }
+		// Upper-left 3x3, the rotation and scale of an affine matrix.
+		constexpr Mat3x3<Type> GetLinear(void) const
+		{
+			const auto &kE = m_elements;
+			return Mat3x3<Type>(typename Mat3x3<Type>::TypeArray{ kE[0], kE[1], kE[2], kE[4], kE[5], kE[6], kE[8], kE[9], kE[10] });
+		}
+		// Bottom row is (0, 0, 0, 1).
+		constexpr bool IsAffine(void) const { return m_elements[3] == 0 && m_elements[7] == 0 && m_elements[11] == 0 && m_elements[15] == 1; }
+		constexpr Mat4x4<Type> Transposed(void) const
+		{
+			Mat4x4<Type> result(m_elements);
+#if BGE_MATH_SSE
+			if constexpr (std::is_same_v<Type, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					float *pData = result.GetData();
+					__m128 column0 = _mm_load_ps(pData), column1 = _mm_load_ps(pData + 4);
+					__m128 column2 = _mm_load_ps(pData + 8), column3 = _mm_load_ps(pData + 12);
+					_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+					_mm_store_ps(pData, column0);
+					_mm_store_ps(pData + 4, column1);
+					_mm_store_ps(pData + 8, column2);
+					_mm_store_ps(pData + 12, column3);
+					return result;
+				}
+			}
+#endif
+			for (std::size_t row = 0; row < kNUM_ROWS; ++row)
+			{
+				for (std::size_t column = row + 1; column < kNUM_COLUMNS; ++column)
+					std::swap(result(row, column), result(column, row));
+			}
+			return result;
+		}
+		constexpr Type Determinant(void) const
+		{
+			const Mat4x4<Type> &kM = *this;
+			// 2x2 minors of the top two and bottom two rows
+			const Type kS0 = kM(0, 0) * kM(1, 1) - kM(1, 0) * kM(0, 1);
+			const Type kS1 = kM(0, 0) * kM(1, 2) - kM(1, 0) * kM(0, 2);
+			const Type kS2 = kM(0, 0) * kM(1, 3) - kM(1, 0) * kM(0, 3);
+			const Type kS3 = kM(0, 1) * kM(1, 2) - kM(1, 1) * kM(0, 2);
+			const Type kS4 = kM(0, 1) * kM(1, 3) - kM(1, 1) * kM(0, 3);
+			const Type kS5 = kM(0, 2) * kM(1, 3) - kM(1, 2) * kM(0, 3);
+			const Type kC5 = kM(2, 2) * kM(3, 3) - kM(3, 2) * kM(2, 3);
+			const Type kC4 = kM(2, 1) * kM(3, 3) - kM(3, 1) * kM(2, 3);
+			const Type kC3 = kM(2, 1) * kM(3, 2) - kM(3, 1) * kM(2, 2);
+			const Type kC2 = kM(2, 0) * kM(3, 3) - kM(3, 0) * kM(2, 3);
+			const Type kC1 = kM(2, 0) * kM(3, 2) - kM(3, 0) * kM(2, 2);
+			const Type kC0 = kM(2, 0) * kM(3, 1) - kM(3, 0) * kM(2, 1);
+			return kS0 * kC5 - kS1 * kC4 + kS2 * kC3 + kS3 * kC2 - kS4 * kC1 + kS5 * kC0;
+		}
+		// Empty for singular matrices. Affine matrices take the AffineInverse() fast path.
+		constexpr std::optional<Mat4x4<Type>> Inverse(void) const
+		{
+			if (IsAffine())
+				return AffineInverse();
+			const Mat4x4<Type> &kM = *this;
+			const Type kS0 = kM(0, 0) * kM(1, 1) - kM(1, 0) * kM(0, 1);
+			const Type kS1 = kM(0, 0) * kM(1, 2) - kM(1, 0) * kM(0, 2);
+			const Type kS2 = kM(0, 0) * kM(1, 3) - kM(1, 0) * kM(0, 3);
+			const Type kS3 = kM(0, 1) * kM(1, 2) - kM(1, 1) * kM(0, 2);
+			const Type kS4 = kM(0, 1) * kM(1, 3) - kM(1, 1) * kM(0, 3);
+			const Type kS5 = kM(0, 2) * kM(1, 3) - kM(1, 2) * kM(0, 3);
+			const Type kC5 = kM(2, 2) * kM(3, 3) - kM(3, 2) * kM(2, 3);
+			const Type kC4 = kM(2, 1) * kM(3, 3) - kM(3, 1) * kM(2, 3);
+			const Type kC3 = kM(2, 1) * kM(3, 2) - kM(3, 1) * kM(2, 2);
+			const Type kC2 = kM(2, 0) * kM(3, 3) - kM(3, 0) * kM(2, 3);
+			const Type kC1 = kM(2, 0) * kM(3, 2) - kM(3, 0) * kM(2, 2);
+			const Type kC0 = kM(2, 0) * kM(3, 1) - kM(3, 0) * kM(2, 1);
+			const Type kDeterminant = kS0 * kC5 - kS1 * kC4 + kS2 * kC3 + kS3 * kC2 - kS4 * kC1 + kS5 * kC0;
+			if (kDeterminant == 0)
+				return std::nullopt;
+			const Type kInvDet = static_cast<Type>(1) / kDeterminant;
+			Mat4x4<Type> result(TypeArray{});
+			result(0, 0) = (kM(1, 1) * kC5 - kM(1, 2) * kC4 + kM(1, 3) * kC3) * kInvDet;
+			result(0, 1) = (-kM(0, 1) * kC5 + kM(0, 2) * kC4 - kM(0, 3) * kC3) * kInvDet;
+			result(0, 2) = (kM(3, 1) * kS5 - kM(3, 2) * kS4 + kM(3, 3) * kS3) * kInvDet;
+			result(0, 3) = (-kM(2, 1) * kS5 + kM(2, 2) * kS4 - kM(2, 3) * kS3) * kInvDet;
+			result(1, 0) = (-kM(1, 0) * kC5 + kM(1, 2) * kC2 - kM(1, 3) * kC1) * kInvDet;
+			result(1, 1) = (kM(0, 0) * kC5 - kM(0, 2) * kC2 + kM(0, 3) * kC1) * kInvDet;
+			result(1, 2) = (-kM(3, 0) * kS5 + kM(3, 2) * kS2 - kM(3, 3) * kS1) * kInvDet;
+			result(1, 3) = (kM(2, 0) * kS5 - kM(2, 2) * kS2 + kM(2, 3) * kS1) * kInvDet;
+			result(2, 0) = (kM(1, 0) * kC4 - kM(1, 1) * kC2 + kM(1, 3) * kC0) * kInvDet;
+			result(2, 1) = (-kM(0, 0) * kC4 + kM(0, 1) * kC2 - kM(0, 3) * kC0) * kInvDet;
+			result(2, 2) = (kM(3, 0) * kS4 - kM(3, 1) * kS2 + kM(3, 3) * kS0) * kInvDet;
+			result(2, 3) = (-kM(2, 0) * kS4 + kM(2, 1) * kS2 - kM(2, 3) * kS0) * kInvDet;
+			result(3, 0) = (-kM(1, 0) * kC3 + kM(1, 1) * kC1 - kM(1, 2) * kC0) * kInvDet;
+			result(3, 1) = (kM(0, 0) * kC3 - kM(0, 1) * kC1 + kM(0, 2) * kC0) * kInvDet;
+			result(3, 2) = (-kM(3, 0) * kS3 + kM(3, 1) * kS1 - kM(3, 2) * kS0) * kInvDet;
+			result(3, 3) = (kM(2, 0) * kS3 - kM(2, 1) * kS1 + kM(2, 2) * kS0) * kInvDet;
+			return result;
+		}
+		// Inverse of an affine matrix (see IsAffine): invert the 3x3 and rotate the translation
+		// back. Empty when the 3x3 is singular.
+		constexpr std::optional<Mat4x4<Type>> AffineInverse(void) const
+		{
+			const auto kLinear = GetLinear().Inverse();
+			if (!kLinear)
+				return std::nullopt;
+			return Mat4x4<Type>(*kLinear, -(*kLinear * GetTranslation()));
+		}
+		constexpr const Type *GetData(void) const noexcept { return m_elements.data(); }
+		constexpr Type *GetData(void) noexcept { return m_elements.data(); }
+		constexpr const TypeArray &AsArray(void) const noexcept { return m_elements; }
+		static constexpr Mat4x4<Type> Identity(void) { return Mat4x4<Type>(); }
+		static constexpr Mat4x4<Type> Translation(const Vec3<Type> &offset)
+		{
+			Mat4x4<Type> result;
+			result(0, 3) = offset.x; result(1, 3) = offset.y; result(2, 3) = offset.z;
+			return result;
+		}
+		static constexpr Mat4x4<Type> Scale(const Vec3<Type> &factors)
+		{
+			Mat4x4<Type> result;
+			result(0, 0) = factors.x; result(1, 1) = factors.y; result(2, 2) = factors.z;
+			return result;
+		}
+		// ROTATION must be a unit quaternion.
+		static constexpr Mat4x4<Type> Rotation(const Quat<Type> &rotation)
+		{
+			const Type kX = rotation.x, kY = rotation.y, kZ = rotation.z, kW = rotation.w;
+			Mat4x4<Type> result;
+			result(0, 0) = 1 - 2 * (kY * kY + kZ * kZ);
+			result(0, 1) = 2 * (kX * kY - kZ * kW);
+			result(0, 2) = 2 * (kX * kZ + kY * kW);
+			result(1, 0) = 2 * (kX * kY + kZ * kW);
+			result(1, 1) = 1 - 2 * (kX * kX + kZ * kZ);
+			result(1, 2) = 2 * (kY * kZ - kX * kW);
+			result(2, 0) = 2 * (kX * kZ - kY * kW);
+			result(2, 1) = 2 * (kY * kZ + kX * kW);
+			result(2, 2) = 1 - 2 * (kX * kX + kY * kY);
+			return result;
+		}
+		// Scale, then rotate, then translate.
+		static constexpr Mat4x4<Type> FromTRS(const Vec3<Type> &translation, const Quat<Type> &rotation, const Vec3<Type> &scale)
+		{
+			Mat4x4<Type> result = Rotation(rotation);
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				result(row, 0) *= scale.x;
+				result(row, 1) *= scale.y;
+				result(row, 2) *= scale.z;
+			}
+			result(0, 3) = translation.x; result(1, 3) = translation.y; result(2, 3) = translation.z;
+			return result;
+		}
+		// Right-handed view matrix looking from EYE at TARGET.
+		static constexpr Mat4x4<Type> LookAt(const Vec3<Type> &eye, const Vec3<Type> &target, const Vec3<Type> &up)
+		{
+			const Vec3<Type> kForward = (target - eye).Normalized();
+			const Vec3<Type> kRight = kForward.Cross(up).Normalized();
+			const Vec3<Type> kUp = kRight.Cross(kForward);
+			Mat4x4<Type> result;
+			result(0, 0) = kRight.x; result(0, 1) = kRight.y; result(0, 2) = kRight.z;
+			result(1, 0) = kUp.x; result(1, 1) = kUp.y; result(1, 2) = kUp.z;
+			result(2, 0) = -kForward.x; result(2, 1) = -kForward.y; result(2, 2) = -kForward.z;
+			result(0, 3) = -kRight.Dot(eye);
+			result(1, 3) = -kUp.Dot(eye);
+			result(2, 3) = kForward.Dot(eye);
+			return result;
+		}
+		// Right-handed projection onto OpenGL clip space (depth -1 to 1). FOVY is in radians.
+		static constexpr Mat4x4<Type> Perspective(Type fovY, Type aspectRatio, Type nearPlane, Type farPlane)
+		{
+			const Type kFocalLength = static_cast<Type>(1) / Tan(fovY / 2);
+			Mat4x4<Type> result(TypeArray{});
+			result(0, 0) = kFocalLength / aspectRatio;
+			result(1, 1) = kFocalLength;
+			result(2, 2) = (farPlane + nearPlane) / (nearPlane - farPlane);
+			result(2, 3) = (2 * farPlane * nearPlane) / (nearPlane - farPlane);
+			result(3, 2) = -1;
+			return result;
+		}
 	};
 } // End namespace (BGE::Math)
 
@@ -0,0 +1,291 @@
+/*=============================================================================*
+ * MathBatch.cpp - Structure-of-arrays batch math.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include "Engine/EngineStd.hpp"
+#include "MathBatch.hpp"
+#include "MathBatchKernels.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BGE_MATHBATCH_SSE 1
+#else
+#define BGE_MATHBATCH_SSE 0
+#endif
+
+using namespace BGE::Math::Detail;
+
+namespace
+{
+	struct ScalarLane
+	{
+		using Value = float;
+		using Mask = bool;
+		static constexpr std::size_t kWIDTH = 1;
+
+		static Value Set(float value) { return value; }
+		static Value Load(const float *pSource) { return *pSource; }
+		static void Store(float *pDest, Value value) { *pDest = value; }
+		static Value Add(Value lhs, Value rhs) { return lhs + rhs; }
+		static Value Sub(Value lhs, Value rhs) { return lhs - rhs; }
+		static Value Mul(Value lhs, Value rhs) { return lhs * rhs; }
+		static Value Div(Value lhs, Value rhs) { return lhs / rhs; }
+		static Value MulAdd(Value lhs, Value rhs, Value addend) { return lhs * rhs + addend; }
+		static Value Sqrt(Value value) { return std::sqrt(value); }
+		static Value Min(Value lhs, Value rhs) { return std::min(lhs, rhs); }
+		static Value Abs(Value value) { return std::abs(value); }
+		static Mask Greater(Value lhs, Value rhs) { return lhs > rhs; }
+		static Value Select(Mask mask, Value ifTrue, Value ifFalse) { return mask ? ifTrue : ifFalse; }
+		// VALUE negated where SIGN is negative
+		static Value FlipSign(Value value, Value sign) { return std::signbit(sign) ? -value : value; }
+	};
+#if BGE_MATHBATCH_SSE
+	struct SSELane
+	{
+		using Value = __m128;
+		using Mask = __m128;
+		static constexpr std::size_t kWIDTH = 4;
+
+		static Value Set(float value) { return _mm_set1_ps(value); }
+		static Value Load(const float *pSource) { return _mm_loadu_ps(pSource); }
+		static void Store(float *pDest, Value value) { _mm_storeu_ps(pDest, value); }
+		static Value Add(Value lhs, Value rhs) { return _mm_add_ps(lhs, rhs); }
+		static Value Sub(Value lhs, Value rhs) { return _mm_sub_ps(lhs, rhs); }
+		static Value Mul(Value lhs, Value rhs) { return _mm_mul_ps(lhs, rhs); }
+		static Value Div(Value lhs, Value rhs) { return _mm_div_ps(lhs, rhs); }
+		static Value MulAdd(Value lhs, Value rhs, Value addend) { return _mm_add_ps(_mm_mul_ps(lhs, rhs), addend); }
+		static Value Sqrt(Value value) { return _mm_sqrt_ps(value); }
+		static Value Min(Value lhs, Value rhs) { return _mm_min_ps(lhs, rhs); }
+		static Value Abs(Value value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+		static Mask Greater(Value lhs, Value rhs) { return _mm_cmpgt_ps(lhs, rhs); }
+		static Value Select(Mask mask, Value ifTrue, Value ifFalse)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+		}
+		static Value FlipSign(Value value, Value sign) { return _mm_xor_ps(value, _mm_and_ps(sign, _mm_set1_ps(-0.0f))); }
+	};
+#endif
+
+	constexpr BatchKernels kSCALAR_KERNELS = MakeBatchKernels<ScalarLane>();
+#if BGE_MATHBATCH_SSE
+	constexpr BatchKernels kSSE_KERNELS = MakeBatchKernels<SSELane>();
+#endif
+
+	const BatchKernels *GetKernels(BGE::Math::SimdLevel level)
+	{
+		switch (level)
+		{
+		case BGE::Math::SimdLevel::AVX2:
+			return GetAVX2BatchKernels();
+#if BGE_MATHBATCH_SSE
+		case BGE::Math::SimdLevel::SSE:
+			return &kSSE_KERNELS;
+#endif
+		default:
+			return &kSCALAR_KERNELS;
+		}
+	}
+
+	struct ActiveKernels
+	{
+		BGE::Math::SimdLevel level;
+		const BatchKernels *pKernels;
+	};
+	ActiveKernels &GetActiveKernels(void)
+	{
+		static ActiveKernels s_active = []
+		{
+			const auto kLevel = BGE::Math::GetMaxSimdLevel();
+			return ActiveKernels{ kLevel, GetKernels(kLevel) };
+		}();
+		return s_active;
+	}
+
+	// Run FUNC over [0, COUNT) with the active kernels, finishing the tail with scalar ones.
+	template <typename Func>
+	void Dispatch(std::size_t count, Func func)
+	{
+		const BatchKernels &kKernels = *GetActiveKernels().pKernels;
+		const std::size_t kBlockEnd = count - count % kKernels.width;
+		if (kBlockEnd > 0)
+			func(kKernels, 0, kBlockEnd);
+		if (kBlockEnd < count)
+			func(kSCALAR_KERNELS, kBlockEnd, count);
+	}
+
+	ConstLanes3 GetLanes(const BGE::Math::Vec3Array &vecs)
+	{
+		return { vecs.GetX().data(), vecs.GetY().data(), vecs.GetZ().data() };
+	}
+	Lanes3 GetLanes(BGE::Math::Vec3Array &vecs)
+	{
+		return { vecs.GetX().data(), vecs.GetY().data(), vecs.GetZ().data() };
+	}
+	ConstLanes4 GetLanes(const BGE::Math::QuatArray &quats)
+	{
+		return { quats.GetX().data(), quats.GetY().data(), quats.GetZ().data(), quats.GetW().data() };
+	}
+	Lanes4 GetLanes(BGE::Math::QuatArray &quats)
+	{
+		return { quats.GetX().data(), quats.GetY().data(), quats.GetZ().data(), quats.GetW().data() };
+	}
+} // End anonymous namespace
+
+BGE::Math::SimdLevel BGE::Math::GetMaxSimdLevel(void)
+{
+	if (SDL_HasAVX2() && GetAVX2BatchKernels() != nullptr)
+		return SimdLevel::AVX2;
+	return BGE_MATHBATCH_SSE ? SimdLevel::SSE : SimdLevel::Scalar;
+}
+
+BGE::Math::SimdLevel BGE::Math::GetSimdLevel(void)
+{
+	return GetActiveKernels().level;
+}
+
+BGE::Math::SimdLevel BGE::Math::SetSimdLevel(SimdLevel level)
+{
+	level = std::min(level, GetMaxSimdLevel());
+	GetActiveKernels() = { level, GetKernels(level) };
+	return level;
+}
+
+BGE::Math::Vec3Array::Vec3Array(std::span<const Vec3f> vectors)
+	: Vec3Array(vectors.size())
+{
+	for (std::size_t index = 0; index < vectors.size(); ++index)
+		Set(index, vectors[index]);
+}
+
+void BGE::Math::Vec3Array::Resize(std::size_t size)
+{
+	m_x.resize(size);
+	m_y.resize(size);
+	m_z.resize(size);
+}
+
+void BGE::Math::Vec3Array::Set(std::size_t index, const Vec3f &vec)
+{
+	m_x[index] = vec.x;
+	m_y[index] = vec.y;
+	m_z[index] = vec.z;
+}
+
+BGE::Math::QuatArray::QuatArray(std::span<const Quatf> quats)
+	: QuatArray(quats.size())
+{
+	for (std::size_t index = 0; index < quats.size(); ++index)
+		Set(index, quats[index]);
+}
+
+void BGE::Math::QuatArray::Resize(std::size_t size)
+{
+	m_x.resize(size);
+	m_y.resize(size);
+	m_z.resize(size);
+	m_w.resize(size, 1.0f);
+}
+
+void BGE::Math::QuatArray::Set(std::size_t index, const Quatf &quat)
+{
+	m_x[index] = quat.x;
+	m_y[index] = quat.y;
+	m_z[index] = quat.z;
+	m_w[index] = quat.w;
+}
+
+void BGE::Math::BatchTransformPoints(const Mat4x4f &matrix, const Vec3Array &in, Vec3Array &out)
+{
+	out.Resize(in.GetSize());
+	const auto kIn = GetLanes(in);
+	const auto kOut = GetLanes(out);
+	Dispatch(in.GetSize(), [&](const BatchKernels &kernels, std::size_t begin, std::size_t end)
+	{
+		kernels.pTransformPoints(matrix.GetData(), kIn, kOut, begin, end);
+	});
+}
+
+void BGE::Math::BatchNormalize(const Vec3Array &in, Vec3Array &out)
+{
+	out.Resize(in.GetSize());
+	const auto kIn = GetLanes(in);
+	const auto kOut = GetLanes(out);
+	Dispatch(in.GetSize(), [&](const BatchKernels &kernels, std::size_t begin, std::size_t end)
+	{
+		kernels.pNormalize(kIn, kOut, begin, end);
+	});
+}
+
+void BGE::Math::BatchDot(const Vec3Array &lhs, const Vec3Array &rhs, std::span<float> out)
+{
+	BGE_ASSERT(lhs.GetSize() == rhs.GetSize() && out.size() >= lhs.GetSize());
+	const auto kLHS = GetLanes(lhs);
+	const auto kRHS = GetLanes(rhs);
+	Dispatch(lhs.GetSize(), [&](const BatchKernels &kernels, std::size_t begin, std::size_t end)
+	{
+		kernels.pDot(kLHS, kRHS, out.data(), begin, end);
+	});
+}
+
+void BGE::Math::BatchCross(const Vec3Array &lhs, const Vec3Array &rhs, Vec3Array &out)
+{
+	BGE_ASSERT(lhs.GetSize() == rhs.GetSize());
+	out.Resize(lhs.GetSize());
+	const auto kLHS = GetLanes(lhs);
+	const auto kRHS = GetLanes(rhs);
+	const auto kOut = GetLanes(out);
+	Dispatch(lhs.GetSize(), [&](const BatchKernels &kernels, std::size_t begin, std::size_t end)
+	{
+		kernels.pCross(kLHS, kRHS, kOut, begin, end);
+	});
+}
+
+void BGE::Math::BatchQuatMultiply(const QuatArray &lhs, const QuatArray &rhs, QuatArray &out)
+{
+	BGE_ASSERT(lhs.GetSize() == rhs.GetSize());
+	out.Resize(lhs.GetSize());
+	const auto kLHS = GetLanes(lhs);
+	const auto kRHS = GetLanes(rhs);
+	const auto kOut = GetLanes(out);
+	Dispatch(lhs.GetSize(), [&](const BatchKernels &kernels, std::size_t begin, std::size_t end)
+	{
+		kernels.pQuatMultiply(kLHS, kRHS, kOut, begin, end);
+	});
+}
+
+void BGE::Math::BatchQuatSlerp(const QuatArray &start, const QuatArray &end, float interpFactor, QuatArray &out)
+{
+	BGE_ASSERT(start.GetSize() == end.GetSize());
+	out.Resize(start.GetSize());
+	interpFactor = std::clamp(interpFactor, 0.0f, 1.0f);
+	const auto kStart = GetLanes(start);
+	const auto kEnd = GetLanes(end);
+	const auto kOut = GetLanes(out);
+	Dispatch(start.GetSize(), [&](const BatchKernels &kernels, std::size_t beginIndex, std::size_t endIndex)
+	{
+		kernels.pQuatSlerp(kStart, kEnd, interpFactor, kOut, beginIndex, endIndex);
+	});
+}
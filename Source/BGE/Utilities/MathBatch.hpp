@@ -0,0 +1,114 @@
+/*=============================================================================*
+ * MathBatch.hpp - Structure-of-arrays batch math.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_MATHBATCH_HPP_
+#define _BGE_MATHBATCH_HPP_
+
+namespace BGE::Math
+{
+	// Instruction sets the batch kernels can run on, slowest first.
+	enum class SimdLevel : int
+	{
+		Scalar,
+		SSE,
+		AVX2
+	};
+	// Best level supported by both the build and the CPU.
+	SimdLevel GetMaxSimdLevel(void);
+	SimdLevel GetSimdLevel(void);
+	// Select the kernels used by the Batch* functions, clamped to GetMaxSimdLevel(). Not thread
+	// safe; meant for startup and benchmarks. Returns the level actually selected.
+	SimdLevel SetSimdLevel(SimdLevel level);
+
+	/**
+	 * Vec3Array stores 3D vectors as structure-of-arrays (every x, then every y,
+	 * then every z) so the batch functions can process several vectors per
+	 * instruction.
+	 */
+	class Vec3Array
+	{
+	private:
+		std::vector<float> m_x, m_y, m_z;
+	public:
+		Vec3Array(void) = default;
+		explicit Vec3Array(std::size_t size) : m_x(size), m_y(size), m_z(size) { }
+		explicit Vec3Array(std::span<const Vec3f> vectors);
+
+		void Resize(std::size_t size);
+		std::size_t GetSize(void) const { return m_x.size(); }
+		Vec3f Get(std::size_t index) const { return Vec3f(m_x[index], m_y[index], m_z[index]); }
+		void Set(std::size_t index, const Vec3f &vec);
+		std::span<float> GetX(void) { return m_x; }
+		std::span<float> GetY(void) { return m_y; }
+		std::span<float> GetZ(void) { return m_z; }
+		std::span<const float> GetX(void) const { return m_x; }
+		std::span<const float> GetY(void) const { return m_y; }
+		std::span<const float> GetZ(void) const { return m_z; }
+	};
+
+	/**
+	 * QuatArray stores quaternions as structure-of-arrays, see Vec3Array.
+	 */
+	class QuatArray
+	{
+	private:
+		std::vector<float> m_x, m_y, m_z, m_w;
+	public:
+		QuatArray(void) = default;
+		explicit QuatArray(std::size_t size) : m_x(size), m_y(size), m_z(size), m_w(size, 1.0f) { }
+		explicit QuatArray(std::span<const Quatf> quats);
+
+		void Resize(std::size_t size);
+		std::size_t GetSize(void) const { return m_x.size(); }
+		Quatf Get(std::size_t index) const { return Quatf(m_x[index], m_y[index], m_z[index], m_w[index]); }
+		void Set(std::size_t index, const Quatf &quat);
+		std::span<float> GetX(void) { return m_x; }
+		std::span<float> GetY(void) { return m_y; }
+		std::span<float> GetZ(void) { return m_z; }
+		std::span<float> GetW(void) { return m_w; }
+		std::span<const float> GetX(void) const { return m_x; }
+		std::span<const float> GetY(void) const { return m_y; }
+		std::span<const float> GetZ(void) const { return m_z; }
+		std::span<const float> GetW(void) const { return m_w; }
+	};
+
+	// Batch functions resize their output array to the input size, so reusing an output avoids
+	// allocating. Outputs may alias inputs. Binary operations require equally sized inputs.
+	
+	// OUT[i] = MATRIX * (IN[i], 1), ignoring the projective row like Mat4x4::TransformPoint.
+	void BatchTransformPoints(const Mat4x4f &matrix, const Vec3Array &in, Vec3Array &out);
+	// OUT[i] = IN[i] normalized, zero vectors are left unchanged.
+	void BatchNormalize(const Vec3Array &in, Vec3Array &out);
+	// OUT[i] = LHS[i] . RHS[i], OUT must hold LHS.GetSize() elements.
+	void BatchDot(const Vec3Array &lhs, const Vec3Array &rhs, std::span<float> out);
+	void BatchCross(const Vec3Array &lhs, const Vec3Array &rhs, Vec3Array &out);
+	void BatchQuatMultiply(const QuatArray &lhs, const QuatArray &rhs, QuatArray &out);
+	// OUT[i] = Quat::Slerp(START[i], END[i], INTERPFACTOR) to within float precision.
+	void BatchQuatSlerp(const QuatArray &start, const QuatArray &end, float interpFactor, QuatArray &out);
+} // End namespace (BGE::Math)
+
+#endif /* !_BGE_MATHBATCH_HPP_ */
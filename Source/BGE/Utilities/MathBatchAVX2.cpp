@@ -0,0 +1,76 @@
+/*=============================================================================*
+ * MathBatchAVX2.cpp - AVX2 batch math kernels.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+// Built with AVX2 enabled (see CMakeLists.txt) but only called after the runtime
+// CPU check in MathBatch.cpp. Deliberately skips EngineStd.hpp: any inline function
+// compiled here could be picked by the linker for the whole engine.
+#include "MathBatchKernels.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace
+{
+	struct AVX2Lane
+	{
+		using Value = __m256;
+		using Mask = __m256;
+		static constexpr std::size_t kWIDTH = 8;
+
+		static Value Set(float value) { return _mm256_set1_ps(value); }
+		static Value Load(const float *pSource) { return _mm256_loadu_ps(pSource); }
+		static void Store(float *pDest, Value value) { _mm256_storeu_ps(pDest, value); }
+		static Value Add(Value lhs, Value rhs) { return _mm256_add_ps(lhs, rhs); }
+		static Value Sub(Value lhs, Value rhs) { return _mm256_sub_ps(lhs, rhs); }
+		static Value Mul(Value lhs, Value rhs) { return _mm256_mul_ps(lhs, rhs); }
+		static Value Div(Value lhs, Value rhs) { return _mm256_div_ps(lhs, rhs); }
+		// No FMA: SDL can't report it separately from AVX2
+		static Value MulAdd(Value lhs, Value rhs, Value addend) { return _mm256_add_ps(_mm256_mul_ps(lhs, rhs), addend); }
+		static Value Sqrt(Value value) { return _mm256_sqrt_ps(value); }
+		static Value Min(Value lhs, Value rhs) { return _mm256_min_ps(lhs, rhs); }
+		static Value Abs(Value value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+		static Mask Greater(Value lhs, Value rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ); }
+		static Value Select(Mask mask, Value ifTrue, Value ifFalse) { return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+		static Value FlipSign(Value value, Value sign)
+		{
+			return _mm256_xor_ps(value, _mm256_and_ps(sign, _mm256_set1_ps(-0.0f)));
+		}
+	};
+
+	constexpr BGE::Math::Detail::BatchKernels kAVX2_KERNELS = BGE::Math::Detail::MakeBatchKernels<AVX2Lane>();
+} // End anonymous namespace
+
+const BGE::Math::Detail::BatchKernels *BGE::Math::Detail::GetAVX2BatchKernels(void)
+{
+	return &kAVX2_KERNELS;
+}
+#else
+const BGE::Math::Detail::BatchKernels *BGE::Math::Detail::GetAVX2BatchKernels(void)
+{
+	return nullptr;
+}
+#endif
@@ -0,0 +1,231 @@
+/*=============================================================================*
+ * MathBatchKernels.hpp - Lane-generic batch math kernels.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_MATHBATCHKERNELS_HPP_
+#define _BGE_MATHBATCHKERNELS_HPP_
+
+// Shared by MathBatch.cpp and MathBatchAVX2.cpp, which is compiled for AVX2.
+// Keep this header free of anything but the kernels so no inline function
+// outside them is ever compiled with AVX2 enabled.
+#include <cstddef>
+
+namespace BGE::Math::Detail
+{
+	// Raw lane pointers of a structure-of-arrays batch.
+	struct ConstLanes3
+	{
+		const float *pX, *pY, *pZ;
+	};
+	struct Lanes3
+	{
+		float *pX, *pY, *pZ;
+	};
+	struct ConstLanes4
+	{
+		const float *pX, *pY, *pZ, *pW;
+	};
+	struct Lanes4
+	{
+		float *pX, *pY, *pZ, *pW;
+	};
+
+	// Kernels process elements [BEGIN, END), END - BEGIN must be a multiple of Lane::kWIDTH.
+	// A Lane wraps one register type (float, __m128, __m256) behind the same static interface.
+	template <typename Lane>
+	void TransformPointsKernel(const float *pMatrix, ConstLanes3 in, Lanes3 out, std::size_t begin, std::size_t end)
+	{
+		using Value = typename Lane::Value;
+		// Column-major, only the affine rows are needed
+		const Value kM0 = Lane::Set(pMatrix[0]), kM4 = Lane::Set(pMatrix[4]), kM8 = Lane::Set(pMatrix[8]), kM12 = Lane::Set(pMatrix[12]);
+		const Value kM1 = Lane::Set(pMatrix[1]), kM5 = Lane::Set(pMatrix[5]), kM9 = Lane::Set(pMatrix[9]), kM13 = Lane::Set(pMatrix[13]);
+		const Value kM2 = Lane::Set(pMatrix[2]), kM6 = Lane::Set(pMatrix[6]), kM10 = Lane::Set(pMatrix[10]), kM14 = Lane::Set(pMatrix[14]);
+		for (std::size_t index = begin; index < end; index += Lane::kWIDTH)
+		{
+			const Value kX = Lane::Load(in.pX + index);
+			const Value kY = Lane::Load(in.pY + index);
+			const Value kZ = Lane::Load(in.pZ + index);
+			Lane::Store(out.pX + index, Lane::MulAdd(kM0, kX, Lane::MulAdd(kM4, kY, Lane::MulAdd(kM8, kZ, kM12))));
+			Lane::Store(out.pY + index, Lane::MulAdd(kM1, kX, Lane::MulAdd(kM5, kY, Lane::MulAdd(kM9, kZ, kM13))));
+			Lane::Store(out.pZ + index, Lane::MulAdd(kM2, kX, Lane::MulAdd(kM6, kY, Lane::MulAdd(kM10, kZ, kM14))));
+		}
+	}
+
+	template <typename Lane>
+	void NormalizeKernel(ConstLanes3 in, Lanes3 out, std::size_t begin, std::size_t end)
+	{
+		using Value = typename Lane::Value;
+		const Value kZero = Lane::Set(0.0f);
+		const Value kOne = Lane::Set(1.0f);
+		for (std::size_t index = begin; index < end; index += Lane::kWIDTH)
+		{
+			const Value kX = Lane::Load(in.pX + index);
+			const Value kY = Lane::Load(in.pY + index);
+			const Value kZ = Lane::Load(in.pZ + index);
+			const Value kMagnitude = Lane::Sqrt(Lane::MulAdd(kX, kX, Lane::MulAdd(kY, kY, Lane::Mul(kZ, kZ))));
+			// Zero vectors are left unchanged, like Vec3::Normalize
+			const Value kScale = Lane::Select(Lane::Greater(kMagnitude, kZero), Lane::Div(kOne, kMagnitude), kOne);
+			Lane::Store(out.pX + index, Lane::Mul(kX, kScale));
+			Lane::Store(out.pY + index, Lane::Mul(kY, kScale));
+			Lane::Store(out.pZ + index, Lane::Mul(kZ, kScale));
+		}
+	}
+
+	template <typename Lane>
+	void DotKernel(ConstLanes3 lhs, ConstLanes3 rhs, float *pOut, std::size_t begin, std::size_t end)
+	{
+		for (std::size_t index = begin; index < end; index += Lane::kWIDTH)
+		{
+			const auto kXX = Lane::Mul(Lane::Load(lhs.pX + index), Lane::Load(rhs.pX + index));
+			const auto kYY = Lane::Mul(Lane::Load(lhs.pY + index), Lane::Load(rhs.pY + index));
+			const auto kZZ = Lane::Mul(Lane::Load(lhs.pZ + index), Lane::Load(rhs.pZ + index));
+			Lane::Store(pOut + index, Lane::Add(Lane::Add(kXX, kYY), kZZ));
+		}
+	}
+
+	template <typename Lane>
+	void CrossKernel(ConstLanes3 lhs, ConstLanes3 rhs, Lanes3 out, std::size_t begin, std::size_t end)
+	{
+		using Value = typename Lane::Value;
+		for (std::size_t index = begin; index < end; index += Lane::kWIDTH)
+		{
+			const Value kAX = Lane::Load(lhs.pX + index), kAY = Lane::Load(lhs.pY + index), kAZ = Lane::Load(lhs.pZ + index);
+			const Value kBX = Lane::Load(rhs.pX + index), kBY = Lane::Load(rhs.pY + index), kBZ = Lane::Load(rhs.pZ + index);
+			Lane::Store(out.pX + index, Lane::Sub(Lane::Mul(kAY, kBZ), Lane::Mul(kAZ, kBY)));
+			Lane::Store(out.pY + index, Lane::Sub(Lane::Mul(kAZ, kBX), Lane::Mul(kAX, kBZ)));
+			Lane::Store(out.pZ + index, Lane::Sub(Lane::Mul(kAX, kBY), Lane::Mul(kAY, kBX)));
+		}
+	}
+
+	template <typename Lane>
+	void QuatMultiplyKernel(ConstLanes4 lhs, ConstLanes4 rhs, Lanes4 out, std::size_t begin, std::size_t end)
+	{
+		using Value = typename Lane::Value;
+		for (std::size_t index = begin; index < end; index += Lane::kWIDTH)
+		{
+			const Value kAX = Lane::Load(lhs.pX + index), kAY = Lane::Load(lhs.pY + index);
+			const Value kAZ = Lane::Load(lhs.pZ + index), kAW = Lane::Load(lhs.pW + index);
+			const Value kBX = Lane::Load(rhs.pX + index), kBY = Lane::Load(rhs.pY + index);
+			const Value kBZ = Lane::Load(rhs.pZ + index), kBW = Lane::Load(rhs.pW + index);
+			// Same term order as Quat::operator*
+			Lane::Store(out.pX + index, Lane::Sub(Lane::Add(Lane::Add(Lane::Mul(kAW, kBX), Lane::Mul(kAX, kBW)), Lane::Mul(kAY, kBZ)), Lane::Mul(kAZ, kBY)));
+			Lane::Store(out.pY + index, Lane::Add(Lane::Add(Lane::Sub(Lane::Mul(kAW, kBY), Lane::Mul(kAX, kBZ)), Lane::Mul(kAY, kBW)), Lane::Mul(kAZ, kBX)));
+			Lane::Store(out.pZ + index, Lane::Add(Lane::Sub(Lane::Add(Lane::Mul(kAW, kBZ), Lane::Mul(kAX, kBY)), Lane::Mul(kAY, kBX)), Lane::Mul(kAZ, kBW)));
+			Lane::Store(out.pW + index, Lane::Sub(Lane::Sub(Lane::Sub(Lane::Mul(kAW, kBW), Lane::Mul(kAX, kBX)), Lane::Mul(kAY, kBY)), Lane::Mul(kAZ, kBZ)));
+		}
+	}
+
+	// acos(X) for X in [0, 1], absolute error below 1e-7 (Abramowitz & Stegun 4.4.46).
+	template <typename Lane>
+	typename Lane::Value AcosUnit(typename Lane::Value x)
+	{
+		auto poly = Lane::Set(-0.0012624911f);
+		poly = Lane::MulAdd(poly, x, Lane::Set(0.0066700901f));
+		poly = Lane::MulAdd(poly, x, Lane::Set(-0.0170881256f));
+		poly = Lane::MulAdd(poly, x, Lane::Set(0.0308918810f));
+		poly = Lane::MulAdd(poly, x, Lane::Set(-0.0501743046f));
+		poly = Lane::MulAdd(poly, x, Lane::Set(0.0889789874f));
+		poly = Lane::MulAdd(poly, x, Lane::Set(-0.2145988016f));
+		poly = Lane::MulAdd(poly, x, Lane::Set(1.5707963050f));
+		return Lane::Mul(poly, Lane::Sqrt(Lane::Sub(Lane::Set(1.0f), x)));
+	}
+	// sin(X) for X in [0, pi/2], truncated Taylor series with error below 1e-7.
+	template <typename Lane>
+	typename Lane::Value SinHalfPi(typename Lane::Value x)
+	{
+		const auto kXX = Lane::Mul(x, x);
+		auto poly = Lane::Set(-1.0f / 39916800.0f);
+		poly = Lane::MulAdd(poly, kXX, Lane::Set(1.0f / 362880.0f));
+		poly = Lane::MulAdd(poly, kXX, Lane::Set(-1.0f / 5040.0f));
+		poly = Lane::MulAdd(poly, kXX, Lane::Set(1.0f / 120.0f));
+		poly = Lane::MulAdd(poly, kXX, Lane::Set(-1.0f / 6.0f));
+		poly = Lane::MulAdd(poly, kXX, Lane::Set(1.0f));
+		return Lane::Mul(poly, x);
+	}
+
+	// Matches Quat::Slerp: shorter arc, normalized lerp for nearly parallel inputs.
+	template <typename Lane>
+	void QuatSlerpKernel(ConstLanes4 start, ConstLanes4 end, float interpFactor, Lanes4 out, std::size_t begin, std::size_t endIndex)
+	{
+		using Value = typename Lane::Value;
+		const Value kOne = Lane::Set(1.0f);
+		const Value kLerpThreshold = Lane::Set(0.9995f);
+		const Value kStartFactor = Lane::Set(1.0f - interpFactor);
+		const Value kEndFactor = Lane::Set(interpFactor);
+		for (std::size_t index = begin; index < endIndex; index += Lane::kWIDTH)
+		{
+			const Value kAX = Lane::Load(start.pX + index), kAY = Lane::Load(start.pY + index);
+			const Value kAZ = Lane::Load(start.pZ + index), kAW = Lane::Load(start.pW + index);
+			Value bX = Lane::Load(end.pX + index), bY = Lane::Load(end.pY + index);
+			Value bZ = Lane::Load(end.pZ + index), bW = Lane::Load(end.pW + index);
+			Value cosTheta = Lane::MulAdd(kAX, bX, Lane::MulAdd(kAY, bY, Lane::MulAdd(kAZ, bZ, Lane::Mul(kAW, bW))));
+			// Negate END where the arc is longer than half a turn
+			bX = Lane::FlipSign(bX, cosTheta);
+			bY = Lane::FlipSign(bY, cosTheta);
+			bZ = Lane::FlipSign(bZ, cosTheta);
+			bW = Lane::FlipSign(bW, cosTheta);
+			cosTheta = Lane::Min(Lane::Abs(cosTheta), kOne);
+			const Value kTheta = AcosUnit<Lane>(cosTheta);
+			const Value kInvSinTheta = Lane::Div(kOne, SinHalfPi<Lane>(kTheta));
+			const auto kIsLerp = Lane::Greater(cosTheta, kLerpThreshold);
+			const Value kStartWeight = Lane::Select(kIsLerp, kStartFactor, Lane::Mul(SinHalfPi<Lane>(Lane::Mul(kStartFactor, kTheta)), kInvSinTheta));
+			const Value kEndWeight = Lane::Select(kIsLerp, kEndFactor, Lane::Mul(SinHalfPi<Lane>(Lane::Mul(kEndFactor, kTheta)), kInvSinTheta));
+			const Value kX = Lane::MulAdd(kStartWeight, kAX, Lane::Mul(kEndWeight, bX));
+			const Value kY = Lane::MulAdd(kStartWeight, kAY, Lane::Mul(kEndWeight, bY));
+			const Value kZ = Lane::MulAdd(kStartWeight, kAZ, Lane::Mul(kEndWeight, bZ));
+			const Value kW = Lane::MulAdd(kStartWeight, kAW, Lane::Mul(kEndWeight, bW));
+			const Value kScale = Lane::Div(kOne, Lane::Sqrt(Lane::MulAdd(kX, kX, Lane::MulAdd(kY, kY, Lane::MulAdd(kZ, kZ, Lane::Mul(kW, kW))))));
+			Lane::Store(out.pX + index, Lane::Mul(kX, kScale));
+			Lane::Store(out.pY + index, Lane::Mul(kY, kScale));
+			Lane::Store(out.pZ + index, Lane::Mul(kZ, kScale));
+			Lane::Store(out.pW + index, Lane::Mul(kW, kScale));
+		}
+	}
+
+	// One instruction set's kernels, selected at runtime by MathBatch.cpp.
+	struct BatchKernels
+	{
+		std::size_t width; // Elements per iteration
+		void (*pTransformPoints)(const float *, ConstLanes3, Lanes3, std::size_t, std::size_t);
+		void (*pNormalize)(ConstLanes3, Lanes3, std::size_t, std::size_t);
+		void (*pDot)(ConstLanes3, ConstLanes3, float *, std::size_t, std::size_t);
+		void (*pCross)(ConstLanes3, ConstLanes3, Lanes3, std::size_t, std::size_t);
+		void (*pQuatMultiply)(ConstLanes4, ConstLanes4, Lanes4, std::size_t, std::size_t);
+		void (*pQuatSlerp)(ConstLanes4, ConstLanes4, float, Lanes4, std::size_t, std::size_t);
+	};
+
+	template <typename Lane>
+	constexpr BatchKernels MakeBatchKernels(void)
+	{
+		return { Lane::kWIDTH, &TransformPointsKernel<Lane>, &NormalizeKernel<Lane>, &DotKernel<Lane>,
+				 &CrossKernel<Lane>, &QuatMultiplyKernel<Lane>, &QuatSlerpKernel<Lane> };
+	}
+
+	// Defined in MathBatchAVX2.cpp; nullptr when that file was built without AVX2.
+	const BatchKernels *GetAVX2BatchKernels(void);
+} // End namespace (BGE::Math::Detail)
+
+#endif /* !_BGE_MATHBATCHKERNELS_HPP_ */
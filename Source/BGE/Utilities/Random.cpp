@@ -34,6 +34,10 @@
 //#include <cstdint>
 //#include <cstddef>
 
+static_assert(BGE::Math::IsRandomRangeValid(BGE::Math::RandomRange<float>{ 0.0f, 1.0f }));
+static_assert(BGE::Math::IsRandomRangeValid(BGE::Math::RandomRange<int>{ 2, 2 }));
+static_assert(!BGE::Math::IsRandomRangeValid(BGE::Math::RandomRange<double>{ 1.0, -1.0 }));
+
 BGE::Math::Random::Random(std::uint64_t seedNum)
 	: m_seed(seedNum),
 	  m_engine(m_seed)
@@ -65,7 +65,7 @@ namespace BGE::Math
 	template <Math::Numeric Type>
 	inline constexpr bool IsRandomRangeValid(const RandomRange<Type> &range)
 	{
-		return !(range.minValue < range.maxValue);
+		return range.minValue <= range.maxValue; // The distributions accept a single value range
 	}
 } // End namespace (BGE::Math)
 
@@ -1,9 +1,213 @@
 #ifndef _BGE_TEMPLATES_HPP_
 #define _BGE_TEMPLATES_HPP_
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace BGE
 {
+	/**
+	 * FlatMap is a sorted associative container for small maps (e.g. an actor's
+	 * components). Keys and values live in separate arrays, so a lookup scans one
+	 * packed run of keys, and the first kInlineCapacity entries need no allocation.
+	 * It spills to the heap when it outgrows the inline arrays.
+	 *
+	 * The interface mirrors the subset of std::map used in the engine. Dereferencing
+	 * an iterator yields a pair of references, so bind it with auto && or const auto &.
+	 * Inserting or erasing invalidates iterators.
+	 */
+	template <typename Key, typename Value, std::size_t kInlineCapacity = 8>
+	class FlatMap
+	{
+		static_assert(kInlineCapacity > 0);
+		static_assert(std::is_default_constructible_v<Key> && std::is_default_constructible_v<Value>);
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+
+		template <bool kIS_CONST>
+		class Iterator
+		{
+			using MapType = std::conditional_t<kIS_CONST, const FlatMap, FlatMap>;
+			using ValueRef = std::conditional_t<kIS_CONST, const Value &, Value &>;
+
+			MapType *m_pMap;
+			size_type m_index;
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = std::pair<const Key &, ValueRef>;
+			using reference = value_type;
+			// operator-> needs somewhere to keep the pair of references
+			struct Pointer
+			{
+				value_type pair;
+				const value_type *operator->(void) const { return &pair; }
+			};
+			using pointer = Pointer;
+
+			Iterator(void) : m_pMap(nullptr), m_index(0) { }
+			Iterator(MapType *pMap, size_type index) : m_pMap(pMap), m_index(index) { }
+			// Allow iterator -> const_iterator
+			operator Iterator<true>(void) const requires(!kIS_CONST) { return Iterator<true>(m_pMap, m_index); }
+
+			reference operator*(void) const { return reference(m_pMap->GetKeys()[m_index], m_pMap->GetValues()[m_index]); }
+			pointer operator->(void) const { return Pointer{ **this }; }
+			Iterator &operator++(void) { ++m_index; return *this; }
+			Iterator operator++(int) { Iterator prev = *this; ++m_index; return prev; }
+			bool operator==(const Iterator &other) const { return m_index == other.m_index && m_pMap == other.m_pMap; }
+			size_type GetIndex(void) const noexcept { return m_index; }
+		};
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+	private:
+		// Linear scans beat binary search up to about this many keys
+		static constexpr size_type kLINEAR_SEARCH_LIMIT = 16;
+
+		std::array<Key, kInlineCapacity> m_inlineKeys{};
+		std::array<Value, kInlineCapacity> m_inlineValues{};
+		std::vector<Key> m_heapKeys; // In use once the map outgrows the inline arrays
+		std::vector<Value> m_heapValues;
+		size_type m_size = 0;
+		bool m_isInline = true;
+	public:
+		FlatMap(void) = default;
+
+		iterator begin(void) { return iterator(this, 0); }
+		iterator end(void) { return iterator(this, m_size); }
+		const_iterator begin(void) const { return const_iterator(this, 0); }
+		const_iterator end(void) const { return const_iterator(this, m_size); }
+		size_type size(void) const noexcept { return m_size; }
+		bool empty(void) const noexcept { return m_size == 0; }
+
+		iterator find(const Key &key)
+		{
+			const size_type kIndex = LowerBound(key);
+			return (kIndex < m_size && GetKeys()[kIndex] == key) ? iterator(this, kIndex) : end();
+		}
+		const_iterator find(const Key &key) const
+		{
+			const size_type kIndex = LowerBound(key);
+			return (kIndex < m_size && GetKeys()[kIndex] == key) ? const_iterator(this, kIndex) : end();
+		}
+		bool contains(const Key &key) const { return find(key) != end(); }
+		// Cheaper than find() when only the value is needed; nullptr if KEY is absent.
+		Value *FindValue(const Key &key) { return const_cast<Value *>(std::as_const(*this).FindValue(key)); }
+		const Value *FindValue(const Key &key) const
+		{
+			const Key *pKeys = m_isInline ? m_inlineKeys.data() : m_heapKeys.data();
+			const size_type kIndex = LowerBound(key);
+			if (kIndex == m_size || pKeys[kIndex] != key)
+				return nullptr;
+			return (m_isInline ? m_inlineValues.data() : m_heapValues.data()) + kIndex;
+		}
+
+		std::pair<iterator, bool> insert(const std::pair<Key, Value> &entry) { return emplace(entry.first, entry.second); }
+		template <typename ValueArg>
+		std::pair<iterator, bool> emplace(const Key &key, ValueArg &&value);
+		Value &operator[](const Key &key) { return GetValues()[emplace(key, Value()).first.GetIndex()]; }
+		size_type erase(const Key &key);
+		void clear(void);
+		// Sorted keys and their values, index aligned.
+		std::span<const Key> GetKeys(void) const { return { m_isInline ? m_inlineKeys.data() : m_heapKeys.data(), m_size }; }
+		std::span<Value> GetValues(void) { return { m_isInline ? m_inlineValues.data() : m_heapValues.data(), m_size }; }
+		std::span<const Value> GetValues(void) const { return { m_isInline ? m_inlineValues.data() : m_heapValues.data(), m_size }; }
+	private:
+		size_type LowerBound(const Key &key) const
+		{
+			const auto kKeys = GetKeys();
+			if (m_size <= kLINEAR_SEARCH_LIMIT)
+			{
+				size_type index = 0;
+				while (index < m_size && kKeys[index] < key)
+					++index;
+				return index;
+			}
+			return static_cast<size_type>(std::lower_bound(kKeys.begin(), kKeys.end(), key) - kKeys.begin());
+		}
+		void SpillToHeap(void);
+	};
+
+	template <typename Key, typename Value, std::size_t kInlineCapacity>
+	template <typename ValueArg>
+	auto FlatMap<Key, Value, kInlineCapacity>::emplace(const Key &key, ValueArg &&value) -> std::pair<iterator, bool>
+	{
+		const size_type kIndex = LowerBound(key);
+		if (kIndex < m_size && GetKeys()[kIndex] == key)
+			return { iterator(this, kIndex), false };
+
+		if (m_isInline && m_size == kInlineCapacity)
+			SpillToHeap();
+
+		if (m_isInline)
+		{
+			// Shift the tail up one slot to open kIndex
+			std::move_backward(m_inlineKeys.begin() + kIndex, m_inlineKeys.begin() + m_size,
+							   m_inlineKeys.begin() + m_size + 1);
+			std::move_backward(m_inlineValues.begin() + kIndex, m_inlineValues.begin() + m_size,
+							   m_inlineValues.begin() + m_size + 1);
+			m_inlineKeys[kIndex] = key;
+			m_inlineValues[kIndex] = std::forward<ValueArg>(value);
+		}
+		else
+		{
+			m_heapKeys.insert(m_heapKeys.begin() + kIndex, key);
+			m_heapValues.insert(m_heapValues.begin() + kIndex, std::forward<ValueArg>(value));
+		}
+		++m_size;
+		return { iterator(this, kIndex), true };
+	}
+
+	template <typename Key, typename Value, std::size_t kInlineCapacity>
+	auto FlatMap<Key, Value, kInlineCapacity>::erase(const Key &key) -> size_type
+	{
+		const size_type kIndex = LowerBound(key);
+		if (kIndex == m_size || GetKeys()[kIndex] != key)
+			return 0;
+
+		if (m_isInline)
+		{
+			std::move(m_inlineKeys.begin() + kIndex + 1, m_inlineKeys.begin() + m_size, m_inlineKeys.begin() + kIndex);
+			std::move(m_inlineValues.begin() + kIndex + 1, m_inlineValues.begin() + m_size,
+					  m_inlineValues.begin() + kIndex);
+			m_inlineValues[m_size - 1] = Value(); // Release what the vacated slot held
+		}
+		else
+		{
+			m_heapKeys.erase(m_heapKeys.begin() + kIndex);
+			m_heapValues.erase(m_heapValues.begin() + kIndex);
+		}
+		--m_size;
+		return 1;
+	}
+
+	template <typename Key, typename Value, std::size_t kInlineCapacity>
+	void FlatMap<Key, Value, kInlineCapacity>::clear(void)
+	{
+		std::fill(m_inlineValues.begin(), m_inlineValues.begin() + (m_isInline ? m_size : 0), Value());
+		m_heapKeys.clear();
+		m_heapValues.clear();
+		m_size = 0;
+		m_isInline = true;
+	}
 
+	template <typename Key, typename Value, std::size_t kInlineCapacity>
+	void FlatMap<Key, Value, kInlineCapacity>::SpillToHeap(void)
+	{
+		m_heapKeys.reserve(kInlineCapacity * 2);
+		m_heapValues.reserve(kInlineCapacity * 2);
+		m_heapKeys.assign(m_inlineKeys.begin(), m_inlineKeys.begin() + m_size);
+		m_heapValues.assign(std::make_move_iterator(m_inlineValues.begin()),
+							std::make_move_iterator(m_inlineValues.begin() + m_size));
+		std::fill(m_inlineValues.begin(), m_inlineValues.begin() + m_size, Value());
+		m_isInline = false;
+	}
 } // End namespace (BGE)
 
 #endif /* !_BGE_TEMPLATES_HPP_ */
\ No newline at end of file
@@ -41,10 +41,15 @@ namespace BGE
 	// Actor and actor component invalid ID number constants:
 	inline constexpr ActorID kINVALID_ACTOR_ID = 0;
 	inline constexpr ActorComponentID kINVALID_ACTOR_COMPONENT_ID = 0;
+	// Stamp for component changes; later changes have larger versions
+	using ChangeVersion = std::uint32_t;
 	// Actor and actor component pointer types:
 	BGE_DECLARE_PTR(Actor);
 	BGE_DECLARE_PTR(ActorComponent);
 	
+	class IRenderSnapshot;
+	BGE_DECLARE_PTR(IRenderSnapshot);
+
 	// GameView types & constants:
 	using GameViewID = std::uint32_t;
 	inline constexpr GameViewID kINVALID_GAMEVIEW_ID = 0xFFFFFFFF;
@@ -0,0 +1,574 @@
+/*=============================================================================*
+ * ActorBench.cpp - Actor creation and update benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+#include "Actors/Actor.hpp"
+#include "Actors/ActorArchetype.hpp"
+#include "Actors/ActorCommandBuffer.hpp"
+#include "Actors/ActorComponent.hpp"
+#include "Actors/ActorFactory.hpp"
+#include "Actors/ActorQuery.hpp"
+#include "Actors/ActorSnapshot.hpp"
+#include "Actors/ComponentStore.hpp"
+#include "Actors/SystemScheduler.hpp"
+#include "Multicore/JobSystem.hpp"
+
+#include <sstream>
+
+using namespace BGE;
+
+namespace
+{
+	// Minimal component that integrates a position every update.
+	class MotionComponent final : public ActorComponent
+	{
+		BGE_ACTOR_COMPONENT(MotionComponent)
+	public:
+		Math::Vec3f m_position{ 0.0f };
+		Math::Vec3f m_velocity{ 1.0f };
+
+		virtual bool VInit(tinyxml2::XMLElement *pData) override
+		{
+			pData->QueryFloatAttribute("vx", &m_velocity.x);
+			pData->QueryFloatAttribute("vy", &m_velocity.y);
+			pData->QueryFloatAttribute("vz", &m_velocity.z);
+			return true;
+		}
+		virtual void VUpdate(float deltaTime) override { m_position += m_velocity * deltaTime; }
+		virtual tinyxml2::XMLElement *VGenerateXML(tinyxml2::XMLDocument &doc) override { return doc.NewElement(kNAME.data()); }
+		virtual bool VWriteBlob(BlobWriter &writer) const override
+		{
+			writer.Write(m_position);
+			writer.Write(m_velocity);
+			return true;
+		}
+		virtual bool VInitFromBlob(BlobReader &reader) override { return reader.Read(m_position) && reader.Read(m_velocity); }
+	};
+	// Component with no update work, to measure per-component dispatch overhead.
+	class TagComponent final : public ActorComponent
+	{
+		BGE_ACTOR_COMPONENT(TagComponent)
+	public:
+		virtual bool VInit(tinyxml2::XMLElement *pData) override { return true; }
+		virtual tinyxml2::XMLElement *VGenerateXML(tinyxml2::XMLDocument &doc) override { return doc.NewElement(kNAME.data()); }
+		virtual bool VWriteBlob(BlobWriter &writer) const override { return true; }
+		virtual bool VInitFromBlob(BlobReader &reader) override { return true; }
+	};
+
+	// Extra componentless-update types so actors can carry a typical 6 components.
+#define BGE_BENCH_TAG_COMPONENT(TYPE) \
+	class TYPE final : public ActorComponent \
+	{ \
+		BGE_ACTOR_COMPONENT(TYPE) \
+	public: \
+		virtual bool VInit(tinyxml2::XMLElement *pData) override { return true; } \
+		virtual tinyxml2::XMLElement *VGenerateXML(tinyxml2::XMLDocument &doc) override { return doc.NewElement(kNAME.data()); } \
+	};
+	BGE_BENCH_TAG_COMPONENT(HealthComponent)
+	BGE_BENCH_TAG_COMPONENT(RenderComponent)
+	BGE_BENCH_TAG_COMPONENT(AudioComponent)
+	BGE_BENCH_TAG_COMPONENT(ScriptComponent)
+#undef BGE_BENCH_TAG_COMPONENT
+
+	StrongActorPtr MakeActor(ActorID aID)
+	{
+		auto pActor = std::make_shared<Actor>(aID);
+		pActor->AddComponent(std::make_shared<MotionComponent>());
+		pActor->AddComponent(std::make_shared<TagComponent>());
+		pActor->PostInit();
+		return pActor;
+	}
+	// Same actor, with its components packed in STORE.
+	StrongActorPtr MakePooledActor(ComponentStore &store, ActorID aID)
+	{
+		auto pActor = std::make_shared<Actor>(aID);
+		pActor->AddComponent(store.Create<MotionComponent>());
+		pActor->AddComponent(store.Create<TagComponent>());
+		pActor->PostInit();
+		return pActor;
+	}
+	StrongActorPtr MakeWideActor(ActorID aID)
+	{
+		auto pActor = std::make_shared<Actor>(aID);
+		pActor->AddComponent(std::make_shared<ScriptComponent>());
+		pActor->AddComponent(std::make_shared<HealthComponent>());
+		pActor->AddComponent(std::make_shared<MotionComponent>());
+		pActor->AddComponent(std::make_shared<RenderComponent>());
+		pActor->AddComponent(std::make_shared<AudioComponent>());
+		pActor->AddComponent(std::make_shared<TagComponent>());
+		pActor->PostInit();
+		return pActor;
+	}
+	// Projectile definition as a game would ship it
+	constexpr const char *kPROJECTILE_XML = R"xml(<?xml version="1.0" encoding="utf-8"?>
+<Actor type="Projectile" resource="Actors/Projectile.xml">
+	<MotionComponent vx="0.0" vy="0.0" vz="-40.0"/>
+	<TagComponent/>
+</Actor>
+)xml";
+
+	// Actor count for the per-frame update benchmarks
+	constexpr std::size_t kNUM_LARGE_ACTORS = 100'000;
+	// Actor count of a large level for the save/load benchmarks
+	constexpr std::size_t kNUM_SNAPSHOT_ACTORS = 50'000;
+
+	/**
+	 * ActorBenchWorld is the shared benchmark fixture. It owns a component store, a
+	 * factory with the bench components registered and the spawned actors, and
+	 * destroys the actors when it goes out of scope.
+	 */
+	class ActorBenchWorld
+	{
+	private:
+		ComponentStore m_store; // Declared first so it outlives the actors
+		ActorFactory m_factory;
+		std::vector<StrongActorPtr> m_actors;
+	public:
+		ActorBenchWorld(void)
+		{
+			m_factory.RegisterComponent<MotionComponent>();
+			m_factory.RegisterComponent<TagComponent>();
+		}
+		~ActorBenchWorld(void) { Clear(); }
+		ActorBenchWorld(const ActorBenchWorld &) = delete;
+		ActorBenchWorld &operator=(const ActorBenchWorld &) = delete;
+
+		ComponentStore &GetStore(void) noexcept { return m_store; }
+		ActorFactory &GetFactory(void) noexcept { return m_factory; }
+		std::vector<StrongActorPtr> &GetActors(void) noexcept { return m_actors; }
+		// Append NUM_ACTORS actors with heap allocated Motion & Tag components.
+		void Spawn(std::size_t numActors) { SpawnWith(numActors, MakeActor); }
+		// Append NUM_ACTORS actors with their components packed in the store.
+		void SpawnPooled(std::size_t numActors)
+		{
+			SpawnWith(numActors, [this](ActorID aID) { return MakePooledActor(m_store, aID); });
+		}
+		// Append NUM_ACTORS actors carrying six components each.
+		void SpawnWide(std::size_t numActors) { SpawnWith(numActors, MakeWideActor); }
+		void UpdateAll(float deltaTime)
+		{
+			for (auto &pActor : m_actors)
+				pActor->Update(deltaTime);
+		}
+		// Destroy every actor, keeping the capacity for the next spawn.
+		void Clear(void)
+		{
+			for (auto &pActor : m_actors)
+				pActor->Destroy();
+			m_actors.clear();
+		}
+		// Hand every actor back to the factory instead of destroying it.
+		void Recycle(void)
+		{
+			for (auto &pActor : m_actors)
+				m_factory.RecycleActor(std::move(pActor));
+			m_actors.clear();
+		}
+		ActorArchetype CompileProjectile(void)
+		{
+			tinyxml2::XMLDocument document;
+			document.Parse(kPROJECTILE_XML);
+			auto pPrototype = m_factory.CreateActorFromXML(document.RootElement());
+			ActorArchetype archetype;
+			archetype.Compile(*pPrototype);
+			pPrototype->Destroy();
+			return archetype;
+		}
+	private:
+		template <typename MakeFunc>
+		void SpawnWith(std::size_t numActors, MakeFunc makeActor)
+		{
+			m_actors.reserve(m_actors.size() + numActors);
+			for (std::size_t index = 0; index < numActors; ++index)
+				m_actors.push_back(makeActor(static_cast<ActorID>(m_actors.size() + 1)));
+		}
+	};
+
+	ActorMap MakeLevel(void)
+	{
+		ActorMap actors;
+		actors.reserve(kNUM_SNAPSHOT_ACTORS);
+		for (std::size_t index = 0; index < kNUM_SNAPSHOT_ACTORS; ++index)
+			actors.emplace(static_cast<ActorID>(index + 1), MakeActor(static_cast<ActorID>(index + 1)));
+		return actors;
+	}
+	void DestroyLevel(ActorMap &actors)
+	{
+		for (auto &[kID, pActor] : actors)
+			pActor->Destroy();
+		actors.clear();
+	}
+} // End anonymous namespace
+
+BGE_BENCHMARK(Actor, CreateDestroy)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		world.Spawn(kNUM_ACTORS);
+		world.Clear();
+	}
+}
+
+BGE_BENCHMARK(Actor, Update10k)
+{
+	constexpr std::size_t kNUM_ACTORS = 10'000;
+	ActorBenchWorld world;
+	world.Spawn(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		world.UpdateAll(16.0f);
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Actor, GetComponentPtr)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	world.Spawn(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (auto &pActor : world.GetActors())
+		{
+			auto pMotion = Utils::MakeStrongPtr(pActor->GetComponentPtr<MotionComponent>(MotionComponent::kID));
+			Bench::DoNotOptimize(pMotion.get());
+		}
+	}
+}
+
+BGE_BENCHMARK(Actor, GetComponentByType)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	world.Spawn(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (auto &pActor : world.GetActors())
+		{
+			auto pMotion = Utils::MakeStrongPtr(pActor->GetComponent<MotionComponent>());
+			Bench::DoNotOptimize(pMotion.get());
+		}
+	}
+}
+
+BGE_BENCHMARK(Actor, GetComponentByName)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	world.Spawn(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (auto &pActor : world.GetActors())
+		{
+			auto pMotion = Utils::MakeStrongPtr(pActor->GetComponent<MotionComponent>("MotionComponent"));
+			Bench::DoNotOptimize(pMotion.get());
+		}
+	}
+}
+
+BGE_BENCHMARK(Actor, Update100k)
+{
+	ActorBenchWorld world;
+	world.Spawn(kNUM_LARGE_ACTORS);
+	state.SetItemsPerIteration(kNUM_LARGE_ACTORS);
+	for (auto _ : state)
+	{
+		world.UpdateAll(16.0f);
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Actor, PooledUpdate100k)
+{
+	ActorBenchWorld world;
+	world.SpawnPooled(kNUM_LARGE_ACTORS);
+	state.SetItemsPerIteration(kNUM_LARGE_ACTORS);
+	for (auto _ : state)
+	{
+		world.GetStore().UpdateAll(16.0f);
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Actor, ParallelUpdate100k)
+{
+	ActorBenchWorld world;
+	world.SpawnPooled(kNUM_LARGE_ACTORS);
+	JobSystem jobs;
+	SystemScheduler scheduler;
+	scheduler.AddSystem(std::make_unique<PooledUpdateSystem<MotionComponent>>(world.GetStore().GetPool<MotionComponent>()));
+	scheduler.AddSystem(std::make_unique<PooledUpdateSystem<TagComponent>>(world.GetStore().GetPool<TagComponent>()));
+
+	state.SetItemsPerIteration(kNUM_LARGE_ACTORS);
+	for (auto _ : state)
+	{
+		scheduler.Update(jobs, 16.0f);
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Actor, PooledCreateDestroy)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		world.SpawnPooled(kNUM_ACTORS);
+		world.Clear();
+	}
+}
+
+BGE_BENCHMARK(Actor, WideUpdate10k)
+{
+	constexpr std::size_t kNUM_ACTORS = 10'000;
+	ActorBenchWorld world;
+	world.SpawnWide(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		world.UpdateAll(16.0f);
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Actor, WideGetComponent10k)
+{
+	constexpr std::size_t kNUM_ACTORS = 10'000;
+	ActorBenchWorld world;
+	world.SpawnWide(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (auto &pActor : world.GetActors())
+		{
+			auto pMotion = Utils::MakeStrongPtr(pActor->GetComponent<MotionComponent>());
+			Bench::DoNotOptimize(pMotion.get());
+		}
+	}
+}
+
+BGE_BENCHMARK(Actor, WideFindComponent10k)
+{
+	constexpr std::size_t kNUM_ACTORS = 10'000;
+	ActorBenchWorld world;
+	world.SpawnWide(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (auto &pActor : world.GetActors())
+			Bench::DoNotOptimize(pActor->FindComponent<MotionComponent>());
+	}
+}
+
+BGE_BENCHMARK(Actor, SpawnFromXML)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	world.GetActors().reserve(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_ACTORS; ++index)
+		{
+			tinyxml2::XMLDocument document;
+			document.Parse(kPROJECTILE_XML);
+			world.GetActors().push_back(world.GetFactory().CreateActorFromXML(document.RootElement()));
+		}
+		world.Clear();
+	}
+}
+
+BGE_BENCHMARK(Actor, SpawnFromArchetype)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	const ActorArchetype kArchetype = world.CompileProjectile();
+	world.GetActors().reserve(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_ACTORS; ++index)
+			world.GetActors().push_back(world.GetFactory().CreateActor(kArchetype));
+		world.Clear();
+	}
+}
+
+BGE_BENCHMARK(Actor, SpawnRecycled)
+{
+	constexpr std::size_t kNUM_ACTORS = 1000;
+	ActorBenchWorld world;
+	const ActorArchetype kArchetype = world.CompileProjectile();
+	world.GetFactory().ReserveActors(kArchetype, kNUM_ACTORS);
+	world.GetActors().reserve(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_ACTORS; ++index)
+			world.GetActors().push_back(world.GetFactory().CreateActor(kArchetype));
+		world.Recycle();
+	}
+}
+
+BGE_BENCHMARK(Actor, BatchSpawnDespawn5k)
+{
+	constexpr std::size_t kNUM_ACTORS = 5000;
+	ActorBenchWorld world;
+	const ActorArchetype kArchetype = world.CompileProjectile();
+	world.GetFactory().ReserveActors(kArchetype, kNUM_ACTORS);
+
+	ActorCommandBuffer commands(world.GetFactory());
+	ActorMap actors;
+	std::vector<Math::Mat4x4f> transforms(kNUM_ACTORS);
+	std::vector<ActorID> actorIDs(kNUM_ACTORS);
+	state.SetItemsPerIteration(kNUM_ACTORS);
+	for (auto _ : state)
+	{
+		const ActorID kFirstID = commands.Spawn(kArchetype, kNUM_ACTORS, transforms);
+		commands.Flush(actors);
+		std::iota(actorIDs.begin(), actorIDs.end(), kFirstID);
+		commands.Despawn(actorIDs);
+		commands.Flush(actors);
+	}
+}
+
+BGE_BENCHMARK(Actor, ChangedSince100k)
+{
+	ActorBenchWorld world;
+	world.SpawnPooled(kNUM_LARGE_ACTORS);
+	// One actor in a hundred changes each frame
+	std::vector<MotionComponent *> changing;
+	for (std::size_t index = 0; index < kNUM_LARGE_ACTORS; index += 100)
+		changing.push_back(world.GetActors()[index]->FindComponent<MotionComponent>());
+
+	auto &pool = world.GetStore().GetPool<MotionComponent>();
+	state.SetItemsPerIteration(kNUM_LARGE_ACTORS);
+	for (auto _ : state)
+	{
+		const ChangeVersion kLastRun = ActorComponent::AdvanceVersion();
+		ActorComponent::AdvanceVersion();
+		for (auto *pMotion : changing)
+			pMotion->MarkChanged();
+
+		std::size_t numChanged = 0;
+		pool.ForEachChangedSince(kLastRun, [&numChanged](MotionComponent &) { ++numChanged; });
+		Bench::DoNotOptimize(numChanged);
+		world.GetStore().DispatchChanges();
+	}
+}
+
+BGE_BENCHMARK(Actor, SnapshotSave50k)
+{
+	ActorMap actors = MakeLevel();
+	std::ostringstream stream;
+	state.SetItemsPerIteration(kNUM_SNAPSHOT_ACTORS);
+	for (auto _ : state)
+	{
+		stream.str(std::string());
+		ActorSnapshotWriter writer(stream);
+		writer.WriteActors(actors);
+		Bench::DoNotOptimize(writer.Finish());
+	}
+	DestroyLevel(actors);
+}
+
+BGE_BENCHMARK(Actor, SnapshotLoad50k)
+{
+	ActorMap actors = MakeLevel();
+	std::ostringstream stream;
+	ActorSnapshotWriter(stream).WriteActors(actors);
+	DestroyLevel(actors);
+	const std::string kSnapshot = stream.str();
+	const auto kBytes = std::as_bytes(std::span(kSnapshot.data(), kSnapshot.size()));
+
+	ActorBenchWorld world;
+	actors.reserve(kNUM_SNAPSHOT_ACTORS);
+	state.SetItemsPerIteration(kNUM_SNAPSHOT_ACTORS);
+	for (auto _ : state)
+	{
+		ActorSnapshotReader reader;
+		reader.Open(kBytes);
+		for (const auto &kActorView : reader.GetActors())
+			actors.emplace(kActorView.aID, world.GetFactory().CreateActor(reader, kActorView));
+		DestroyLevel(actors);
+	}
+}
+
+BGE_BENCHMARK(Actor, QueryScan100k)
+{
+	// Baseline for QueryIterate100k: find the matches by probing every actor
+	ActorBenchWorld world;
+	world.Spawn(kNUM_LARGE_ACTORS);
+	for (std::size_t index = 0; index < kNUM_LARGE_ACTORS; ++index)
+	{
+		if (index % 10 != 0)
+			world.GetActors()[index]->AddComponent(std::make_shared<HealthComponent>());
+	}
+
+	state.SetItemsPerIteration(kNUM_LARGE_ACTORS / 10);
+	for (auto _ : state)
+	{
+		for (const auto &pActor : world.GetActors())
+		{
+			if (pActor->GetComponents().contains(HealthComponent::kID))
+				continue;
+			if (auto *pMotion = pActor->FindComponent<MotionComponent>())
+				pMotion->VUpdate(16.0f);
+		}
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Actor, QueryIterate100k)
+{
+	// One actor in ten matches "Motion but not Health"
+	ActorQueryRegistry registry;
+	ActorQuery &query = registry.GetQuery(ActorQueryDesc().With<MotionComponent>().Without<HealthComponent>());
+	ActorBenchWorld world;
+	world.Spawn(kNUM_LARGE_ACTORS);
+	for (std::size_t index = 0; index < kNUM_LARGE_ACTORS; ++index)
+	{
+		registry.AddActor(*world.GetActors()[index]);
+		if (index % 10 != 0)
+			world.GetActors()[index]->AddComponent(std::make_shared<HealthComponent>());
+	}
+
+	state.SetItemsPerIteration(query.GetSize());
+	for (auto _ : state)
+	{
+		query.ForEach<MotionComponent>([](Actor &, MotionComponent &motion) { motion.VUpdate(16.0f); });
+		Bench::ClobberMemory();
+	}
+}
@@ -0,0 +1,111 @@
+/*=============================================================================*
+ * BenchMain.cpp - Entry point of the benchmark runner.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+
+using namespace BGE;
+
+static void PrintUsage(void);
+
+int main(int argc, char *argv[])
+{
+	Bench::RunOptions options;
+	std::string jsonFilename;
+	std::string baselineFilename;
+	std::string label;
+	double thresholdPercent = 10.0;
+	bool toListOnly = false;
+	// Parse command line options:
+	const auto kArgs = GetArguments(argc, argv);
+	for (std::size_t index = 1; index < kArgs.size(); ++index)
+	{
+		const std::string_view kArg = kArgs[index];
+		const bool kHasValue = (index + 1 < kArgs.size());
+		if (kArg == "--list")
+			toListOnly = true;
+		else if (kArg == "--filter" && kHasValue)
+			options.filter = kArgs[++index];
+		else if (kArg == "--reps" && kHasValue)
+			options.numRepetitions = std::strtoul(kArgs[++index].data(), nullptr, 10);
+		else if (kArg == "--warmup" && kHasValue)
+			options.numWarmups = std::strtoul(kArgs[++index].data(), nullptr, 10);
+		else if (kArg == "--min-time-ms" && kHasValue)
+			options.minRepTimeMS = std::strtod(kArgs[++index].data(), nullptr);
+		else if (kArg == "--json" && kHasValue)
+			jsonFilename = kArgs[++index];
+		else if (kArg == "--baseline" && kHasValue)
+			baselineFilename = kArgs[++index];
+		else if (kArg == "--threshold" && kHasValue)
+			thresholdPercent = std::strtod(kArgs[++index].data(), nullptr);
+		else if (kArg == "--label" && kHasValue)
+			label = kArgs[++index];
+		else
+		{
+			PrintUsage();
+			return BGE_EXIT_FAILURE;
+		}
+	}
+
+	if (toListOnly)
+	{
+		for (const auto &entry : Bench::GetBenchmarks())
+			std::printf("%s\n", entry.GetFullName().c_str());
+		return BGE_EXIT_SUCCESS;
+	}
+	// Error messengers rely on the logging system
+	Logger::Init("Logging.xml");
+
+	const auto kResults = Bench::RunBenchmarks(options);
+	Bench::PrintResults(stdout, kResults);
+
+	int exitCode = BGE_EXIT_SUCCESS;
+	if (!jsonFilename.empty() && !Bench::WriteResultsJSON(jsonFilename, kResults, label))
+		exitCode = BGE_EXIT_FAILURE;
+	// Fail the run when any benchmark regressed beyond the threshold
+	if (!baselineFilename.empty() &&
+		Bench::CompareWithBaseline(stdout, baselineFilename, kResults, thresholdPercent) != 0)
+		exitCode = BGE_EXIT_FAILURE;
+
+	Logger::Destroy();
+	return exitCode;
+}
+
+void PrintUsage(void)
+{
+	std::fprintf(stderr,
+				 "Usage: BGEBench [options]\n"
+				 "  --list                 List registered benchmarks\n"
+				 "  --filter <text>        Only run benchmarks whose name contains text\n"
+				 "  --reps <n>             Measured repetitions (default 10)\n"
+				 "  --warmup <n>           Discarded warmup repetitions (default 2)\n"
+				 "  --min-time-ms <ms>     Minimum duration of one repetition (default 20)\n"
+				 "  --json <file>          Write results as JSON\n"
+				 "  --label <text>         Label stored in the JSON context (e.g. commit hash)\n"
+				 "  --baseline <file>      Compare medians against a previous JSON run\n"
+				 "  --threshold <percent>  Regression threshold for --baseline (default 10)\n");
+}
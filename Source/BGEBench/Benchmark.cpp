@@ -0,0 +1,286 @@
+/*=============================================================================*
+ * Benchmark.cpp - Benchmark registration and measurement harness.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace ch = std::chrono;
+
+namespace BGE::Bench
+{
+	// Function-local static avoids static initialization order issues with BGE_BENCHMARK.
+	static std::vector<BenchmarkEntry> &GetRegistry(void)
+	{
+		static std::vector<BenchmarkEntry> s_registry;
+		return s_registry;
+	}
+	// Find the iteration count that makes one repetition last at least minRepTimeMS.
+	static std::uint64_t CalibrateIterations(BenchmarkFunc pFunc, double minRepTimeMS);
+	static BenchmarkResult Summarize(std::string name, std::uint64_t iterations, std::uint64_t itemsPerIteration,
+									 std::vector<double> samplesNS);
+	static std::string_view GetBuildConfigName(void);
+} // End namespace (BGE::Bench)
+
+BGE::Bench::State::State(std::uint64_t iterations)
+	: m_iterations(iterations),
+	  m_itemsPerIteration(0),
+	  m_start(),
+	  m_elapsed(Clock::duration::zero()),
+	  m_isRunning(false)
+{
+}
+
+double BGE::Bench::State::GetElapsedNS(void) const
+{
+	return static_cast<double>(ch::duration_cast<ch::nanoseconds>(m_elapsed).count());
+}
+
+void BGE::Bench::State::StartTimer(void)
+{
+	if (m_isRunning)
+		return;
+	m_isRunning = true;
+	m_start = Clock::now();
+}
+
+void BGE::Bench::State::StopTimer(void)
+{
+	if (!m_isRunning)
+		return;
+	m_elapsed += Clock::now() - m_start;
+	m_isRunning = false;
+}
+
+bool BGE::Bench::RegisterBenchmark(std::string_view suiteName, std::string_view benchName, BenchmarkFunc pFunc)
+{
+	GetRegistry().push_back({ std::string(suiteName), std::string(benchName), pFunc });
+	return true;
+}
+
+const std::vector<BGE::Bench::BenchmarkEntry> &BGE::Bench::GetBenchmarks(void)
+{
+	// Keep a deterministic order regardless of link order.
+	auto &registry = GetRegistry();
+	std::stable_sort(registry.begin(), registry.end(), [](const BenchmarkEntry &lhs, const BenchmarkEntry &rhs)
+		{
+			return lhs.GetFullName() < rhs.GetFullName();
+		});
+	return registry;
+}
+
+std::vector<BGE::Bench::BenchmarkResult> BGE::Bench::RunBenchmarks(const RunOptions &options)
+{
+	std::vector<BenchmarkResult> results;
+	for (const auto &entry : GetBenchmarks())
+	{
+		const auto kFullName = entry.GetFullName();
+		if (!options.filter.empty() && kFullName.find(options.filter) == std::string::npos)
+			continue;
+
+		std::fprintf(stderr, "Running %s...\n", kFullName.c_str());
+		const auto kIterations = CalibrateIterations(entry.pFunc, options.minRepTimeMS);
+		// Warm caches, branch predictors and allocators before measuring
+		for (std::size_t index = 0; index < options.numWarmups; ++index)
+		{
+			State state(kIterations);
+			entry.pFunc(state);
+		}
+
+		std::vector<double> samplesNS;
+		samplesNS.reserve(options.numRepetitions);
+		std::uint64_t itemsPerIteration = 0;
+		for (std::size_t index = 0; index < std::max<std::size_t>(options.numRepetitions, 1); ++index)
+		{
+			State state(kIterations);
+			entry.pFunc(state);
+			samplesNS.push_back(state.GetElapsedNS() / static_cast<double>(kIterations));
+			itemsPerIteration = state.GetItemsPerIteration();
+		}
+		results.push_back(Summarize(kFullName, kIterations, itemsPerIteration, std::move(samplesNS)));
+	}
+	return results;
+}
+
+void BGE::Bench::PrintResults(std::FILE *pFile, std::span<const BenchmarkResult> results)
+{
+	std::fprintf(pFile, "%-40s %12s %12s %12s %12s %8s %14s\n",
+				 "Benchmark", "Median(ns)", "Mean(ns)", "Min(ns)", "P90(ns)", "CV(%)", "Items/s");
+	for (const auto &result : results)
+	{
+		const double kCoeffVariation = (result.meanNS > 0.0) ? (result.stdDevNS / result.meanNS) * 100.0 : 0.0;
+		std::fprintf(pFile, "%-40s %12.2f %12.2f %12.2f %12.2f %8.2f %14.4g\n", result.name.c_str(),
+					 result.medianNS, result.meanNS, result.minNS, result.p90NS, kCoeffVariation,
+					 result.itemsPerSec);
+	}
+}
+
+bool BGE::Bench::WriteResultsJSON(std::string_view filename, std::span<const BenchmarkResult> results,
+								  std::string_view label)
+{
+	std::ofstream outFile{ std::string(filename) };
+	if (!outFile)
+	{
+		BGE_ERROR("WriteResultsJSON Failure: Couldn't open %.*s for writing.", static_cast<int>(filename.size()),
+				  filename.data());
+		return false;
+	}
+
+	const auto kTimeString = Utils::GetSystemTimeString();
+	outFile << std::setprecision(6) << std::fixed;
+	outFile << "{\n";
+	outFile << "\"context\": {\"label\": \"" << label << "\", \"date\": \""
+			<< kTimeString.value_or("") << "\", \"platform\": \"" << GetPlatform()
+			<< "\", \"cpus\": " << ReadLogicalCPUCores() << ", \"build\": \"" << GetBuildConfigName() << "\"},\n";
+	outFile << "\"benchmarks\": [\n";
+	// One benchmark per line keeps the file diffable and trivial to read back.
+	for (std::size_t index = 0; index < results.size(); ++index)
+	{
+		const auto &result = results[index];
+		outFile << "{\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+				<< ", \"repetitions\": " << result.repetitions
+				<< ", \"median_ns\": " << result.medianNS << ", \"mean_ns\": " << result.meanNS
+				<< ", \"min_ns\": " << result.minNS << ", \"max_ns\": " << result.maxNS
+				<< ", \"p90_ns\": " << result.p90NS << ", \"stddev_ns\": " << result.stdDevNS
+				<< ", \"items_per_sec\": " << result.itemsPerSec << '}'
+				<< ((index + 1 < results.size()) ? ",\n" : "\n");
+	}
+	outFile << "]\n}\n";
+	return static_cast<bool>(outFile);
+}
+
+int BGE::Bench::CompareWithBaseline(std::FILE *pFile, std::string_view baselineFilename,
+									std::span<const BenchmarkResult> results, double thresholdPercent)
+{
+	std::ifstream inFile{ std::string(baselineFilename) };
+	if (!inFile)
+	{
+		BGE_ERROR("CompareWithBaseline Failure: Couldn't open %.*s.", static_cast<int>(baselineFilename.size()),
+				  baselineFilename.data());
+		return -1;
+	}
+	// Read back the name & median of each line written by WriteResultsJSON
+	std::map<std::string, double> baselineMedians;
+	static constexpr std::string_view c_kNAME_KEY = "\"name\": \"";
+	static constexpr std::string_view c_kMEDIAN_KEY = "\"median_ns\": ";
+	for (std::string line; std::getline(inFile, line);)
+	{
+		const auto kNamePos = line.find(c_kNAME_KEY);
+		const auto kMedianPos = line.find(c_kMEDIAN_KEY);
+		if (kNamePos == std::string::npos || kMedianPos == std::string::npos)
+			continue;
+
+		const auto kNameStart = kNamePos + c_kNAME_KEY.size();
+		const auto kNameEnd = line.find('"', kNameStart);
+		if (kNameEnd == std::string::npos)
+			continue;
+		baselineMedians[line.substr(kNameStart, kNameEnd - kNameStart)] =
+			std::strtod(line.c_str() + kMedianPos + c_kMEDIAN_KEY.size(), nullptr);
+	}
+
+	int numRegressions = 0;
+	std::fprintf(pFile, "\n%-40s %12s %12s %9s\n", "Benchmark", "Base(ns)", "New(ns)", "Delta(%)");
+	for (const auto &result : results)
+	{
+		auto findIter = baselineMedians.find(result.name);
+		if (findIter == baselineMedians.end() || findIter->second <= 0.0)
+		{
+			std::fprintf(pFile, "%-40s %12s %12.2f %9s\n", result.name.c_str(), "-", result.medianNS, "new");
+			continue;
+		}
+		const double kDeltaPercent = ((result.medianNS - findIter->second) / findIter->second) * 100.0;
+		const bool kIsRegression = kDeltaPercent > thresholdPercent;
+		numRegressions += (kIsRegression) ? 1 : 0;
+		std::fprintf(pFile, "%-40s %12.2f %12.2f %+9.2f%s\n", result.name.c_str(), findIter->second,
+					 result.medianNS, kDeltaPercent, (kIsRegression) ? "  REGRESSION" : "");
+	}
+	return numRegressions;
+}
+
+std::uint64_t BGE::Bench::CalibrateIterations(BenchmarkFunc pFunc, double minRepTimeMS)
+{
+	static constexpr std::uint64_t c_kMAX_ITERATIONS = 1'000'000'000;
+	const double kTargetNS = minRepTimeMS * 1'000'000.0;
+	std::uint64_t iterations = 1;
+	while (iterations < c_kMAX_ITERATIONS)
+	{
+		State state(iterations);
+		pFunc(state);
+		const double kElapsedNS = state.GetElapsedNS();
+		if (kElapsedNS >= kTargetNS)
+			break;
+		// Scale towards the target, growing at most 10x per step to limit overshoot
+		const double kScale = (kElapsedNS > 0.0) ? std::min(10.0, (kTargetNS * 1.2) / kElapsedNS) : 10.0;
+		iterations = std::max(iterations + 1, static_cast<std::uint64_t>(static_cast<double>(iterations) * kScale));
+	}
+	return std::min(iterations, c_kMAX_ITERATIONS);
+}
+
+BGE::Bench::BenchmarkResult BGE::Bench::Summarize(std::string name, std::uint64_t iterations,
+												  std::uint64_t itemsPerIteration, std::vector<double> samplesNS)
+{
+	BenchmarkResult result;
+	result.name = std::move(name);
+	result.iterations = iterations;
+	result.repetitions = samplesNS.size();
+	if (samplesNS.empty())
+		return result;
+
+	std::sort(samplesNS.begin(), samplesNS.end());
+	const std::size_t kCount = samplesNS.size();
+	result.minNS = samplesNS.front();
+	result.maxNS = samplesNS.back();
+	result.medianNS = (kCount % 2 == 0) ? (samplesNS[kCount / 2 - 1] + samplesNS[kCount / 2]) * 0.5
+										: samplesNS[kCount / 2];
+	result.p90NS = samplesNS[std::min(kCount - 1, static_cast<std::size_t>(std::ceil(0.9 * kCount)) - 1)];
+	result.meanNS = std::accumulate(samplesNS.begin(), samplesNS.end(), 0.0) / static_cast<double>(kCount);
+
+	double sumSquares = 0.0;
+	for (const double kSample : samplesNS)
+		sumSquares += (kSample - result.meanNS) * (kSample - result.meanNS);
+	result.stdDevNS = (kCount > 1) ? std::sqrt(sumSquares / static_cast<double>(kCount - 1)) : 0.0;
+
+	if (itemsPerIteration > 0 && result.medianNS > 0.0)
+		result.itemsPerSec = static_cast<double>(itemsPerIteration) * 1'000'000'000.0 / result.medianNS;
+	return result;
+}
+
+std::string_view BGE::Bench::GetBuildConfigName(void)
+{
+#if defined(BGE_CONFIG_DEBUG)
+	return "Debug";
+#elif defined(BGE_CONFIG_PROFILE)
+	return "Profile";
+#elif defined(BGE_CONFIG_RELEASE)
+	return "Release";
+#else
+	return "Unknown";
+#endif
+}
@@ -0,0 +1,169 @@
+/*=============================================================================*
+ * Benchmark.hpp - Benchmark registration and measurement harness.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#ifndef _BGE_BENCHMARK_HPP_
+#define _BGE_BENCHMARK_HPP_
+
+#include <Engine/EngineStd.hpp>
+
+#include <atomic>
+
+//! Benchmark harness namespace.
+namespace BGE::Bench
+{
+	class State;
+	// Signature of a registered benchmark body.
+	using BenchmarkFunc = std::add_pointer_t<void(State &)>;
+	/**
+	 * Benchmark registration entry. Names take the form "Suite/Name" so results stay
+	 * stable across commits and can be compared against a baseline file.
+	 */
+	struct BenchmarkEntry
+	{
+		std::string suiteName;
+		std::string benchName;
+		BenchmarkFunc pFunc = nullptr;
+
+		std::string GetFullName(void) const { return suiteName + '/' + benchName; }
+	};
+	/**
+	 * Summary statistics for a benchmark, in nanoseconds per operation.
+	 */
+	struct BenchmarkResult
+	{
+		std::string name;
+		std::uint64_t iterations = 0; // Iterations per repetition
+		std::size_t repetitions = 0;
+		double minNS = 0.0, maxNS = 0.0;
+		double meanNS = 0.0, medianNS = 0.0;
+		double stdDevNS = 0.0;
+		double p90NS = 0.0;
+		double itemsPerSec = 0.0; // Zero when the benchmark doesn't report items
+	};
+	/**
+	 * Options controlling calibration & repetition of each benchmark.
+	 */
+	struct RunOptions
+	{
+		std::size_t numWarmups = 2; // Discarded repetitions
+		std::size_t numRepetitions = 10; // Measured repetitions
+		double minRepTimeMS = 20.0; // Calibration target for a single repetition
+		std::string filter; // Substring filter on full names (empty runs everything)
+	};
+	/**
+	 * State is handed to each benchmark body. The timed region is the range-for loop:
+	 *
+	 *     for (auto _ : state) { ... }
+	 *
+	 * Setup written before the loop isn't measured.
+	 */
+	class State
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		class Iterator
+		{
+			State *m_pState;
+			std::uint64_t m_remaining;
+		public:
+			Iterator(State *pState, std::uint64_t remaining) : m_pState(pState), m_remaining(remaining) { }
+			bool operator!=(const Iterator &) const
+			{
+				if (m_remaining != 0)
+					return true;
+				m_pState->StopTimer();
+				return false;
+			}
+			void operator++(void) { --m_remaining; }
+			int operator*(void) const { return 0; }
+		};
+	private:
+		std::uint64_t m_iterations;
+		std::uint64_t m_itemsPerIteration;
+		Clock::time_point m_start;
+		Clock::duration m_elapsed;
+		bool m_isRunning;
+	public:
+		explicit State(std::uint64_t iterations);
+
+		Iterator begin(void) { StartTimer(); return Iterator(this, m_iterations); }
+		Iterator end(void) { return Iterator(this, 0); }
+		// Pause & resume timing around per-iteration work that shouldn't be measured.
+		void PauseTiming(void) { StopTimer(); }
+		void ResumeTiming(void) { StartTimer(); }
+		// Report the number of items handled per iteration (for throughput figures).
+		void SetItemsPerIteration(std::uint64_t numItems) noexcept { m_itemsPerIteration = numItems; }
+		std::uint64_t GetIterations(void) const noexcept { return m_iterations; }
+		std::uint64_t GetItemsPerIteration(void) const noexcept { return m_itemsPerIteration; }
+		double GetElapsedNS(void) const;
+	private:
+		void StartTimer(void);
+		void StopTimer(void);
+	};
+	// Prevent the optimizer from discarding a computed value.
+	template <typename Type>
+	inline void DoNotOptimize(const Type &value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void *s_pSink = nullptr;
+		s_pSink = &value;
+#endif
+	}
+	// Force pending memory writes to be treated as observable.
+	inline void ClobberMemory(void)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : : "memory");
+#else
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+	}
+
+	bool RegisterBenchmark(std::string_view suiteName, std::string_view benchName, BenchmarkFunc pFunc);
+	const std::vector<BenchmarkEntry> &GetBenchmarks(void);
+	// Calibrate, warm up and time each registered benchmark matching the filter.
+	std::vector<BenchmarkResult> RunBenchmarks(const RunOptions &options);
+	// Output helpers:
+	void PrintResults(std::FILE *pFile, std::span<const BenchmarkResult> results);
+	bool WriteResultsJSON(std::string_view filename, std::span<const BenchmarkResult> results,
+						  std::string_view label);
+	// Compare against a JSON file written by a previous run; returns the number of regressions.
+	int CompareWithBaseline(std::FILE *pFile, std::string_view baselineFilename,
+							std::span<const BenchmarkResult> results, double thresholdPercent);
+} // End namespace (BGE::Bench)
+
+// Define and register a benchmark body: BGE_BENCHMARK(Math, Vec3Dot) { for (auto _ : state) { ... } }
+#define BGE_BENCHMARK(SUITE, NAME) \
+static void BGEBench_ ## SUITE ## _ ## NAME(BGE::Bench::State &state); \
+static const bool s_kBGEBench_ ## SUITE ## _ ## NAME ## _Registered = \
+	BGE::Bench::RegisterBenchmark(#SUITE, #NAME, BGEBench_ ## SUITE ## _ ## NAME); \
+static void BGEBench_ ## SUITE ## _ ## NAME(BGE::Bench::State &state)
+
+#endif /* !_BGE_BENCHMARK_HPP_ */
@@ -0,0 +1,107 @@
+/*=============================================================================*
+ * LoggerBench.cpp - Logging throughput benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+
+#if BGE_PLATFORM_WIN
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace BGE;
+
+namespace
+{
+	/**
+	 * Redirects stdout to the null device for its lifetime, so the benchmark measures the
+	 * logger rather than the terminal it happens to be attached to.
+	 */
+	class ScopedStdoutSilencer
+	{
+		int m_savedDesc;
+	public:
+		ScopedStdoutSilencer(void)
+			: m_savedDesc(-1)
+		{
+			std::fflush(stdout);
+#if BGE_PLATFORM_WIN
+			m_savedDesc = _dup(_fileno(stdout));
+			std::FILE *pNull = std::fopen("NUL", "w");
+			if (pNull) { _dup2(_fileno(pNull), _fileno(stdout)); std::fclose(pNull); }
+#else
+			m_savedDesc = dup(fileno(stdout));
+			const int kNullDesc = open("/dev/null", O_WRONLY);
+			if (kNullDesc >= 0) { dup2(kNullDesc, fileno(stdout)); close(kNullDesc); }
+#endif
+		}
+		~ScopedStdoutSilencer(void)
+		{
+			std::fflush(stdout);
+			if (m_savedDesc < 0)
+				return;
+#if BGE_PLATFORM_WIN
+			_dup2(m_savedDesc, _fileno(stdout));
+			_close(m_savedDesc);
+#else
+			dup2(m_savedDesc, fileno(stdout));
+			close(m_savedDesc);
+#endif
+		}
+	};
+} // End anonymous namespace
+
+BGE_BENCHMARK(Logger, WriteFormatted)
+{
+	ScopedStdoutSilencer silencer;
+	int counter = 0;
+	for (auto _ : state)
+	{
+		Logger::Write("INFO", "Actor %d moved to (%.2f, %.2f)", counter, 1.5f * counter, -0.5f * counter);
+		++counter;
+	}
+}
+
+BGE_BENCHMARK(Logger, WritePlain)
+{
+	ScopedStdoutSilencer silencer;
+	for (auto _ : state)
+	{
+		Logger::Write("INFO", "Main loop tick.");
+	}
+}
+
+BGE_BENCHMARK(Logger, SystemTimeString)
+{
+	// Logger::Write formats a timestamp for every message
+	for (auto _ : state)
+	{
+		Bench::DoNotOptimize(Utils::GetSystemTimeString());
+	}
+}
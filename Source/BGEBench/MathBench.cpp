@@ -0,0 +1,274 @@
+/*=============================================================================*
+ * MathBench.cpp - Math vector micro benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+#include "Utilities/MathBatch.hpp"
+
+using namespace BGE;
+
+namespace
+{
+	constexpr std::size_t kNUM_VECTORS = 1024;
+	// Deterministic input so results are comparable between runs.
+	std::vector<Math::Vec3f> MakeVec3Array(std::size_t count, float seed)
+	{
+		std::vector<Math::Vec3f> vectors;
+		vectors.reserve(count);
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			const float kValue = static_cast<float>(index) * 0.25f + seed;
+			vectors.emplace_back(kValue, kValue * 0.5f + 1.0f, 2.0f - kValue * 0.125f);
+		}
+		return vectors;
+	}
+	std::vector<Math::Quatf> MakeQuatArray(std::size_t count, float seed)
+	{
+		std::vector<Math::Quatf> quats;
+		quats.reserve(count);
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			const float kAngle = static_cast<float>(index) * 0.001f + seed;
+			const auto kAxis = Math::Vec3f(std::cos(kAngle * 3.0f), 1.0f, std::sin(kAngle * 5.0f)).Normalized();
+			const float kSin = std::sin(kAngle);
+			quats.emplace_back(kAxis.x * kSin, kAxis.y * kSin, kAxis.z * kSin, std::cos(kAngle));
+		}
+		return quats;
+	}
+	Math::Mat4x4f MakeTransform(void)
+	{
+		return Math::Mat4x4f::FromTRS(Math::Vec3f(1.0f, 2.0f, 3.0f), Math::Quatf(0.0f, 0.38268343f, 0.0f, 0.92387953f),
+									  Math::Vec3f(2.0f));
+	}
+} // End anonymous namespace
+
+BGE_BENCHMARK(Math, Vec3Add)
+{
+	const auto kLhs = MakeVec3Array(kNUM_VECTORS, 1.0f);
+	const auto kRhs = MakeVec3Array(kNUM_VECTORS, 3.0f);
+	auto outputs = kLhs;
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+			outputs[index] = kLhs[index] + kRhs[index];
+		Bench::DoNotOptimize(outputs.data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, Vec3Dot)
+{
+	const auto kLhs = MakeVec3Array(kNUM_VECTORS, 1.0f);
+	const auto kRhs = MakeVec3Array(kNUM_VECTORS, 3.0f);
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		float sum = 0.0f;
+		for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+			sum += kLhs[index].Dot(kRhs[index]);
+		Bench::DoNotOptimize(sum);
+	}
+}
+
+BGE_BENCHMARK(Math, Vec3Cross)
+{
+	const auto kLhs = MakeVec3Array(kNUM_VECTORS, 1.0f);
+	const auto kRhs = MakeVec3Array(kNUM_VECTORS, 3.0f);
+	auto outputs = kLhs;
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+			outputs[index] = kLhs[index].Cross(kRhs[index]);
+		Bench::DoNotOptimize(outputs.data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, Vec3Normalize)
+{
+	const auto kInputs = MakeVec3Array(kNUM_VECTORS, 1.0f);
+	auto outputs = kInputs;
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+			outputs[index] = kInputs[index].Normalized();
+		Bench::DoNotOptimize(outputs.data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, QuatMultiply)
+{
+	std::vector<Math::Quatf> quats;
+	quats.reserve(kNUM_VECTORS);
+	for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+	{
+		const float kAngle = static_cast<float>(index) * 0.001f;
+		quats.emplace_back(0.0f, std::sin(kAngle), 0.0f, std::cos(kAngle));
+	}
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		Math::Quatf accum;
+		for (const auto &quat : quats)
+			accum = accum * quat;
+		Bench::DoNotOptimize(accum);
+	}
+}
+
+BGE_BENCHMARK(Math, Vec3TransformPoint)
+{
+	const auto kMatrix = MakeTransform();
+	const auto kInputs = MakeVec3Array(kNUM_VECTORS, 1.0f);
+	auto outputs = kInputs;
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+			outputs[index] = kMatrix.TransformPoint(kInputs[index]);
+		Bench::DoNotOptimize(outputs.data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, QuatSlerp)
+{
+	const auto kStarts = MakeQuatArray(kNUM_VECTORS, 0.0f);
+	const auto kEnds = MakeQuatArray(kNUM_VECTORS, 1.0f);
+	auto outputs = kStarts;
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+			outputs[index] = Math::Quatf::Slerp(kStarts[index], kEnds[index], 0.3f);
+		Bench::DoNotOptimize(outputs.data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, QuatMultiplyEach)
+{
+	const auto kLhs = MakeQuatArray(kNUM_VECTORS, 0.0f);
+	const auto kRhs = MakeQuatArray(kNUM_VECTORS, 1.0f);
+	auto outputs = kLhs;
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < kNUM_VECTORS; ++index)
+			outputs[index] = kLhs[index] * kRhs[index];
+		Bench::DoNotOptimize(outputs.data());
+		Bench::ClobberMemory();
+	}
+}
+
+// Structure-of-arrays kernels at the best SIMD level the CPU supports:
+
+BGE_BENCHMARK(Math, BatchTransformPoints)
+{
+	const auto kMatrix = MakeTransform();
+	const Math::Vec3Array kInputs(MakeVec3Array(kNUM_VECTORS, 1.0f));
+	Math::Vec3Array outputs(kNUM_VECTORS);
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		Math::BatchTransformPoints(kMatrix, kInputs, outputs);
+		Bench::DoNotOptimize(outputs.GetX().data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, BatchDot)
+{
+	const Math::Vec3Array kLhs(MakeVec3Array(kNUM_VECTORS, 1.0f));
+	const Math::Vec3Array kRhs(MakeVec3Array(kNUM_VECTORS, 3.0f));
+	std::vector<float> outputs(kNUM_VECTORS);
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		Math::BatchDot(kLhs, kRhs, outputs);
+		Bench::DoNotOptimize(outputs.data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, BatchCross)
+{
+	const Math::Vec3Array kLhs(MakeVec3Array(kNUM_VECTORS, 1.0f));
+	const Math::Vec3Array kRhs(MakeVec3Array(kNUM_VECTORS, 3.0f));
+	Math::Vec3Array outputs(kNUM_VECTORS);
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		Math::BatchCross(kLhs, kRhs, outputs);
+		Bench::DoNotOptimize(outputs.GetX().data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, BatchNormalize)
+{
+	const Math::Vec3Array kInputs(MakeVec3Array(kNUM_VECTORS, 1.0f));
+	Math::Vec3Array outputs(kNUM_VECTORS);
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		Math::BatchNormalize(kInputs, outputs);
+		Bench::DoNotOptimize(outputs.GetX().data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, BatchQuatMultiply)
+{
+	const Math::QuatArray kLhs(MakeQuatArray(kNUM_VECTORS, 0.0f));
+	const Math::QuatArray kRhs(MakeQuatArray(kNUM_VECTORS, 1.0f));
+	Math::QuatArray outputs(kNUM_VECTORS);
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		Math::BatchQuatMultiply(kLhs, kRhs, outputs);
+		Bench::DoNotOptimize(outputs.GetX().data());
+		Bench::ClobberMemory();
+	}
+}
+
+BGE_BENCHMARK(Math, BatchQuatSlerp)
+{
+	const Math::QuatArray kStarts(MakeQuatArray(kNUM_VECTORS, 0.0f));
+	const Math::QuatArray kEnds(MakeQuatArray(kNUM_VECTORS, 1.0f));
+	Math::QuatArray outputs(kNUM_VECTORS);
+	state.SetItemsPerIteration(kNUM_VECTORS);
+	for (auto _ : state)
+	{
+		Math::BatchQuatSlerp(kStarts, kEnds, 0.3f, outputs);
+		Bench::DoNotOptimize(outputs.GetX().data());
+		Bench::ClobberMemory();
+	}
+}
@@ -0,0 +1,154 @@
+/*=============================================================================*
+ * MatrixBench.cpp - Matrix benchmarks, compared against glm when available.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+
+#if __has_include(<glm/glm.hpp>)
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#define BGE_BENCH_GLM 1
+#else
+#define BGE_BENCH_GLM 0
+#endif
+
+using namespace BGE;
+
+namespace
+{
+	constexpr std::size_t kNUM_MATRICES = 1024;
+	// Deterministic affine transforms so results are comparable between runs.
+	std::vector<Math::Mat4x4f> MakeMatrices(float seed)
+	{
+		std::vector<Math::Mat4x4f> matrices;
+		matrices.reserve(kNUM_MATRICES);
+		for (std::size_t index = 0; index < kNUM_MATRICES; ++index)
+		{
+			const float kAngle = static_cast<float>(index) * 0.01f + seed;
+			const Math::Quatf kRotation(0.0f, std::sin(kAngle), 0.0f, std::cos(kAngle));
+			matrices.push_back(Math::Mat4x4f::FromTRS(Math::Vec3f(kAngle, 1.0f, -kAngle), kRotation, Math::Vec3f(1.0f + kAngle)));
+		}
+		return matrices;
+	}
+	// Perspective times view, so the general (non-affine) inverse is taken.
+	std::vector<Math::Mat4x4f> MakeProjections(void)
+	{
+		const auto kProjection = Math::Mat4x4f::Perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+		auto matrices = MakeMatrices(0.0f);
+		for (auto &matrix : matrices)
+			matrix = kProjection * matrix;
+		return matrices;
+	}
+#if BGE_BENCH_GLM
+	std::vector<glm::mat4> ToGlm(const std::vector<Math::Mat4x4f> &matrices)
+	{
+		std::vector<glm::mat4> glmMatrices(matrices.size());
+		for (std::size_t index = 0; index < matrices.size(); ++index)
+			std::memcpy(&glmMatrices[index], matrices[index].GetData(), sizeof(glm::mat4));
+		return glmMatrices;
+	}
+#endif
+	// Run FUNC(lhs, rhs) over every pair, storing into OUTPUTS.
+	template <typename Matrix, typename Func>
+	void BenchmarkBinary(Bench::State &state, const std::vector<Matrix> &lhs, const std::vector<Matrix> &rhs, Func func)
+	{
+		auto outputs = lhs;
+		state.SetItemsPerIteration(lhs.size());
+		for (auto _ : state)
+		{
+			for (std::size_t index = 0; index < lhs.size(); ++index)
+				outputs[index] = func(lhs[index], rhs[index]);
+			Bench::DoNotOptimize(outputs.data());
+			Bench::ClobberMemory();
+		}
+	}
+	template <typename Matrix, typename Func>
+	void BenchmarkUnary(Bench::State &state, const std::vector<Matrix> &inputs, Func func)
+	{
+		BenchmarkBinary(state, inputs, inputs, [&](const Matrix &matrix, const Matrix &) { return func(matrix); });
+	}
+} // End anonymous namespace
+
+BGE_BENCHMARK(Matrix, Mat4x4Multiply)
+{
+	BenchmarkBinary(state, MakeMatrices(0.0f), MakeMatrices(1.0f), [](const auto &lhs, const auto &rhs) { return lhs * rhs; });
+}
+
+BGE_BENCHMARK(Matrix, Mat4x4Transpose)
+{
+	BenchmarkUnary(state, MakeMatrices(0.0f), [](const auto &matrix) { return matrix.Transposed(); });
+}
+
+BGE_BENCHMARK(Matrix, Mat4x4Inverse)
+{
+	BenchmarkUnary(state, MakeProjections(), [](const auto &matrix) { return *matrix.Inverse(); });
+}
+
+BGE_BENCHMARK(Matrix, Mat4x4AffineInverse)
+{
+	BenchmarkUnary(state, MakeMatrices(0.0f), [](const auto &matrix) { return *matrix.AffineInverse(); });
+}
+
+BGE_BENCHMARK(Matrix, Mat4x4LookAt)
+{
+	const auto kMatrices = MakeMatrices(0.0f);
+	BenchmarkUnary(state, kMatrices, [](const auto &matrix)
+	{
+		return Math::Mat4x4f::LookAt(matrix.GetTranslation(), Math::Vec3f(0.0f), Math::Vec3f(0.0f, 1.0f, 0.0f));
+	});
+}
+
+#if BGE_BENCH_GLM
+BGE_BENCHMARK(Matrix, GlmMat4Multiply)
+{
+	BenchmarkBinary(state, ToGlm(MakeMatrices(0.0f)), ToGlm(MakeMatrices(1.0f)), [](const auto &lhs, const auto &rhs) { return lhs * rhs; });
+}
+
+BGE_BENCHMARK(Matrix, GlmMat4Transpose)
+{
+	BenchmarkUnary(state, ToGlm(MakeMatrices(0.0f)), [](const auto &matrix) { return glm::transpose(matrix); });
+}
+
+BGE_BENCHMARK(Matrix, GlmMat4Inverse)
+{
+	BenchmarkUnary(state, ToGlm(MakeProjections()), [](const auto &matrix) { return glm::inverse(matrix); });
+}
+
+BGE_BENCHMARK(Matrix, GlmMat4AffineInverse)
+{
+	BenchmarkUnary(state, ToGlm(MakeMatrices(0.0f)), [](const auto &matrix) { return glm::affineInverse(matrix); });
+}
+
+BGE_BENCHMARK(Matrix, GlmMat4LookAt)
+{
+	BenchmarkUnary(state, ToGlm(MakeMatrices(0.0f)), [](const auto &matrix)
+	{
+		return glm::lookAt(glm::vec3(matrix[3]), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	});
+}
+#endif
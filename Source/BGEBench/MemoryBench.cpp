@@ -0,0 +1,83 @@
+/*=============================================================================*
+ * MemoryBench.cpp - Memory pool micro benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+#include "Memory/MemoryPool.hpp"
+
+using namespace BGE;
+
+namespace
+{
+	constexpr std::size_t kCHUNK_SIZE = 64;
+	constexpr std::size_t kNUM_CHUNKS = 4096;
+} // End anonymous namespace
+
+BGE_BENCHMARK(Memory, PoolAllocFree)
+{
+	MemoryPool pool;
+	pool.Init(kCHUNK_SIZE, kNUM_CHUNKS);
+	std::vector<void *> allocations(kNUM_CHUNKS, nullptr);
+	state.SetItemsPerIteration(kNUM_CHUNKS);
+	for (auto _ : state)
+	{
+		for (auto &pMem : allocations)
+			pMem = pool.Alloc();
+		for (auto *pMem : allocations)
+			pool.Free(pMem);
+		Bench::DoNotOptimize(allocations.data());
+	}
+}
+
+BGE_BENCHMARK(Memory, MallocFree)
+{
+	// Reference point for PoolAllocFree.
+	std::vector<void *> allocations(kNUM_CHUNKS, nullptr);
+	state.SetItemsPerIteration(kNUM_CHUNKS);
+	for (auto _ : state)
+	{
+		for (auto &pMem : allocations)
+			pMem = std::malloc(kCHUNK_SIZE);
+		for (auto *pMem : allocations)
+			std::free(pMem);
+		Bench::DoNotOptimize(allocations.data());
+	}
+}
+
+BGE_BENCHMARK(Memory, PoolGrow)
+{
+	// Allocating past the first block forces GrowMemoryArray.
+	state.SetItemsPerIteration(kNUM_CHUNKS * 4);
+	for (auto _ : state)
+	{
+		MemoryPool pool;
+		pool.SetAllowResize(true);
+		pool.Init(kCHUNK_SIZE, kNUM_CHUNKS);
+		for (std::size_t index = 0; index < kNUM_CHUNKS * 4; ++index)
+			Bench::DoNotOptimize(pool.Alloc());
+	}
+}
@@ -0,0 +1,173 @@
+/*=============================================================================*
+ * SpatialBench.cpp - Spatial index benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+#include "Physics/LooseOctree.hpp"
+#include "Physics/SpatialHashGrid.hpp"
+
+#include <random>
+
+using namespace BGE;
+
+namespace
+{
+	// Tanks and projectiles spread over a 2 km square battlefield
+	constexpr std::size_t kNUM_ENTRIES = 10'000;
+	constexpr std::size_t kNUM_QUERIES = 256;
+	constexpr float kWORLD_SIZE = 2048.0f;
+	constexpr float kQUERY_RADIUS = 32.0f;
+	constexpr std::uint32_t kOCTREE_DEPTH = 6; // Smallest cells as wide as the query radius
+
+	std::vector<Math::Vec3f> MakePositions(std::size_t count, std::uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> coord(0.0f, kWORLD_SIZE);
+		std::vector<Math::Vec3f> positions;
+		positions.reserve(count);
+		for (std::size_t index = 0; index < count; ++index)
+			positions.emplace_back(coord(rng), coord(rng) * 0.05f, coord(rng));
+		return positions;
+	}
+	void FillOctree(LooseOctree &octree, std::span<const Math::Vec3f> positions, std::vector<SpatialHandle> &handles)
+	{
+		for (std::size_t index = 0; index < positions.size(); ++index)
+			handles.push_back(octree.Insert(static_cast<ActorID>(index + 1), positions[index], 2.0f));
+	}
+} // End anonymous namespace
+
+BGE_BENCHMARK(Spatial, LinearRange10k)
+{
+	// Baseline: what a proximity check costs without an index
+	const auto kPositions = MakePositions(kNUM_ENTRIES, 1);
+	const auto kQueries = MakePositions(kNUM_QUERIES, 2);
+	std::vector<ActorID> found;
+	state.SetItemsPerIteration(kNUM_QUERIES);
+	for (auto _ : state)
+	{
+		found.clear();
+		for (const auto &kQuery : kQueries)
+		{
+			for (std::size_t index = 0; index < kPositions.size(); ++index)
+			{
+				const Math::Vec3f kOffset = kPositions[index] - kQuery;
+				if (kOffset.Dot(kOffset) <= (kQUERY_RADIUS + 2.0f) * (kQUERY_RADIUS + 2.0f))
+					found.push_back(static_cast<ActorID>(index + 1));
+			}
+		}
+		Bench::DoNotOptimize(found.data());
+	}
+}
+
+BGE_BENCHMARK(Spatial, OctreeRange10k)
+{
+	LooseOctree octree(Math::Vec3f(0.0f), kWORLD_SIZE, kOCTREE_DEPTH);
+	std::vector<SpatialHandle> handles;
+	FillOctree(octree, MakePositions(kNUM_ENTRIES, 1), handles);
+	const auto kQueries = MakePositions(kNUM_QUERIES, 2);
+	SpatialBatchResult result;
+	state.SetItemsPerIteration(kNUM_QUERIES);
+	for (auto _ : state)
+	{
+		octree.QuerySpheres(kQueries, kQUERY_RADIUS, result);
+		Bench::DoNotOptimize(result.actorIDs.data());
+	}
+}
+
+BGE_BENCHMARK(Spatial, GridRange10k)
+{
+	SpatialHashGrid grid(kQUERY_RADIUS);
+	const auto kPositions = MakePositions(kNUM_ENTRIES, 1);
+	for (std::size_t index = 0; index < kPositions.size(); ++index)
+		grid.Insert(static_cast<ActorID>(index + 1), Math::Vec2f(kPositions[index].x, kPositions[index].z), 2.0f);
+	std::vector<Math::Vec2f> queries;
+	for (const auto &kQuery : MakePositions(kNUM_QUERIES, 2))
+		queries.emplace_back(kQuery.x, kQuery.z);
+	SpatialBatchResult result;
+	state.SetItemsPerIteration(kNUM_QUERIES);
+	for (auto _ : state)
+	{
+		grid.QueryCircles(queries, kQUERY_RADIUS, result);
+		Bench::DoNotOptimize(result.actorIDs.data());
+	}
+}
+
+BGE_BENCHMARK(Spatial, OctreeNearest10k)
+{
+	LooseOctree octree(Math::Vec3f(0.0f), kWORLD_SIZE, kOCTREE_DEPTH);
+	std::vector<SpatialHandle> handles;
+	FillOctree(octree, MakePositions(kNUM_ENTRIES, 1), handles);
+	const auto kQueries = MakePositions(kNUM_QUERIES, 2);
+	std::vector<SpatialHit> hits;
+	state.SetItemsPerIteration(kNUM_QUERIES);
+	for (auto _ : state)
+	{
+		for (const auto &kQuery : kQueries)
+			octree.QueryNearest(kQuery, 8, hits);
+		Bench::DoNotOptimize(hits.data());
+	}
+}
+
+BGE_BENCHMARK(Spatial, OctreeRaycast10k)
+{
+	LooseOctree octree(Math::Vec3f(0.0f), kWORLD_SIZE, kOCTREE_DEPTH);
+	std::vector<SpatialHandle> handles;
+	FillOctree(octree, MakePositions(kNUM_ENTRIES, 1), handles);
+	std::vector<SpatialRay3D> rays;
+	for (const auto &kOrigin : MakePositions(kNUM_QUERIES, 2))
+		rays.push_back(SpatialRay3D{ kOrigin, Math::Vec3f(0.6f, 0.0f, 0.8f), 512.0f });
+	std::vector<SpatialHit> hits(rays.size());
+	state.SetItemsPerIteration(kNUM_QUERIES);
+	for (auto _ : state)
+	{
+		octree.Raycasts(rays, hits);
+		Bench::DoNotOptimize(hits.data());
+	}
+}
+
+BGE_BENCHMARK(Spatial, OctreeMoveAll10k)
+{
+	// Every entry moves a small step per frame, as units and projectiles do
+	LooseOctree octree(Math::Vec3f(0.0f), kWORLD_SIZE, kOCTREE_DEPTH);
+	std::vector<SpatialHandle> handles;
+	auto positions = MakePositions(kNUM_ENTRIES, 1);
+	FillOctree(octree, positions, handles);
+	const Math::Vec3f kStep(0.5f, 0.0f, 0.25f);
+	state.SetItemsPerIteration(kNUM_ENTRIES);
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < handles.size(); ++index)
+		{
+			positions[index] += kStep;
+			if (positions[index].x >= kWORLD_SIZE)
+				positions[index].x -= kWORLD_SIZE;
+			if (positions[index].z >= kWORLD_SIZE)
+				positions[index].z -= kWORLD_SIZE;
+			octree.Move(handles[index], positions[index]);
+		}
+	}
+}
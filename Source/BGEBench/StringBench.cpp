@@ -0,0 +1,60 @@
+/*=============================================================================*
+ * StringBench.cpp - String utility benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+
+using namespace BGE;
+
+BGE_BENCHMARK(String, StringToWString)
+{
+	const std::string kInput = "Tank Battles: the quick brown fox jumps over the lazy dog";
+	state.SetItemsPerIteration(kInput.size());
+	for (auto _ : state)
+	{
+		Bench::DoNotOptimize(StringToWString(kInput));
+	}
+}
+
+BGE_BENCHMARK(String, WStringToString)
+{
+	const std::wstring kInput = L"Tank Battles: the quick brown fox jumps over the lazy dog";
+	state.SetItemsPerIteration(kInput.size());
+	for (auto _ : state)
+	{
+		Bench::DoNotOptimize(WStringToString(kInput));
+	}
+}
+
+BGE_BENCHMARK(String, TrimString)
+{
+	const std::string kInput = "\t\t   padded configuration value   \t";
+	for (auto _ : state)
+	{
+		Bench::DoNotOptimize(TrimString(kInput));
+	}
+}
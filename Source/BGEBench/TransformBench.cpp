@@ -0,0 +1,84 @@
+/*=============================================================================*
+ * TransformBench.cpp - Transform hierarchy benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+#include "Actors/TransformHierarchy.hpp"
+
+using namespace BGE;
+
+namespace
+{
+	constexpr std::size_t kNUM_NODES = 10'000;
+	constexpr std::size_t kFANOUT = 4;
+
+	// Complete tree with KFANOUT children per node, built breadth first.
+	std::vector<TransformHandle> MakeTree(TransformHierarchy &hierarchy)
+	{
+		std::vector<TransformHandle> handles;
+		handles.reserve(kNUM_NODES);
+		const auto kLocal = Math::Mat4x4f::Translation(Math::Vec3f(1.0f, 0.0f, 0.0f));
+		handles.push_back(hierarchy.Add(kLocal));
+		for (std::size_t index = 1; index < kNUM_NODES; ++index)
+			handles.push_back(hierarchy.Add(kLocal, handles[(index - 1) / kFANOUT]));
+		hierarchy.Update();
+		return handles;
+	}
+	// Move every STRIDE-th node and update.
+	void BenchmarkDirtyUpdate(Bench::State &state, std::size_t stride)
+	{
+		TransformHierarchy hierarchy;
+		const auto kHandles = MakeTree(hierarchy);
+		const auto kLocal = Math::Mat4x4f::Translation(Math::Vec3f(0.0f, 1.0f, 0.0f));
+		state.SetItemsPerIteration(kNUM_NODES / stride);
+		for (auto _ : state)
+		{
+			for (std::size_t index = kNUM_NODES - 1; index >= stride; index -= stride)
+				hierarchy.SetLocal(kHandles[index], kLocal);
+			Bench::DoNotOptimize(hierarchy.Update());
+		}
+	}
+} // End anonymous namespace
+
+BGE_BENCHMARK(Transform, UpdateAllDirty10k)
+{
+	TransformHierarchy hierarchy;
+	const auto kHandles = MakeTree(hierarchy);
+	const auto kLocal = Math::Mat4x4f::Translation(Math::Vec3f(0.0f, 1.0f, 0.0f));
+	state.SetItemsPerIteration(kNUM_NODES);
+	for (auto _ : state)
+	{
+		// The root moves, so every world matrix is recomputed
+		hierarchy.SetLocal(kHandles.front(), kLocal);
+		Bench::DoNotOptimize(hierarchy.Update());
+	}
+}
+
+BGE_BENCHMARK(Transform, UpdateOnePercentDirty10k)
+{
+	BenchmarkDirtyUpdate(state, 100);
+}
@@ -0,0 +1,109 @@
+/*=============================================================================*
+ * XmlBench.cpp - XML configuration parsing benchmarks.
+ *
+ * Copyright (c) 2023, Brian Hoffpauir All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *============================================================================*/
+#include <Engine/EngineStd.hpp>
+#include "Benchmark.hpp"
+
+using namespace BGE;
+
+namespace
+{
+	// Mirror of Game/Engine.xml, embedded so the benchmark doesn't depend on the working directory.
+	constexpr const char *kENGINE_CONFIG_XML = R"xml(<?xml version="1.0" encoding="utf-8"?>
+<Engine>
+	<Option name="iconFilename" value=""/>
+	<Option name="glVersion" major="4" minor="5"/>
+	<Option name="glDebugEnabled" value="true"/>
+	<Option name="defWindowTitle" value="BGE2"/>
+	<Option name="defWindowWidth" value="1280"/>
+	<Option name="defWindowHeight" value="720"/>
+	<Option name="windowResizable" value="false"/>
+	<Option name="fullscreenEnabled" value="false"/>
+	<Option name="verticalSyncEnabled" value="true"/>
+	<Option name="MSAA" value="4"/>
+	<Option name="imGuiEnabled" value="true"/>
+	<Option name="toLimitFrames" value="true"/>
+	<Option name="minFrames" value="6"/>
+</Engine>
+)xml";
+	// Localized string table of a representative size.
+	std::string MakeStringTableXML(std::size_t numStrings)
+	{
+		std::string xml = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<Strings>\n";
+		for (std::size_t index = 0; index < numStrings; ++index)
+		{
+			xml += "\t<String sID=\"IDS_STRING_" + std::to_string(index) + "\" value=\"Localized text number "
+				+ std::to_string(index) + "\"/>\n";
+		}
+		xml += "</Strings>\n";
+		return xml;
+	}
+} // End anonymous namespace
+
+BGE_BENCHMARK(Xml, ParseEngineConfig)
+{
+	using namespace tinyxml2;
+	for (auto _ : state)
+	{
+		XMLDocument xmlDocument;
+		if (xmlDocument.Parse(kENGINE_CONFIG_XML) != XML_SUCCESS)
+			continue;
+		// Walk the options the way BGUTParseConfig does
+		int checksum = 0;
+		for (auto *pElem = xmlDocument.RootElement()->FirstChildElement(); pElem; pElem = pElem->NextSiblingElement())
+		{
+			const char *pName = pElem->Attribute("name");
+			checksum += (pName) ? static_cast<int>(std::strlen(pName)) : 0;
+			checksum += pElem->IntAttribute("value");
+		}
+		Bench::DoNotOptimize(checksum);
+	}
+}
+
+BGE_BENCHMARK(Xml, ParseStringTable)
+{
+	using namespace tinyxml2;
+	constexpr std::size_t kNUM_STRINGS = 512;
+	const auto kXML = MakeStringTableXML(kNUM_STRINGS);
+	state.SetItemsPerIteration(kNUM_STRINGS);
+	for (auto _ : state)
+	{
+		XMLDocument xmlDocument;
+		if (xmlDocument.Parse(kXML.c_str(), kXML.size()) != XML_SUCCESS)
+			continue;
+		// Same conversions as EngineApp::LoadStrings
+		TextStringMap textStrings;
+		for (auto *pElem = xmlDocument.RootElement()->FirstChildElement(); pElem; pElem = pElem->NextSiblingElement())
+		{
+			const char *pKey = pElem->Attribute("sID");
+			const char *pText = pElem->Attribute("value");
+			if (pKey && pText)
+				textStrings[StringToWString(pKey)] = StringToWString(pText);
+		}
+		Bench::DoNotOptimize(textStrings.size());
+	}
+}